@@ -9,6 +9,8 @@ import glob
 import os
 import statistics
 
+from exp_common import load_corpus
+
 # 테스트 시나리오별 링크 용량 정의
 SCENARIO_CONFIGS = {
     '20_flows': {
@@ -30,9 +32,59 @@ SCENARIO_CONFIGS = {
         'description': '지연 변동 (jitter)',
         'link_capacity_gbps': 1.0,
         'num_flows': 5
+    },
+    'trace_link': {
+        'description': '트레이스 기반 가변 용량 링크',
+        'link_capacity_gbps': 0.05,   # 트레이스 평균 (exp_trace_link.TRACE_MBPS)
+        'num_flows': 5
+    },
+    'dumbbell': {
+        'description': '덤벨 + 역방향 트래픽',
+        'link_capacity_gbps': 0.1,
+        'num_flows': 5
+    },
+    'parking_lot': {
+        'description': '파킹랏 (3 홉)',
+        'link_capacity_gbps': 0.1,    # 홉당 용량, 교차 트래픽과 공유
+        'num_flows': 5
+    },
+    'policer': {
+        'description': '토큰 버킷 폴리서',
+        'link_capacity_gbps': 0.05,   # 정책 속도
+        'num_flows': 5
+    },
+    'shaper': {
+        'description': 'tbf 셰이퍼',
+        'link_capacity_gbps': 0.05,
+        'num_flows': 5
+    },
+    'cross_traffic': {
+        'description': '배경 트래픽과 경쟁',
+        'link_capacity_gbps': 0.1,    # 교차 트래픽 포함 병목 용량
+        'num_flows': 5
+    },
+    'app_limited': {
+        'description': '앱 제한 / 청크 스트리밍',
+        'link_capacity_gbps': 0.1,    # 흐름 대부분이 앱 속도로 제한됨
+        'num_flows': 5
+    },
+    'incast': {
+        'description': 'incast (최대 fan-in 단계)',
+        'link_capacity_gbps': 1.0,    # 집계 포트, 질의 속도로 제한됨
+        'num_flows': 1
     }
 }
 
+# search_scenarios.py 코퍼스 시나리오 (run_all_tests.py --corpus 로 실행한 것만)
+for _c in load_corpus():
+    if glob.glob(f"/tmp/results_{_c['name']}_*"):
+        SCENARIO_CONFIGS[_c['name']] = {
+            'description': _c.get('description', _c['name']),
+            'link_capacity_gbps': _c['params']['bw_mbps'] / 1000.0,
+            'num_flows': int(_c['params']['flows']),
+            'cross_frac': _c['params'].get('cross_frac', 0),
+        }
+
 CC_ALGOS = ['reno', 'reno_custom']
 
 def extract_metrics_from_json(json_data):
@@ -81,6 +133,17 @@ def jain_fairness(values):
     n = len(values)
     return (s * s) / (n * s2) if s2 > 0 else 0.0
 
+def load_calibration_flags(scenario_name, cc_algo):
+    """실행 전 링크 보정에서 허용 오차를 넘은 항목 목록 (보정 결과 없으면 빈 리스트)"""
+    path = f"/tmp/results_{scenario_name}_{cc_algo}/calibration.json"
+    try:
+        with open(path, 'r') as f:
+            data = json.load(f)
+    except (OSError, ValueError):
+        return []
+    return [f"{p['src']}->{p['dst']}: {flag}"
+            for p in data.get('paths', []) for flag in p.get('flags', [])]
+
 def analyze_scenario(scenario_name, cc_algo):
     """특정 시나리오의 결과 분석"""
     result_dir = f"/tmp/results_{scenario_name}_{cc_algo}"
@@ -187,6 +250,22 @@ def print_comparison_table():
             print(f"{'Total Retransmits':<30} {reno_retx:<24} {custom_retx:<24} {winner:<15}")
         else:
             print("⚠️  No valid results found for this scenario")
+
+        # 추정기 정확도 (처리량 차이의 주 원인이므로 함께 표시)
+        from analyze_estimator import score_dir
+        est = score_dir(f"/tmp/results_{scenario_name}_reno_custom", scenario_name)
+        if est and est['fair']:
+            print(f"{'BWE error vs fair share':<30} {'-':<24} "
+                  f"{est['fair']['bias'] * 100:+.1f}% (MAE {est['fair']['mae'] * 100:.1f}%)")
+        if est and est['rate']:
+            lag = f", lag {est['lag_s']:.1f}s" if est['lag_s'] is not None else ''
+            print(f"{'BWE error vs delivery rate':<30} {'-':<24} "
+                  f"{est['rate']['bias'] * 100:+.1f}% (MAE {est['rate']['mae'] * 100:.1f}%{lag})")
+
+        # 에뮬레이션 충실도 경고
+        for cc_algo in CC_ALGOS:
+            for flag in load_calibration_flags(scenario_name, cc_algo):
+                print(f"⚠️  Emulation fidelity ({cc_algo}) {flag}")
     
     print("\n" + "="*100)
     print("✅ Analysis Complete!")
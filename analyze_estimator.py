@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""
+reno_custom 대역폭 추정기 정확도 분석
+
+실행 중 LiveFeed 가 남긴 estimator_samples.csv (ss 의 BWE/min_rtt/ssthresh + bytes_acked 전달률)를
+에뮬레이션의 기준값과 맞춰 본다.
+  - 공정 몫(fair share) = 병목 용량 / (같은 시각 정방향 흐름 수 + 경쟁 흐름 수)
+  - 기준 BDP           = 공정 몫 × 기본 RTT (calibration.json 의 설정 RTT, 없으면 관측 최소 RTT)
+지표 (오차 = 추정/기준 - 1)
+  - BWE vs 공정 몫:   편향(평균 오차), MAE, |오차| p90
+  - BWE vs 실제 전달률: 같은 샘플의 bytes_acked 차분 대비 편향, MAE
+  - 지연(lag):        전달률 변화가 BWE 에 나타나기까지 (흐름별 상호상관 최대 시차의 중앙값)
+  - BDP:             bwe × min_rtt vs 기준 BDP
+  - ssthresh:        ssthresh × mss vs 기준 BDP (손실 후 reno_custom_ssthresh 결과)
+
+결과 디렉터리 /tmp/results_{시나리오}_reno_custom[-변형] 을 추정기 변형별로 비교
+(변형은 run_all_tests.py --bwe-variants 로 생성, 접미사 없으면 기본 ack)
+
+  python3 analyze_estimator.py [시나리오 ...]
+"""
+
+import csv
+import glob
+import json
+import statistics
+import sys
+
+from analyze_all_results import SCENARIO_CONFIGS
+
+WARMUP = 2.0              # 연결 설정/slow start 구간 제외 (초)
+MAX_LAG = 5.0             # 상호상관 탐색 범위 (초)
+RESULT_FILE = '/tmp/estimator_accuracy.json'
+
+# 공정 몫이 상수로 정의되지 않는 시나리오 (가변 용량, 교차 트래픽 잔여 용량, 앱 제한, 질의 기반)
+# 에서는 기준값 지표를 건너뛰고 전달률 대비 지표만 계산
+NO_GROUND_TRUTH = {'trace_link', 'cross_traffic', 'app_limited', 'incast'}
+# 정방향 흐름 외에 같은 병목을 나눠 쓰는 흐름 수
+EXTRA_COMPETITORS = {'parking_lot': 1}
+
+
+def _is_forward(flow):
+    """iperf3 벌크(5201~) 또는 app_workload 서버(7000) 흐름"""
+    _, _, addrs = flow.partition(' ')
+    local, _, peer = addrs.partition('>')
+    return 5201 <= int(peer.rsplit(':', 1)[1]) < 5300 or local.endswith(':7000')
+
+
+def _num(value):
+    return float(value) if value not in ('', None) else None
+
+
+def load_samples(path):
+    """estimator_samples.csv → {t: [row dict, ...]} (정방향 흐름만)"""
+    by_t = {}
+    try:
+        with open(path) as f:
+            for row in csv.DictReader(f):
+                if not _is_forward(row['flow']):
+                    continue
+                r = {k: _num(v) for k, v in row.items() if k != 'flow'}
+                r['flow'] = row['flow']
+                by_t.setdefault(r['t'], []).append(r)
+    except OSError:
+        pass
+    return by_t
+
+
+def base_rtt_ms(result_dir, by_t):
+    try:
+        with open(f"{result_dir}/calibration.json") as f:
+            return json.load(f)['paths'][0]['expected']['rtt_ms']
+    except (OSError, ValueError, KeyError, IndexError):
+        rtts = [r['rtt_ms'] for rows in by_t.values() for r in rows if r['rtt_ms']]
+        return min(rtts) if rtts else None
+
+
+def _err_stats(errors):
+    if not errors:
+        return None
+    a = sorted(abs(e) for e in errors)
+    return {'bias': statistics.mean(errors), 'mae': statistics.mean(a),
+            'p90': a[int(0.9 * (len(a) - 1))], 'n': len(errors)}
+
+
+def _corr(x, y):
+    if len(x) < 3:
+        return None
+    mx, my = statistics.mean(x), statistics.mean(y)
+    sxy = sum((a - mx) * (b - my) for a, b in zip(x, y))
+    sxx = sum((a - mx) ** 2 for a in x)
+    syy = sum((b - my) ** 2 for b in y)
+    return sxy / (sxx * syy) ** 0.5 if sxx > 0 and syy > 0 else None
+
+
+def flow_lag(series, step):
+    """[(t, 전달률, bwe), ...] 에서 BWE 가 전달률을 따라가는 시차 (초), 변동이 없으면 None"""
+    tput = [s[1] for s in series]
+    bwe = [s[2] for s in series]
+    best, best_k = None, None
+    for k in range(0, int(MAX_LAG / step) + 1):
+        if len(tput) - k < 8:
+            break
+        c = _corr(tput[:len(tput) - k], bwe[k:])
+        if c is not None and (best is None or c > best):
+            best, best_k = c, k
+    return best_k * step if best_k is not None else None
+
+
+def score_dir(result_dir, scenario):
+    by_t = load_samples(f"{result_dir}/estimator_samples.csv")
+    if not by_t:
+        return None
+    config = SCENARIO_CONFIGS.get(scenario, {})
+    # 코퍼스 시나리오는 교차 트래픽이 있으면 잔여 용량이 변하므로 기준값 없음
+    truth = (scenario not in NO_GROUND_TRUTH and 'link_capacity_gbps' in config
+             and not config.get('cross_frac'))
+    capacity = config.get('link_capacity_gbps', 0) * 1e3     # Mbit/s
+    rtt0 = base_rtt_ms(result_dir, by_t)
+
+    fair_err, rate_err, bdp_err, ss_err = [], [], [], []
+    per_flow = {}
+    for t in sorted(by_t):
+        rows = by_t[t]
+        if t < WARMUP:
+            continue
+        fair = capacity / (len(rows) + EXTRA_COMPETITORS.get(scenario, 0)) if truth else None
+        true_bdp = fair * rtt0 / 1e3 if fair and rtt0 else None      # Mbit
+        for r in rows:
+            bwe = r['bwe_mbps']
+            if bwe is None:
+                continue
+            if fair:
+                fair_err.append(bwe / fair - 1)
+            if r['tput_mbps'] and r['tput_mbps'] > 0:
+                rate_err.append(bwe / r['tput_mbps'] - 1)
+            if true_bdp:
+                if r['mrtt_ms']:
+                    bdp_err.append(bwe * r['mrtt_ms'] / 1e3 / true_bdp - 1)
+                if r['ssthresh'] and r['mss'] and r['ssthresh'] < 1e9:
+                    ss_err.append(r['ssthresh'] * r['mss'] * 8 / 1e6 / true_bdp - 1)
+            per_flow.setdefault(r['flow'], []).append((t, r['tput_mbps'] or 0.0, bwe))
+
+    ts = sorted(by_t)
+    step = statistics.median(b - a for a, b in zip(ts, ts[1:])) if len(ts) > 1 else 0.5
+    lags = [lag for lag in (flow_lag(s, step) for s in per_flow.values()) if lag is not None]
+
+    return {
+        'fair': _err_stats(fair_err),
+        'rate': _err_stats(rate_err),
+        'bdp': _err_stats(bdp_err),
+        'ssthresh': _err_stats(ss_err),
+        'lag_s': statistics.median(lags) if lags else None,
+        'base_rtt_ms': rtt0,
+        'flows': len(per_flow),
+    }
+
+
+def variants(scenario):
+    """{변형 이름: 결과 디렉터리}"""
+    out = {}
+    for d in sorted(glob.glob(f"/tmp/results_{scenario}_reno_custom*")):
+        suffix = d[len(f"/tmp/results_{scenario}_reno_custom"):]
+        out[suffix.lstrip('-') or 'ack'] = d
+    return out
+
+
+def _fmt(stats, key='bias'):
+    if not stats:
+        return '-'
+    return f"{stats[key] * 100:+.1f}%" if key == 'bias' else f"{stats[key] * 100:.1f}%"
+
+
+def main():
+    scenarios = sys.argv[1:] or list(SCENARIO_CONFIGS)
+    results = {}
+
+    print("=" * 110)
+    print("📐 reno_custom Estimator Accuracy (error = estimate / truth - 1)")
+    print("=" * 110)
+    print(f"{'Scenario':<16} {'Variant':<8} {'BWE/fair bias':>13} {'MAE':>8} {'p90':>8} "
+          f"{'BWE/rate bias':>13} {'MAE':>8} {'lag(s)':>7} {'BDP bias':>9} {'ssthr bias':>10}")
+    print("-" * 110)
+    for scenario in scenarios:
+        for variant, result_dir in variants(scenario).items():
+            r = score_dir(result_dir, scenario)
+            if r is None:
+                continue
+            results.setdefault(scenario, {})[variant] = r
+            lag = f"{r['lag_s']:.1f}" if r['lag_s'] is not None else '-'
+            print(f"{scenario:<16} {variant:<8} {_fmt(r['fair']):>13} {_fmt(r['fair'], 'mae'):>8} "
+                  f"{_fmt(r['fair'], 'p90'):>8} {_fmt(r['rate']):>13} {_fmt(r['rate'], 'mae'):>8} "
+                  f"{lag:>7} {_fmt(r['bdp']):>9} {_fmt(r['ssthresh']):>10}")
+
+    with open(RESULT_FILE, 'w') as f:
+        json.dump(results, f, indent=1)
+    print(f"\n💾 Saved to {RESULT_FILE}")
+
+
+if __name__ == "__main__":
+    main()
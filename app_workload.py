@@ -0,0 +1,256 @@
+#!/usr/bin/env python3
+"""
+앱 제한(app-limited) / 청크 스트리밍 워크로드 (서버 → 클라이언트 방향 전송)
+iperf3 는 항상 무제한 송신이므로 BWE 가 앱 속도를 재는 상황을 만들 수 없어 별도 도구 사용
+
+  서버:       python3 app_workload.py server <port>
+  속도 제한:  python3 app_workload.py client <server_ip> <port> rate <Mbit/s> <duration> <json_out>
+  청크:       python3 app_workload.py client <server_ip> <port> chunked <chunk_bytes> <period> <duration> <json_out>
+  incast:     python3 app_workload.py incast <ip1,ip2,...> <port> <resp_bytes> <qps> <duration> <json_out>
+
+- rate:    서버가 <Mbit/s> 로 제한해 송신 (0 이면 무제한)
+- chunked: 비디오 세그먼트처럼 <period> 초마다 <chunk_bytes> 요청, 끝나면 다음 주기까지 유휴
+           (다운로드가 주기보다 길면 바로 다음 청크 요청)
+- incast:  partition/aggregate 질의. 모든 서버에 같은 순간 CHUNK <resp_bytes> 를 보내고
+           전부 도착할 때까지를 질의 완료 시간(QCT)으로 기록. 질의는 초당 <qps> 개 간격,
+           이전 질의가 늦게 끝나면 바로 다음 질의 (동시에 하나만)
+- 송신측(서버)이 혼잡 제어를 하므로 서버 호스트의 TCP CC 가 측정 대상
+결과 JSON 은 iperf3 -J 와 같은 키(end.sum_sent.bits_per_second, intervals)에
+청크별 다운로드 시간(chunks)을 추가
+"""
+
+import json
+import selectors
+import socket
+import sys
+import threading
+import time
+
+BLOCK = 64 * 1024
+PACE_BLOCK = 16 * 1024
+
+
+def send_rate(conn, mbps, duration):
+    """mbps 로 제한해 duration 초 동안 송신 (누적 목표 바이트를 따라감)"""
+    buf = b'\0' * (PACE_BLOCK if mbps > 0 else BLOCK)
+    start = time.time()
+    sent = 0
+    while True:
+        now = time.time()
+        if now - start >= duration:
+            break
+        if mbps > 0:
+            ahead = sent * 8 / (mbps * 1e6) - (now - start)
+            if ahead > 0:
+                time.sleep(ahead)
+                continue
+        sent += conn.send(buf)
+
+
+def send_chunk(conn, size):
+    buf = b'\0' * BLOCK
+    left = size
+    while left > 0:
+        left -= conn.send(buf[:min(left, BLOCK)])
+
+
+def serve_one(conn):
+    """첫 줄 명령: 'RATE <mbps> <sec>' 또는 반복되는 'CHUNK <bytes>'"""
+    with conn:
+        f = conn.makefile('rb')
+        while True:
+            line = f.readline().decode().split()
+            if not line:
+                return
+            if line[0] == 'RATE':
+                send_rate(conn, float(line[1]), float(line[2]))
+                return
+            if line[0] == 'CHUNK':
+                send_chunk(conn, int(line[1]))
+
+
+def run_server(port):
+    s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    s.bind(('0.0.0.0', port))
+    s.listen(16)
+    while True:
+        conn, _ = s.accept()
+        threading.Thread(target=serve_one, args=(conn,), daemon=True).start()
+
+
+def recv_exact(s, size):
+    left = size
+    while left > 0:
+        n = len(s.recv(min(left, 1 << 20)))
+        if n == 0:
+            raise ConnectionError('server closed')
+        left -= n
+
+
+class IntervalMeter:
+    """1초 구간 수신량 (iperf3 intervals 형식)"""
+
+    def __init__(self, start):
+        self.start = start
+        self.mark = start
+        self.bytes = 0
+        self.total = 0
+        self.intervals = []
+
+    def add(self, n, now):
+        self.bytes += n
+        self.total += n
+        while now >= self.mark + 1.0:
+            self.intervals.append({'sum': {
+                'start': self.mark - self.start,
+                'end': self.mark + 1.0 - self.start,
+                'bytes': self.bytes,
+                'bits_per_second': self.bytes * 8 / 1.0
+            }})
+            self.bytes = 0
+            self.mark += 1.0
+
+
+def run_rate(s, mbps, duration, meter):
+    s.sendall(f'RATE {mbps} {duration}\n'.encode())
+    while True:
+        data = s.recv(1 << 20)
+        if not data:
+            break
+        meter.add(len(data), time.time())
+
+
+def run_chunked(s, chunk, period, duration, meter):
+    chunks = []
+    start = meter.start
+    next_req = start
+    prev_end = None
+    while next_req - start < duration:
+        now = time.time()
+        if now < next_req:
+            time.sleep(next_req - now)
+        t0 = time.time()
+        s.sendall(f'CHUNK {chunk}\n'.encode())
+        recv_exact(s, chunk)
+        t1 = time.time()
+        meter.add(chunk, t1)
+        chunks.append({'start': t0 - start, 'seconds': t1 - t0, 'bytes': chunk,
+                       'idle_before': t0 - prev_end if prev_end else 0.0})
+        prev_end = t1
+        # 청크 시작 기준 주기 (늦으면 바로 다음 청크)
+        next_req = max(next_req + period, t1)
+    return chunks
+
+
+def run_incast(servers, port, resp, qps, duration, json_out):
+    conns = []
+    for ip in servers:
+        s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        s.connect((ip, port))
+        s.setblocking(False)
+        conns.append(s)
+    sel = selectors.DefaultSelector()
+    for s in conns:
+        sel.register(s, selectors.EVENT_READ)
+    req = f'CHUNK {resp}\n'.encode()
+
+    start = time.time()
+    meter = IntervalMeter(start)
+    queries = []
+    next_req = start
+    while next_req - start < duration:
+        now = time.time()
+        if now < next_req:
+            time.sleep(next_req - now)
+        t0 = time.time()
+        for s in conns:
+            s.sendall(req)
+        left = {s: resp for s in conns}
+        done = []           # 응답별 완료 시각 (가장 느린 서버 = QCT)
+        while left:
+            for key, _ in sel.select():
+                s = key.fileobj
+                if s not in left:
+                    continue
+                try:
+                    n = len(s.recv(min(left[s], 1 << 20)))
+                except BlockingIOError:
+                    continue
+                if n == 0:
+                    raise ConnectionError('server closed')
+                meter.add(n, time.time())
+                left[s] -= n
+                if left[s] == 0:
+                    del left[s]
+                    done.append(time.time() - t0)
+        t1 = time.time()
+        queries.append({'start': t0 - start, 'qct': t1 - t0, 'first': min(done)})
+        next_req = max(next_req + 1.0 / qps, t1) if qps > 0 else t1
+    elapsed = time.time() - start
+    for s in conns:
+        s.close()
+
+    goodput = meter.total * 8 / elapsed
+    result = {
+        'start': {'mode': 'incast', 'args': [len(servers), resp, qps, duration]},
+        'intervals': meter.intervals,
+        'end': {'sum_sent': {'seconds': elapsed, 'bytes': meter.total,
+                             'bits_per_second': goodput},
+                'sum_received': {'seconds': elapsed, 'bytes': meter.total,
+                                 'bits_per_second': goodput}},
+        'queries': queries,
+    }
+    with open(json_out, 'w') as f:
+        json.dump(result, f)
+
+
+def run_client(server_ip, port, mode, args, json_out):
+    s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    s.connect((server_ip, port))
+    start = time.time()
+    meter = IntervalMeter(start)
+    chunks = None
+
+    if mode == 'rate':
+        mbps, duration = float(args[0]), float(args[1])
+        run_rate(s, mbps, duration, meter)
+    else:
+        chunk, period, duration = int(args[0]), float(args[1]), float(args[2])
+        chunks = run_chunked(s, chunk, period, duration, meter)
+    elapsed = time.time() - start
+    s.close()
+
+    result = {
+        'start': {'mode': mode, 'args': args},
+        'intervals': meter.intervals,
+        # 분석 스크립트 호환: 수신 측에서 본 전송량을 sum_sent 에도 기록
+        'end': {'sum_sent': {
+            'seconds': elapsed,
+            'bytes': meter.total,
+            'bits_per_second': meter.total * 8 / elapsed
+        }, 'sum_received': {
+            'seconds': elapsed,
+            'bytes': meter.total,
+            'bits_per_second': meter.total * 8 / elapsed
+        }}
+    }
+    if chunks is not None:
+        result['chunks'] = chunks
+    with open(json_out, 'w') as f:
+        json.dump(result, f)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) >= 3 and sys.argv[1] == 'server':
+        run_server(int(sys.argv[2]))
+    elif len(sys.argv) >= 8 and sys.argv[1] == 'client' and sys.argv[4] == 'rate':
+        run_client(sys.argv[2], int(sys.argv[3]), 'rate', sys.argv[5:7], sys.argv[7])
+    elif len(sys.argv) >= 9 and sys.argv[1] == 'client' and sys.argv[4] == 'chunked':
+        run_client(sys.argv[2], int(sys.argv[3]), 'chunked', sys.argv[5:8], sys.argv[8])
+    elif len(sys.argv) >= 8 and sys.argv[1] == 'incast':
+        run_incast(sys.argv[2].split(','), int(sys.argv[3]), int(sys.argv[4]),
+                   float(sys.argv[5]), float(sys.argv[6]), sys.argv[7])
+    else:
+        print(__doc__)
+        sys.exit(1)
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""
+ACK 경로 비용 벤치마크: 빌트인 reno_custom 의 직접 호출(INDIRECT_CALL) 이득을 tcp_ack() 1회당 ns 로 측정
+- 네임스페이스 두 개를 veth 로 잇고 송신/수신 iperf3 와 softirq 를 한 CPU 에 고정 (루프백과 같은 조건)
+- TSO/GSO/GRO 끄고 quickack 으로 세그먼트마다 ACK → 송신 측 tcp_ack() 호출이 많아지게
+- bpftrace fentry/fexit 로 송신 소켓(목적지 포트 PORT)의 tcp_ack() 실행 시간만 합산 / 호출 수
+  pkts_acked / cong_avoid 호출 지점이 모두 tcp_ack() 안이라 데이터 송수신 비용은 섞이지 않음
+  트램펄린 비용이 호출마다 더해지지만 커널 간에 같아서 차이에서는 상쇄 (절대값은 그만큼 큼)
+- 반복(reps)별 평균으로 평균과 95% 신뢰구간 (t 분포), compare 는 차이의 신뢰구간
+- 같은 조건의 reno(항상 직접 호출)와 나란히 돌리고, 커널별 결과를 tag 로 저장해 비교
+  모듈 커널과 빌트인(CONFIG_TCP_CONG_RENO_CUSTOM=y) 커널에서 각각 실행한 뒤 compare
+- 필요: bpftrace (BTF 가 있는 커널, tcp_ack 가 인라인되지 않은 빌드)
+
+사용법: sudo python3 bench_ack_rate.py [cc1,cc2,..] [tag] [reps (>= 2)]
+       python3 bench_ack_rate.py compare <tag_a> <tag_b>
+"""
+
+import json
+import math
+import os
+import re
+import signal
+import socket
+import statistics
+import subprocess
+import sys
+import time
+
+SND_NS = 'ack_snd'
+RCV_NS = 'ack_rcv'
+SND_IP = '10.201.0.1'
+RCV_IP = '10.201.0.2'
+MTU = 1500
+CPU = (os.cpu_count() or 1) - 1   # 송수신 프로세스 + softirq 를 둘 CPU (cpu0 잡음 피해 마지막)
+PORT = 5201
+DURATION = 10
+REPS = 5
+RESULT = '/tmp/ack_rate_{}.json'
+
+# skc_dport 는 네트워크 바이트 순서 그대로 읽힘 → socket.htons(PORT) 와 비교
+# tcp_ack() 는 softirq 안에서 CPU 별로 겹치지 않으므로 시작 시각은 cpu 키로 충분
+TRACE = """
+BEGIN {{ printf("ready\\n"); }}
+fentry:tcp_ack /args.sk->__sk_common.skc_dport == {dport}/ {{ @start[cpu] = nsecs; }}
+fexit:tcp_ack /@start[cpu]/ {{ @ns = sum(nsecs - @start[cpu]); @calls = count(); delete(@start[cpu]); }}
+END {{ clear(@start); }}
+"""
+
+# 양측 95% t 분포 임계값 (자유도, 값): 표에 없는 자유도는 아래쪽 가장 가까운 값 (보수적)
+T95 = ((1, 12.706), (2, 4.303), (3, 3.182), (4, 2.776), (5, 2.571), (6, 2.447), (7, 2.365),
+       (8, 2.306), (9, 2.262), (10, 2.228), (15, 2.131), (20, 2.086), (30, 2.042), (60, 2.000))
+
+
+def sh(cmd, check=True):
+    return subprocess.run(cmd, shell=True, check=check, text=True,
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE).stdout
+
+
+def ns(name, cmd, check=True):
+    return sh(f"ip netns exec {name} {cmd}", check=check)
+
+
+def setup():
+    teardown()
+    sh(f"ip netns add {SND_NS}")
+    sh(f"ip netns add {RCV_NS}")
+    sh(f"ip link add veth_as netns {SND_NS} type veth peer name veth_ar netns {RCV_NS}")
+    for name, dev, ip in ((SND_NS, 'veth_as', SND_IP), (RCV_NS, 'veth_ar', RCV_IP)):
+        ns(name, "ip link set lo up")
+        ns(name, f"ip link set {dev} mtu {MTU}")
+        # 세그먼트 하나 = skb 하나, ACK 도 세그먼트마다 오도록
+        ns(name, f"ethtool -K {dev} tso off gso off gro off", check=False)
+        ns(name, f"ip addr add {ip}/24 dev {dev}")
+        ns(name, f"ip link set {dev} up")
+    ns(RCV_NS, f"ip route change 10.201.0.0/24 dev veth_ar quickack 1", check=False)
+
+
+def teardown():
+    sh(f"ip netns del {SND_NS}", check=False)
+    sh(f"ip netns del {RCV_NS}", check=False)
+
+
+def start_trace():
+    """bpftrace 를 띄우고 프로브 부착까지 대기 (BEGIN 은 모든 프로브가 붙은 뒤 실행)"""
+    proc = subprocess.Popen(['bpftrace', '-e', TRACE.format(dport=socket.htons(PORT))],
+                            stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+    for line in proc.stdout:
+        if line.strip() == 'ready':
+            return proc
+    proc.wait()
+    raise RuntimeError(f"bpftrace failed to attach to tcp_ack: {proc.stderr.read().strip()}")
+
+
+def stop_trace(proc):
+    """(tcp_ack 총 ns, 호출 수)"""
+    proc.send_signal(signal.SIGINT)
+    out, _ = proc.communicate(timeout=30)
+    vals = dict(re.findall(r'^@(ns|calls): (\d+)$', out, re.M))
+    return int(vals.get('ns', 0)), int(vals.get('calls', 0))
+
+
+def t95(df):
+    return next((t for d, t in reversed(T95) if d <= df), T95[0][1])
+
+
+def mean_se(values):
+    """평균과 표준오차 (반복 2회 이상)"""
+    return statistics.mean(values), statistics.stdev(values) / math.sqrt(len(values))
+
+
+def in_segs(name):
+    out = ns(name, "nstat -asz TcpInSegs", check=False)
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0] == 'TcpInSegs':
+            return int(parts[1])
+    return 0
+
+
+def kernel_info():
+    """reno_custom 빌드 형태와 spectre_v2 완화 상태"""
+    if os.path.exists('/sys/module/reno_custom/initstate'):
+        build = 'module'
+    elif os.path.isdir('/sys/module/reno_custom'):
+        build = 'builtin'
+    else:
+        build = 'absent'
+    try:
+        with open('/sys/devices/system/cpu/vulnerabilities/spectre_v2') as f:
+            spectre = f.read().strip()
+    except OSError:
+        spectre = 'unknown'
+    return {'kernel': os.uname().release, 'reno_custom': build, 'spectre_v2': spectre}
+
+
+def run_once(cc_algo):
+    ns(RCV_NS, f"taskset -c {CPU} iperf3 -s -D -1 -p {PORT}")
+    time.sleep(0.5)
+    trace = start_trace()
+    try:
+        a0 = in_segs(SND_NS)
+        t0 = time.time()
+        ns(SND_NS, f"taskset -c {CPU} iperf3 -c {RCV_IP} -p {PORT} -t {DURATION} -C {cc_algo} -J",
+           check=False)
+        elapsed = time.time() - t0
+        a1 = in_segs(SND_NS)
+    finally:
+        total_ns, calls = stop_trace(trace)
+    if not calls:
+        raise RuntimeError(f"no tcp_ack calls traced for port {PORT} ({cc_algo})")
+
+    acks = a1 - a0
+    return {'acks': acks, 'acks_per_s': acks / elapsed if elapsed else 0.0,
+            'tcp_ack_calls': calls, 'tcp_ack_ns': total_ns / calls if calls else 0.0}
+
+
+def run(ccs, tag, reps=REPS):
+    setup()
+    result = {'info': kernel_info(), 'cc': {}}
+    try:
+        for cc in ccs:
+            runs = []
+            # cc 를 번갈아 돌리지 않고 연속 실행: 순서 효과는 반복 간 분산(신뢰구간)에 반영
+            for _ in range(reps):
+                runs.append(run_once(cc))
+            mean, se = mean_se([r['tcp_ack_ns'] for r in runs])
+            result['cc'][cc] = {
+                'tcp_ack_ns': mean,
+                'tcp_ack_se': se,
+                'ci95': t95(reps - 1) * se,
+                'acks_per_s': statistics.median(r['acks_per_s'] for r in runs),
+                'runs': runs,
+            }
+    finally:
+        ns(RCV_NS, "pkill iperf3", check=False)
+        teardown()
+
+    with open(RESULT.format(tag), 'w') as f:
+        json.dump(result, f, indent=1)
+
+    info = result['info']
+    print(f"\n=== ACK path cost ({tag}): {info['kernel']}, reno_custom {info['reno_custom']} ===")
+    print(f"spectre_v2: {info['spectre_v2']}")
+    print(f"CC\t\ttcp_ack ns (95% CI, n={reps})\tACKs/s")
+    for cc, r in result['cc'].items():
+        print(f"{cc:<16}{r['tcp_ack_ns']:.1f} ± {r['ci95']:.1f}\t\t{r['acks_per_s'] / 1e3:.0f}k")
+    base = result['cc'].get('reno')
+    if base:
+        for cc, r in result['cc'].items():
+            if cc != 'reno':
+                diff, ci = diff_ci([(r, 1), (base, -1)])
+                print(f"{cc} vs reno: {diff:+.1f} ± {ci:.1f} ns/tcp_ack")
+    print(f"Saved to {RESULT.format(tag)}")
+
+
+def diff_ci(terms):
+    """sum(sign * 평균) 과 그 95% 신뢰구간 반폭 (독립 표본, 자유도는 가장 작은 쪽 n - 1)"""
+    diff = sum(sign * r['tcp_ack_ns'] for r, sign in terms)
+    se = math.sqrt(sum(r['tcp_ack_se'] ** 2 for r, _ in terms))
+    df = min(len(r['runs']) for r, _ in terms) - 1
+    return diff, t95(df) * se
+
+
+def compare(tag_a, tag_b):
+    """같은 cc 의 tcp_ack ns 차이 (a - b), reno 차이를 빼서 커널 간 잡음 보정"""
+    with open(RESULT.format(tag_a)) as f:
+        a = json.load(f)
+    with open(RESULT.format(tag_b)) as f:
+        b = json.load(f)
+    print(f"\n=== tcp_ack cost: {tag_a} ({a['info']['reno_custom']}) -> "
+          f"{tag_b} ({b['info']['reno_custom']}) ===")
+    drift = []
+    if 'reno' in a['cc'] and 'reno' in b['cc']:
+        d, ci = diff_ci([(b['cc']['reno'], 1), (a['cc']['reno'], -1)])
+        print(f"reno drift: {d:+.1f} ± {ci:.1f} ns (subtracted)")
+        drift = [(b['cc']['reno'], 1), (a['cc']['reno'], -1)]
+    for cc in a['cc']:
+        if cc == 'reno' or cc not in b['cc']:
+            continue
+        ra, rb = a['cc'][cc], b['cc'][cc]
+        saving, ci = diff_ci([(ra, 1), (rb, -1)] + drift)
+        verdict = '' if abs(saving) > ci else ' (not significant)'
+        print(f"{cc}: {ra['tcp_ack_ns']:.1f} -> {rb['tcp_ack_ns']:.1f} ns, "
+              f"saving {saving:.1f} ± {ci:.1f} ns/tcp_ack (95% CI){verdict}")
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1 and sys.argv[1] == 'compare':
+        if len(sys.argv) < 4:
+            sys.exit(__doc__)
+        compare(sys.argv[2], sys.argv[3])
+        sys.exit(0)
+    ccs = sys.argv[1].split(',') if len(sys.argv) > 1 else ['reno', 'reno_custom']
+    tag = sys.argv[2] if len(sys.argv) > 2 else kernel_info()['reno_custom']
+    reps = int(sys.argv[3]) if len(sys.argv) > 3 else REPS
+    if reps < 2:
+        sys.exit("reps must be >= 2 for a confidence interval")
+    run(ccs, tag, reps)
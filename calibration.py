@@ -0,0 +1,206 @@
+"""
+에뮬레이션 충실도 자체 점검 (본 실험 전 링크 보정 단계)
+
+TCLink/netem 에 10 Gbit/s + 50ms 같은 값을 요청해도 호스트가 그만큼 못 내면
+알고리즘 대신 에뮬레이터를 측정하게 되므로, 본 실행 전에 경로별로
+  - ping 200개 (5ms 간격): RTT 분포(p50/p95/p99/표준편차)
+  - UDP 0.5배 속도 1초: 데이터 방향 손실률 (큐 넘침 없이)
+  - UDP 1.2배 속도 1초: 실제 전달 용량
+을 재서 설정값(경로 위 링크들의 bw/delay/jitter/loss 합성)과 비교하고,
+허용 오차를 넘으면 경고한다. 결과는 CALIBRATION_FILE 에 저장되어
+run_all_tests.py 가 시나리오 결과와 함께 백업한다.
+
+  from calibration import calibrate
+  calibrate(net, [(clients[0], server)])
+  calibrate(net, pairs, limits={'s1-eth1': {'bw': 50}})   # tc 로 직접 설치한 제한기
+
+UDP 프로브는 목표 속도에 맞춰 여러 스트림(-P)으로 보냄: 한 스트림(1400 B 데이터그램)은
+수 Gbit/s 에서 송신 CPU 가 먼저 막혀 10 Gbit/s 급 링크를 채우지 못함 (iperf3 3.16+ 는 스트림별 스레드)
+
+RENO_SKIP_CALIBRATION=1 이면 건너뜀
+"""
+
+import json
+import math
+import os
+import re
+
+from mininet.log import info
+
+CALIBRATION_FILE = '/tmp/calibration.json'
+PROBE_PORT = 5290
+PROBE_STREAM_MBPS = 2000  # UDP 프로브 스트림 하나가 맡는 속도
+PROBE_MAX_STREAMS = 16
+
+CAP_TOL = 0.10            # 용량 상대 오차
+RTT_TOL = 0.10            # RTT 중앙값 상대 오차
+RTT_TOL_ABS_MS = 0.5      # 짧은 RTT 에서는 절대 오차 허용
+LOSS_TOL_ABS = 0.5        # 손실률 절대 오차 (%p)
+LOSS_TOL_REL = 0.5        # 또는 상대 오차
+
+
+def _ms(value):
+    """TCLink 지연 문자열('10ms', '500us', '1s') → ms"""
+    if value is None:
+        return 0.0
+    if isinstance(value, (int, float)):
+        return float(value)
+    m = re.match(r'([\d.]+)\s*(us|ms|s)?$', str(value))
+    if not m:
+        return 0.0
+    scale = {'us': 1e-3, 'ms': 1.0, 's': 1e3, None: 1.0}[m.group(2)]
+    return float(m.group(1)) * scale
+
+
+def _find_path(net, src, dst):
+    """src → dst 링크 목록 (BFS)"""
+    adj = {}
+    for link in net.links:
+        a, b = link.intf1.node, link.intf2.node
+        adj.setdefault(a, []).append((b, link))
+        adj.setdefault(b, []).append((a, link))
+
+    prev = {src: None}
+    queue = [src]
+    while queue:
+        node = queue.pop(0)
+        if node == dst:
+            break
+        for nxt, link in adj.get(node, []):
+            if nxt not in prev:
+                prev[nxt] = (node, link)
+                queue.append(nxt)
+    if dst not in prev:
+        return []
+    path = []
+    node = dst
+    while prev[node] is not None:
+        node, link = prev[node]
+        path.append(link)
+    return list(reversed(path))
+
+
+def expected_path(links, limits=None):
+    """
+    링크 파라미터 합성: 용량 = 최소, 지연/지터 = 합, 손실 = 1 - Π(1-p)
+    limits: {인터페이스 이름: TCLink 와 같은 키의 파라미터} 일반 Link 위에 tc 로 직접 설치한
+            제한기 (데이터 방향 송신 인터페이스), 경로 위 링크의 파라미터에 더해 합성
+    """
+    limits = limits or {}
+    params = []
+    for link in links:
+        params.append(getattr(link.intf1, 'params', {}) or {})
+        params += [limits[i.name] for i in (link.intf1, link.intf2) if i.name in limits]
+
+    bw = None
+    delay = jitter2 = 0.0
+    keep = 1.0
+    for p in params:
+        if p.get('bw'):
+            bw = p['bw'] if bw is None else min(bw, p['bw'])
+        delay += _ms(p.get('delay'))
+        jitter2 += _ms(p.get('jitter')) ** 2
+        keep *= 1.0 - (p.get('loss') or 0) / 100.0
+    return {
+        'bw_mbps': bw,
+        'rtt_ms': 2 * delay,
+        'jitter_ms': math.sqrt(jitter2),
+        'loss_pct': (1.0 - keep) * 100.0,
+    }
+
+
+def _ping(src, dst, count=200, interval=0.005):
+    out = src.cmd(f"ping -n -c {count} -i {interval} -W 2 {dst.IP()}")
+    rtts = [float(m) for m in re.findall(r'time=([\d.]+) ms', out)]
+    return rtts, 1.0 - len(rtts) / count
+
+
+def _udp_probe(src, dst, mbps, seconds=1):
+    """UDP 로 mbps 송신 (스트림 여러 개로 나눠), (수신 bps, 손실률 %) 반환"""
+    streams = min(PROBE_MAX_STREAMS, max(1, math.ceil(mbps / PROBE_STREAM_MBPS)))
+    dst.cmd(f"iperf3 -s -1 -p {PROBE_PORT} > /dev/null 2>&1 &")
+    # -b 는 스트림당 속도
+    out = src.cmd(f"sleep 0.3; iperf3 -J -u -l 1400 -P {streams} -b {mbps / streams:.0f}M "
+                  f"-t {seconds} -c {dst.IP()} -p {PROBE_PORT}")
+    try:
+        end = json.loads(out[out.index('{'):])['end']
+    except (ValueError, KeyError):
+        return None, None
+    s = end.get('sum_received') or end.get('sum', {})
+    lost = end.get('sum', {}).get('lost_percent', 0.0)
+    bps = s.get('bits_per_second', 0.0)
+    if 'sum_received' not in end:
+        bps *= 1.0 - lost / 100.0
+    return bps, lost
+
+
+def _pct(values, p):
+    v = sorted(values)
+    return v[min(len(v) - 1, int(p * len(v)))] if v else 0.0
+
+
+def calibrate_path(net, src, dst, limits=None):
+    exp = expected_path(_find_path(net, src, dst), limits)
+    rtts, rt_loss = _ping(src, dst)
+    meas = {
+        'rtt_p50_ms': _pct(rtts, 0.50),
+        'rtt_p95_ms': _pct(rtts, 0.95),
+        'rtt_p99_ms': _pct(rtts, 0.99),
+        'rtt_std_ms': (sum((r - sum(rtts) / len(rtts)) ** 2 for r in rtts) / len(rtts)) ** 0.5
+                      if rtts else 0.0,
+        # 왕복 손실 → 대칭 가정 편도 손실
+        'ping_loss_pct': (1.0 - math.sqrt(max(0.0, 1.0 - rt_loss))) * 100.0,
+    }
+    if exp['bw_mbps']:
+        _, meas['loss_pct'] = _udp_probe(src, dst, exp['bw_mbps'] * 0.5)
+        bps, _ = _udp_probe(src, dst, exp['bw_mbps'] * 1.2)
+        meas['bw_mbps'] = bps / 1e6 if bps is not None else None
+    if meas.get('loss_pct') is None:
+        meas['loss_pct'] = meas['ping_loss_pct']
+
+    flags = []
+    if exp['bw_mbps'] and meas.get('bw_mbps') is not None:
+        err = abs(meas['bw_mbps'] - exp['bw_mbps']) / exp['bw_mbps']
+        if err > CAP_TOL:
+            flags.append(f"capacity {meas['bw_mbps']:.0f}/{exp['bw_mbps']:.0f} Mbit/s "
+                         f"({err * 100:.0f}% off)")
+    if rtts:
+        err = abs(meas['rtt_p50_ms'] - exp['rtt_ms'])
+        if err > max(RTT_TOL * exp['rtt_ms'], RTT_TOL_ABS_MS):
+            flags.append(f"RTT p50 {meas['rtt_p50_ms']:.2f}/{exp['rtt_ms']:.2f} ms")
+    else:
+        flags.append("no ping replies")
+    err = abs(meas['loss_pct'] - exp['loss_pct'])
+    if err > max(LOSS_TOL_ABS, LOSS_TOL_REL * exp['loss_pct']):
+        flags.append(f"loss {meas['loss_pct']:.2f}/{exp['loss_pct']:.2f}%")
+
+    return {'src': src.name, 'dst': dst.name, 'expected': exp,
+            'measured': meas, 'flags': flags, 'ok': not flags}
+
+
+def calibrate(net, pairs, path=CALIBRATION_FILE, limits=None):
+    """
+    pairs: [(송신 호스트, 수신 호스트), ...] 데이터 방향 경로별 보정, 결과 리스트 반환
+    limits: 시나리오가 tc 로 직접 설치한 제한기 {인터페이스 이름: {'bw', 'delay', 'loss', ...}}
+    """
+    if os.environ.get('RENO_SKIP_CALIBRATION') == '1':
+        return []
+
+    info("*** Calibrating emulated links\n")
+    results = []
+    for src, dst in pairs:
+        r = calibrate_path(net, src, dst, limits)
+        results.append(r)
+        m, e = r['measured'], r['expected']
+        bw = f"{m['bw_mbps']:.0f}/{e['bw_mbps']:.0f} Mbit/s" if m.get('bw_mbps') is not None else "-"
+        info(f"{r['src']}->{r['dst']}: bw {bw}, RTT p50 {m['rtt_p50_ms']:.2f}/{e['rtt_ms']:.2f} ms "
+             f"(p99 {m['rtt_p99_ms']:.2f}), loss {m['loss_pct']:.2f}/{e['loss_pct']:.2f}%\n")
+        for flag in r['flags']:
+            info(f"  !! emulation error: {flag}\n")
+
+    with open(path, 'w') as f:
+        json.dump({'paths': results, 'ok': all(r['ok'] for r in results)}, f, indent=1)
+    if not all(r['ok'] for r in results):
+        info("*** WARNING: emulation does not match the configured links; "
+             "results may measure the emulator, not the algorithm\n")
+    return results
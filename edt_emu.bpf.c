@@ -0,0 +1,136 @@
+/*
+ * edt_emu: tc egress eBPF 링크 에뮬레이터 (Earliest Departure Time + fq)
+ *
+ *   clang -O2 -g -target bpf -mcpu=v3 -c edt_emu.bpf.c -o edt_emu.bpf.o   (make bpf)
+ *   tc qdisc replace dev X root handle 1: mq + 큐마다 fq  → edt_link.py 가 설정
+ *   tc filter add dev X egress bpf da obj edt_emu.bpf.o sec tc
+ *
+ * - netem 은 모든 패킷을 qdisc 하나의 지연 큐에 넣고 한 CPU 에서 꺼내므로
+ *   10 Gbit/s x 50ms (수만 패킷 체류) 에서 밀림. 여기서는 패킷마다 출발 시각만
+ *   skb->tstamp 에 찍고 실제 대기는 송신 큐별 fq 의 시간 정렬(EDT)에 맡긴다.
+ *   → 큐/CPU 마다 독립적으로 처리, 프로그램은 O(1)
+ * - 용량: 링크 하나의 "다음 출발 가능 시각" 을 모든 CPU 가 CAS 로 예약
+ *   (시작 = max(next_ns, now), next_ns = 시작 + len / rate). 경합하면 몇 번 다시 시도
+ * - 버퍼: 예약될 대기 시간이 limit_ns 를 넘으면 예약하지 않고 드롭 (바이트 버퍼를 rate 로 환산한 값)
+ * - 손실: 독립 손실 (bpf_get_prandom_u32 < 임계값), 용량을 쓰기 전에 적용
+ * - 지연: 출발 시각 + delay_ns. fq 가 그 시각까지 보유
+ * - 설정(edt_cfg)과 상태는 필터 인스턴스마다 따로 (tc 가 장치별로 맵을 새로 만듦)
+ */
+
+#include <linux/bpf.h>
+#include <linux/pkt_cls.h>
+#include <bpf/bpf_helpers.h>
+
+#define NSEC_PER_SEC    1000000000ULL
+#define EDT_CAS_TRIES   4
+#define EDT_DROP        (~0ULL)
+
+struct edt_cfg {
+    __u64 rate_bps;         /* 0 이면 용량 제한 없음 */
+    __u64 delay_ns;
+    __u64 limit_ns;         /* 0 이면 버퍼 무한 */
+    __u32 loss_thresh;      /* 손실 확률 * 2^32 */
+    __u32 pad;
+};
+
+struct edt_state {
+    __u64 next_ns;          /* 링크가 다음 바이트를 내보낼 수 있는 시각 */
+};
+
+struct edt_stats {
+    __u64 pkts, bytes, drops, lost;
+};
+
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct edt_cfg);
+} edt_cfg SEC(".maps");
+
+struct {
+    __uint(type, BPF_MAP_TYPE_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct edt_state);
+} edt_state SEC(".maps");
+
+struct {
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct edt_stats);
+} edt_stats SEC(".maps");
+
+/*
+ * tx_ns 길이 전송 구간 예약 → 전송 시작 시각, 대기가 limit_ns 를 넘으면 EDT_DROP
+ * 두 CPU 가 같은 next_ns 를 보고 둘 다 now 에 찍지 않도록 CAS 로 예약하고,
+ * 다른 CPU 가 먼저 바꿨으면 새 값으로 다시 계산 (검증기용 고정 횟수)
+ */
+static __always_inline __u64 edt_reserve(struct edt_state *st, __u64 now, __u64 tx_ns,
+                                         __u64 limit_ns)
+{
+    __u64 cur, start;
+    int i;
+
+    for (i = 0; i < EDT_CAS_TRIES; i++) {
+        cur = *(volatile __u64 *)&st->next_ns;
+        start = cur > now ? cur : now;
+        if (limit_ns && start - now > limit_ns)
+            return EDT_DROP;
+        if (__sync_val_compare_and_swap(&st->next_ns, cur, start + tx_ns) == cur)
+            return start;
+    }
+    /*
+     * 계속 경합하면 링크가 바쁜 중이므로 (next_ns >= now) fetch_add 로 뒤에 붙임.
+     * 드물게 그 사이 링크가 비었으면 next_ns 가 과거에 남아 한 패킷 정도의 버스트 허용
+     */
+    cur = __sync_fetch_and_add(&st->next_ns, tx_ns);
+    start = cur > now ? cur : now;
+    if (limit_ns && start - now > limit_ns) {
+        __sync_fetch_and_sub(&st->next_ns, tx_ns);
+        return EDT_DROP;
+    }
+    return start;
+}
+
+SEC("tc")
+int edt_emu(struct __sk_buff *skb)
+{
+    __u32 key = 0;
+    struct edt_cfg *cfg = bpf_map_lookup_elem(&edt_cfg, &key);
+    struct edt_state *st = bpf_map_lookup_elem(&edt_state, &key);
+    struct edt_stats *stats = bpf_map_lookup_elem(&edt_stats, &key);
+    __u64 now, start, depart;
+
+    if (!cfg || !st || !stats)
+        return TC_ACT_OK;
+
+    stats->pkts++;
+    stats->bytes += skb->len;
+
+    if (cfg->loss_thresh && bpf_get_prandom_u32() < cfg->loss_thresh) {
+        stats->lost++;
+        return TC_ACT_SHOT;
+    }
+
+    now = bpf_ktime_get_ns();
+    depart = now;
+    if (cfg->rate_bps) {
+        /* GSO 패킷이면 len 이 세그먼트 합이므로 그대로 전체 전송 시간 */
+        __u64 tx_ns = (__u64)skb->len * 8 * NSEC_PER_SEC / cfg->rate_bps;
+
+        start = edt_reserve(st, now, tx_ns, cfg->limit_ns);
+        if (start == EDT_DROP) {
+            stats->drops++;
+            return TC_ACT_SHOT;
+        }
+        depart = start + tx_ns;
+    }
+
+    /* 송신 스택이 찍은 값(TCP 페이싱)이나 수신 타임스탬프는 덮어씀: 링크 시각만 사용 */
+    skb->tstamp = depart + cfg->delay_ns;
+    return TC_ACT_OK;
+}
+
+char _license[] SEC("license") = "GPL";
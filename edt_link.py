@@ -0,0 +1,179 @@
+"""
+EDT(eBPF + fq) 링크 백엔드: TCLink(netem) 대신 쓰는 Mininet 링크
+
+  from edt_link import link_cls
+  self.addLink(a, b, cls=link_cls(), bw=10000, delay='50ms', loss=0.1)
+
+- link_cls(): 환경 변수 RENO_LINK=edt 면 EdtLink, 아니면 TCLink (run_all_tests.py 가 시나리오별로 지정)
+- EdtLink: 송신 큐 EDT_QUEUES 개짜리 veth 쌍 → 양쪽 인터페이스 root 를 mq + 큐별 fq 로,
+  clsact egress 에 edt_emu.bpf.o (출발 시각 스탬프 + 용량 + 버퍼 + 손실)
+  큐 선택(XPS)이 CPU 별이라 송신 CPU 들이 서로 다른 fq 에서 처리됨
+- 파라미터는 TCLink 와 같은 이름 (bw Mbit/s, delay, loss %, max_queue_size 패킷),
+  max_queue_size 가 없으면 TCLink(netem) 기본 한도와 같은 1000 패킷 → 백엔드만 바꿔도 버퍼는 같음
+  intf.params 에 그대로 남아 calibration.py 가 같은 방식으로 충실도를 점검
+  jitter 는 지원하지 않음 (경고 후 무시)
+- 필터 인스턴스마다 맵이 따로 생기므로 tc 가 보여 주는 prog id → bpftool 로 맵을 찾아 설정
+  오브젝트/맵이 없거나 tc/bpftool 이 실패하면 예외 (조용히 성형 안 된 veth 로 돌지 않도록)
+- 오프로드(GSO/TSO)는 켜 둠: 큰 skb 하나에 스탬프 하나라 10 Gbit/s 이상에서도 패킷 수가 적음
+"""
+
+import json
+import os
+import re
+import struct
+
+from mininet.link import Link, TCLink, Intf
+from mininet.log import info, warn
+from mininet.util import quietRun
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+EDT_OBJ = os.path.join(HERE, 'edt_emu.bpf.o')
+EDT_QUEUES = min(os.cpu_count() or 1, 8)
+FQ_LIMIT = 200000         # 큐당 패킷 수 (10 Gbit/s x 50ms 는 GSO 없이 ~4만 패킷)
+FQ_FLOW_LIMIT = 100000    # 흐름 하나가 지연 동안 큐에 쌓는 양을 막지 않도록
+FQ_HORIZON = '10s'        # 이보다 먼 출발 시각은 드롭 (지연 + 버퍼 상한)
+MTU_BYTES = 1500
+DEFAULT_QUEUE_PKTS = 1000  # max_queue_size 가 없을 때 netem 의 기본 limit
+
+
+def backend():
+    return os.environ.get('RENO_LINK', 'netem')
+
+
+def link_cls():
+    """시나리오 링크 클래스 (RENO_LINK=edt 면 EdtLink)"""
+    return EdtLink if backend() == 'edt' else TCLink
+
+
+def _ms(value):
+    """'50ms' / '100us' / 숫자(ms) → ms"""
+    if value is None:
+        return 0.0
+    if isinstance(value, (int, float)):
+        return float(value)
+    m = re.match(r'([\d.]+)\s*(us|ms|s)?$', str(value))
+    if not m:
+        return 0.0
+    scale = {'us': 1e-3, 'ms': 1.0, 's': 1e3, None: 1.0}[m.group(2)]
+    return float(m.group(1)) * scale
+
+
+def _prog_maps(node, dev):
+    """egress 필터 프로그램의 {맵 이름: 맵 id}"""
+    try:
+        filters = json.loads(node.cmd(f"tc -j filter show dev {dev} egress"))
+    except ValueError:
+        return {}
+    for f in filters:
+        prog = f.get('options', {}).get('prog', {})
+        if 'id' not in prog:
+            continue
+        try:
+            ids = json.loads(node.cmd(f"bpftool -j prog show id {prog['id']}")).get('map_ids', [])
+            return {json.loads(node.cmd(f"bpftool -j map show id {m}"))['name']: m for m in ids}
+        except (ValueError, KeyError):
+            return {}
+    return {}
+
+
+def _hex(data):
+    return ' '.join(f'{b:02x}' for b in data)
+
+
+def attach(node, dev, bw=None, delay=None, loss=None, max_queue_size=None, queues=1):
+    """dev 송신 방향에 EDT 에뮬레이션 설정, 실패하면 오류 문자열 목록"""
+    if not os.path.exists(EDT_OBJ):
+        return [f"{EDT_OBJ} not found (make bpf)"]
+    errors = []
+    # 큐마다 fq (EDT 는 fq 가 skb->tstamp 순으로 보유), 큐가 하나면 root 에 바로
+    fq = f"fq limit {FQ_LIMIT} flow_limit {FQ_FLOW_LIMIT} horizon {FQ_HORIZON} horizon_drop nopacing"
+    if queues > 1:
+        out = node.cmd(f"tc qdisc replace dev {dev} root handle 1: mq")
+        for i in range(1, queues + 1):
+            out += node.cmd(f"tc qdisc replace dev {dev} parent 1:{i:x} {fq}")
+    else:
+        out = node.cmd(f"tc qdisc replace dev {dev} root {fq}")
+    out += node.cmd(f"tc qdisc replace dev {dev} clsact")
+    out += node.cmd(f"tc filter replace dev {dev} egress prio 1 handle 1 "
+                    f"bpf da obj {EDT_OBJ} sec tc")
+    if out.strip():
+        errors.append(out.strip())
+
+    maps = _prog_maps(node, dev)
+    if 'edt_cfg' not in maps:
+        return errors + [f"{dev}: edt_cfg map not found (is {EDT_OBJ} built? make bpf)"]
+
+    rate_bps = int(bw * 1e6) if bw else 0
+    # 버퍼(패킷) → 용량 기준 대기 시간 (TCLink 의 max_queue_size 와 같은 의미)
+    queue_pkts = max_queue_size or DEFAULT_QUEUE_PKTS
+    limit_ns = int(queue_pkts * MTU_BYTES * 8 / rate_bps * 1e9) if rate_bps else 0
+    loss_thresh = min(int((loss or 0) / 100.0 * 2 ** 32), 2 ** 32 - 1)
+    value = struct.pack('=QQQII', rate_bps, int(_ms(delay) * 1e6), limit_ns, loss_thresh, 0)
+    out = node.cmd(f"bpftool map update id {maps['edt_cfg']} key hex 00 00 00 00 "
+                   f"value hex {_hex(value)}")
+    if out.strip():
+        errors.append(out.strip())
+    return errors
+
+
+def edt_stats(node, dev):
+    """{'pkts', 'bytes', 'drops', 'lost'} (CPU 합), 없으면 None"""
+    maps = _prog_maps(node, dev)
+    if 'edt_stats' not in maps:
+        return None
+    try:
+        entries = json.loads(node.cmd(f"bpftool -j map dump id {maps['edt_stats']}"))
+    except ValueError:
+        return None
+    total = dict.fromkeys(('pkts', 'bytes', 'drops', 'lost'), 0)
+    for e in entries:
+        for v in e.get('values', []):
+            fields = struct.unpack('=QQQQ', bytes(int(b, 16) for b in v['value']))
+            for k, x in zip(total, fields):
+                total[k] += x
+    return total
+
+
+class EdtIntf(Intf):
+    """송신 방향을 edt_emu 로 에뮬레이션하는 인터페이스 (TCIntf 대응)"""
+
+    def config(self, bw=None, delay=None, jitter=None, loss=None, max_queue_size=None,
+               queues=EDT_QUEUES, **params):
+        result = Intf.config(self, **params)
+        if jitter:
+            warn(f"*** {self.name}: EDT backend ignores jitter={jitter}\n")
+        # 설정이 안 되면 용량/지연/손실 없는 veth 로 계속 돌게 되므로 링크 생성을 실패시킴
+        errors = attach(self.node, self.name, bw, delay, loss, max_queue_size, queues)
+        if errors:
+            raise Exception(f"EDT link setup failed on {self.name}: " + '; '.join(errors))
+        desc = [f'{bw}Mbit' if bw else None, f'{delay} delay' if delay else None,
+                f'{loss}% loss' if loss else None, f'{queues} queues']
+        info('(edt ' + ' '.join(d for d in desc if d) + ') ')
+        return result
+
+
+class EdtLink(Link):
+    """양쪽 인터페이스가 EdtIntf 인 링크, veth 는 송수신 큐 EDT_QUEUES 개로 생성"""
+
+    def __init__(self, *args, **kwargs):
+        kwargs.setdefault('cls1', EdtIntf)
+        kwargs.setdefault('cls2', EdtIntf)
+        Link.__init__(self, *args, **kwargs)
+
+    @staticmethod
+    def makeIntfPair(intfname1, intfname2, addr1=None, addr2=None,
+                     node1=None, node2=None, deleteIntfs=True):
+        """mininet.util.makeIntfPair 와 같되 numtxqueues/numrxqueues 지정"""
+        run1 = node1.cmd if node1 else quietRun
+        run2 = node2.cmd if node2 else quietRun
+        if deleteIntfs:
+            run1(f'ip link del {intfname1}')
+            run2(f'ip link del {intfname2}')
+        netns = node2.pid if node2 else 1
+        q = f'numtxqueues {EDT_QUEUES} numrxqueues {EDT_QUEUES}'
+        a1 = f' address {addr1}' if addr1 else ''
+        a2 = f' address {addr2}' if addr2 else ''
+        out = run1(f'ip link add name {intfname1}{a1} {q} type veth '
+                   f'peer name {intfname2}{a2} {q} netns {netns}')
+        if out:
+            raise Exception(f"Error creating interface pair ({intfname1},{intfname2}): {out}")
@@ -0,0 +1,200 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import json
+import subprocess
+import threading
+import time
+
+from exp_common import parse_ss_tcp_info
+from calibration import calibrate
+from live_dashboard import LiveFeed, link_queue
+
+# 앱 제한 / 청크 스트리밍 송신자에서 BWE 와 ssthresh 가 어떻게 변하는지 측정
+#   h1 (송신 서버, app_workload.py) ══ 병목 ══ s1 ── h2..h6 (수신 클라이언트)
+# reno_custom 은 get_info 로 BWE 를 노출하므로 ss -i 의 bbr:(bw:..) 로 샘플링
+BOTTLENECK_BW = 100       # Mbit/s
+PORT = 7000
+SAMPLE = 0.1              # ss 샘플 간격 (초)
+
+# 클라이언트별 워크로드: ('rate', Mbit/s) 또는 ('chunked', 바이트, 주기 초)
+WORKLOADS = {
+    'h2': ('rate', 10),
+    'h3': ('rate', 30),
+    'h4': ('chunked', 4000000, 2.0),     # 16 Mbit/s 평균, 2초 세그먼트
+    'h5': ('chunked', 1000000, 1.0),     # 8 Mbit/s 평균, 1초 세그먼트
+    'h6': ('rate', 0),                   # 무제한 (기준)
+}
+
+
+class AppLimitedTopo(Topo):
+    def build(self):
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, 7)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        self.addLink(server, s1, cls=TCLink, bw=BOTTLENECK_BW, delay='10ms')
+        for h in clients:
+            self.addLink(h, s1, cls=TCLink, bw=1000, delay='1ms')
+
+
+class SsSampler(threading.Thread):
+    """서버 소켓들의 ss -tin 을 주기적으로 기록: [(t, [socket dict, ...]), ...]"""
+
+    def __init__(self, host, t0):
+        super().__init__(daemon=True)
+        self.host = host
+        self.t0 = t0
+        self.samples = []
+        self.stop_event = threading.Event()
+
+    def run(self):
+        cmd = ['ss', '-tin', 'state', 'established', f'sport = :{PORT}']
+        while not self.stop_event.is_set():
+            out = self.host.popen(cmd, stdout=subprocess.PIPE, text=True).communicate()[0]
+            self.samples.append((time.time() - self.t0, parse_ss_tcp_info(out)))
+            time.sleep(SAMPLE)
+
+    def stop(self):
+        self.stop_event.set()
+        self.join()
+
+
+def runExperiment(cc_algo='reno', duration=30):
+    topo = AppLimitedTopo()
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, 7)]
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+
+    server_ip = server.IP()
+
+    calibrate(net, [(server, clients[0])])
+
+    server.cmd("pkill -f app_workload.py")
+    server.cmd(f"python3 app_workload.py server {PORT} > /tmp/app_workload_server.log 2>&1 &")
+    time.sleep(1)
+
+    t0 = time.time()
+    sampler = SsSampler(server, t0)
+    sampler.start()
+
+    info("*** Start app-limited / chunked clients (h2~h6)\n")
+    flows = {}
+    for c in clients:
+        w = WORKLOADS[c.name]
+        logFile = f"/tmp/iperf3_{c.name}_{cc_algo}.json"
+        if w[0] == 'rate':
+            args = f"rate {w[1]} {duration}"
+        else:
+            args = f"chunked {w[1]} {w[2]} {duration}"
+        c.cmd(f"python3 app_workload.py client {server_ip} {PORT} {args} {logFile} &")
+        info(f"{c.name}: {args}\n")
+        flows[c.name] = (c.IP(), time.time() - t0, logFile)
+
+    live = LiveFeed([server], [link_queue(net, 'h1', 's1')])
+    live.start()
+    info(f"*** Running {duration} seconds...\n")
+    time.sleep(duration + 3)
+    live.stop()
+    sampler.stop()
+
+    with open(f"/tmp/app_limited_ss_{cc_algo}.json", 'w') as f:
+        json.dump(sampler.samples, f)
+    report(flows, sampler.samples, cc_algo)
+
+    server.cmd("pkill -f app_workload.py")
+    info("*** Finished. ss samples saved to "
+         f"/tmp/app_limited_ss_{cc_algo}.json\n")
+    CLI(net)
+    net.stop()
+
+
+def flow_series(samples, ip):
+    """피어 IP 별 [(t, cwnd, ssthresh, bbr_bw_bps, delivery_rate_bps), ...]"""
+    series = []
+    for t, socks in samples:
+        for s in socks:
+            if s.get('peer', '').rsplit(':', 1)[0] == ip:
+                series.append((t, s.get('cwnd'), s.get('ssthresh'),
+                               s.get('bbr_bw_bps'), s.get('delivery_rate_bps')))
+    return series
+
+
+def _at(series, t, before=True):
+    """t 직전(before) 또는 직후 샘플"""
+    if before:
+        cand = [x for x in series if x[0] <= t]
+        return cand[-1] if cand else None
+    cand = [x for x in series if x[0] >= t]
+    return cand[0] if cand else None
+
+
+def _pct(values, p):
+    v = sorted(values)
+    return v[min(len(v) - 1, int(p * len(v)))] if v else 0.0
+
+
+def report(flows, samples, cc_algo):
+    info(f"\n=== App-limited / chunked workloads ({cc_algo}) ===\n")
+    if not any(socks for _, socks in samples):
+        info(f"!! no ss samples for server sockets on port {PORT}: BWE columns are empty\n")
+    info("Host\tWorkload\t\tGoodput\tMean BWE\tBWE/goodput\n")
+    for name, (ip, offset, path) in sorted(flows.items()):
+        w = WORKLOADS[name]
+        try:
+            with open(path) as f:
+                data = json.load(f)
+            goodput = data['end']['sum_received']['bits_per_second']
+        except (OSError, ValueError, KeyError):
+            data, goodput = {}, 0.0
+        series = flow_series(samples, ip)
+        bwe = [x[3] for x in series if x[3]]
+        mean_bwe = sum(bwe) / len(bwe) if bwe else 0.0
+        label = f"rate {w[1]}M" if w[0] == 'rate' else f"chunk {w[1] // 1000}K/{w[2]}s"
+        ratio = f"{mean_bwe / goodput:.2f}" if goodput > 0 and mean_bwe > 0 else "-"
+        bwe_col = f"{mean_bwe / 1e6:.1f}M" if bwe else "-"
+        info(f"{name}\t{label:<16}\t{goodput / 1e6:.1f}M\t{bwe_col}\t\t{ratio}\n")
+
+        if w[0] != 'chunked' or 'chunks' not in data:
+            continue
+
+        # 청크별 다운로드 시간
+        times = [c['seconds'] for c in data['chunks']]
+        info(f"  chunk download (s): mean {sum(times) / len(times):.3f}, "
+             f"p95 {_pct(times, 0.95):.3f}, max {max(times):.3f} ({len(times)} chunks)\n")
+
+        # 유휴 구간 전후 BWE / ssthresh: 직전 청크 끝 샘플 vs 다음 청크 시작 직후 샘플
+        changes = []
+        for prev, cur in zip(data['chunks'], data['chunks'][1:]):
+            if cur['idle_before'] < SAMPLE * 2:
+                continue
+            end_prev = offset + prev['start'] + prev['seconds']
+            a = _at(series, end_prev, before=True)
+            b = _at(series, offset + cur['start'], before=False)
+            if a and b and a[3] and b[3]:
+                changes.append((cur['idle_before'], a[3], b[3], a[2], b[2]))
+        if changes:
+            bw_ratio = [b / a for _, a, b, _, _ in changes]
+            info(f"  across {len(changes)} idle gaps (mean {sum(c[0] for c in changes) / len(changes):.2f}s): "
+                 f"BWE after/before mean {sum(bw_ratio) / len(bw_ratio):.2f}, "
+                 f"min {min(bw_ratio):.2f}\n")
+            first = changes[0]
+            info(f"  first gap: BWE {first[1] / 1e6:.1f}M -> {first[2] / 1e6:.1f}M, "
+                 f"ssthresh {first[3]} -> {first[4]}\n")
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    runExperiment(cc_algo, duration=10)
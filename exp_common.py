@@ -0,0 +1,204 @@
+"""
+실험 스크립트 공통 유틸리티
+- reno_custom 모듈 파라미터 설정, /proc/net/reno_custom 카운터
+- iperf3 JSON 의 구간(interval) 처리량 추출
+- Jain's Fairness Index
+- `ss -tin` 출력 파싱 (cwnd, ssthresh, RTT, delivery rate)
+- 스위치 인터페이스 카운터 기반 홉별 링크 이용률
+- 호스트 네임스페이스 TCP 카운터 (nstat: RTO, 재전송)
+- 적대적 시나리오 코퍼스 (search_scenarios.py 결과) 읽기
+"""
+
+import json
+import os
+
+PARAM_DIR = '/sys/module/reno_custom/parameters'
+PROC_STATS = '/proc/net/reno_custom'
+CORPUS_FILE = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'scenario_corpus.json')
+
+
+def set_module_param(name, value):
+    """reno_custom 모듈 파라미터를 sysfs 로 변경 (sudo 필요)"""
+    with open(f'{PARAM_DIR}/{name}', 'w') as f:
+        f.write(str(int(value) if isinstance(value, bool) else value))
+
+
+def get_module_param(name):
+    try:
+        with open(f'{PARAM_DIR}/{name}') as f:
+            return f.read().strip()
+    except OSError:
+        return None
+
+
+def module_stats():
+    """모듈 누적 카운터 {이름: 값} (모듈이 없으면 빈 dict)"""
+    try:
+        with open(PROC_STATS) as f:
+            return {k: int(v) for k, v in (line.split() for line in f)}
+    except (OSError, ValueError):
+        return {}
+
+
+def jain_fairness(values):
+    """Jain's Fairness Index 계산"""
+    if not values:
+        return 0.0
+    s = sum(values)
+    s2 = sum(v * v for v in values)
+    n = len(values)
+    return (s * s) / (n * s2) if s2 > 0 else 0.0
+
+
+def load_intervals(path, offset=0.0):
+    """
+    iperf3 JSON 의 intervals 를 [(절대 시작, 절대 끝, bps), ...] 로 반환
+    offset: 실험 시작 기준 이 흐름의 시작 시각 (초)
+    """
+    try:
+        with open(path) as f:
+            data = json.load(f)
+    except (OSError, ValueError):
+        return []
+
+    series = []
+    for iv in data.get('intervals', []):
+        s = iv.get('sum', {})
+        if 'bits_per_second' not in s:
+            continue
+        series.append((offset + s['start'], offset + s['end'], s['bits_per_second']))
+    return series
+
+
+def rate_at(series, t):
+    """시각 t 에서의 처리량 (해당 구간이 없으면 None)"""
+    for start, end, bps in series:
+        if start <= t < end:
+            return bps
+    return None
+
+
+def _parse_rate(text):
+    """'1.2Gbps' 같은 ss 속도 문자열을 bps 로 변환"""
+    units = {'Tbps': 1e12, 'Gbps': 1e9, 'Mbps': 1e6, 'Kbps': 1e3, 'bps': 1}
+    for unit, scale in units.items():
+        if text.endswith(unit):
+            try:
+                return float(text[:-len(unit)]) * scale
+            except ValueError:
+                return None
+    return None
+
+
+def parse_ss_tcp_info(output):
+    """
+    `ss -tin` 출력을 소켓별 dict 리스트로 변환
+    예: {'local': '10.0.0.1:40000', 'peer': '10.0.0.2:5201', 'cc': 'reno_custom',
+         'cwnd': 10, 'ssthresh': 7, 'rtt_ms': 20.1, 'delivery_rate_bps': 1e9,
+         'bbr_bw_bps': 8e8, 'bbr_mrtt_ms': 20.0, ...}
+    """
+    sockets = []
+    cur = None
+    for line in output.splitlines():
+        if not line.strip():
+            continue
+        if not line[0].isspace():
+            fields = line.split()
+            # State Recv-Q Send-Q Local Peer
+            # `state ...` 필터를 주면 ss 가 State 열을 빼므로 Recv-Q(숫자)로 시작
+            if not fields or fields[0] in ('State', 'Recv-Q'):
+                cur = None
+                continue
+            off = 0 if fields[0].isdigit() else 1
+            if len(fields) >= 4 + off:
+                cur = {'state': fields[0] if off else None,
+                       'local': fields[2 + off], 'peer': fields[3 + off]}
+                sockets.append(cur)
+            else:
+                cur = None
+            continue
+        if cur is None:
+            continue
+
+        tokens = line.split()
+        i = 0
+        while i < len(tokens):
+            tok = tokens[i]
+            if i == 0 and ':' not in tok:
+                cur['cc'] = tok
+            elif tok.startswith('rtt:'):
+                rtt, _, rttvar = tok[4:].partition('/')
+                cur['rtt_ms'] = float(rtt)
+                cur['rttvar_ms'] = float(rttvar or 0)
+            elif tok.startswith('minrtt:'):
+                cur['minrtt_ms'] = float(tok[7:])
+            elif tok.split(':')[0] in ('cwnd', 'ssthresh', 'retrans', 'lost',
+                                       'unacked', 'bytes_acked', 'bytes_sent',
+                                       'delivered', 'mss'):
+                key, _, val = tok.partition(':')
+                # retrans:0/5 → 누적값(5)
+                val = val.split('/')[-1]
+                try:
+                    cur[key] = int(val)
+                except ValueError:
+                    pass
+            elif tok.startswith('bbr:('):
+                # BBR 형식 혼잡 제어 정보 (reno_custom 은 get_info 로 BWE 를 이 형식으로 보고)
+                # bbr:(bw:12.3Mbps,mrtt:10.2,pacing_gain:1,cwnd_gain:2)
+                for item in tok[5:].rstrip(')').split(','):
+                    key, _, val = item.partition(':')
+                    if key == 'bw':
+                        cur['bbr_bw_bps'] = _parse_rate(val)
+                    elif key in ('mrtt', 'pacing_gain', 'cwnd_gain'):
+                        try:
+                            cur['bbr_' + key + ('_ms' if key == 'mrtt' else '')] = float(val)
+                        except ValueError:
+                            pass
+            elif tok in ('send', 'pacing_rate', 'delivery_rate') and i + 1 < len(tokens):
+                cur[f'{tok}_bps'] = _parse_rate(tokens[i + 1])
+                i += 1
+            i += 1
+    return sockets
+
+
+def intf_tx_bytes(name):
+    """인터페이스 송신 바이트 (OVS 스위치 포트는 루트 네임스페이스에 있음)"""
+    try:
+        with open(f'/sys/class/net/{name}/statistics/tx_bytes') as f:
+            return int(f.read())
+    except (OSError, ValueError):
+        return 0
+
+
+def snapshot_hops(hops):
+    """hops: [(이름, 인터페이스, 용량 Mbit/s), ...] → {인터페이스: tx_bytes}"""
+    return {intf: intf_tx_bytes(intf) for _, intf, _ in hops}
+
+
+def hop_utilization(hops, before, after, seconds):
+    """두 스냅샷 사이 홉별 [(이름, Mbit/s, 이용률), ...]"""
+    result = []
+    for label, intf, cap_mbps in hops:
+        mbps = (after[intf] - before[intf]) * 8 / seconds / 1e6 if seconds > 0 else 0.0
+        result.append((label, mbps, mbps / cap_mbps if cap_mbps else 0.0))
+    return result
+
+
+def host_tcp_counters(host, names=('TcpExtTCPTimeouts', 'TcpRetransSegs')):
+    """호스트(네임스페이스) 누적 TCP 카운터 {이름: 값}, nstat 기록 파일은 건드리지 않음"""
+    out = host.cmd(f"nstat -asz {' '.join(names)}")
+    counters = dict.fromkeys(names, 0)
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0] in counters:
+            counters[parts[0]] = int(parts[1])
+    return counters
+
+
+def load_corpus(path=CORPUS_FILE):
+    """코퍼스 항목 [{'name', 'description', 'params', 'gap', ...}, ...] (없으면 빈 리스트)"""
+    try:
+        with open(path) as f:
+            return json.load(f).get('scenarios', [])
+    except (OSError, ValueError):
+        return []
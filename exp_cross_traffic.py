@@ -0,0 +1,171 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import time
+
+from exp_common import load_intervals
+from calibration import calibrate
+from live_dashboard import LiveFeed, link_queue
+
+# 벌크 iperf3 흐름 + xtraffic 배경 트래픽 (CBR / Pareto on-off UDP / Poisson TCP mice)
+#   h2..h6 (벌크), h7 (교차 트래픽) ── s1 ══ 병목 ══ h1
+# 교차 트래픽이 쓰고 남은 용량을 벌크 흐름이 얼마나 따라가는지 측정
+BOTTLENECK_BW = 100       # Mbit/s
+INTERVAL = 0.5            # 집계 구간 (초)
+SINK_PORT = 6000
+
+# 모드별 xtraffic 명령 (여러 개면 동시에 실행)
+CROSS_MODES = {
+    'cbr':   ["cbr {ip} {port} -r 30 -i 1"],
+    'onoff': ["onoff {ip} {port} -r 50 -o 1000 -f 1000 -i 2"],
+    'mice':  ["mice {ip} {port} -A 30 -z 100000"],
+}
+CROSS_MODES['mix'] = [CROSS_MODES['cbr'][0].replace('-r 30', '-r 15'),
+                      CROSS_MODES['onoff'][0].replace('-r 50', '-r 30'),
+                      CROSS_MODES['mice'][0]]
+
+
+class CrossTrafficTopo(Topo):
+    def build(self):
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, 8)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        # 병목은 서버 링크 하나, 접속 링크는 충분히 넓게
+        self.addLink(server, s1, cls=TCLink, bw=BOTTLENECK_BW, delay='10ms')
+        for h in clients:
+            self.addLink(h, s1, cls=TCLink, bw=1000, delay='1ms')
+
+
+def load_cross_log(path, offset):
+    """xtraffic 송신 로그의 구간 행 → [(절대 시작, 절대 끝, bps), ...]"""
+    series = []
+    prev = 0.0
+    try:
+        with open(path) as f:
+            for line in f:
+                parts = line.strip().split(',')
+                if parts[0] != 'ival':
+                    continue
+                t = int(parts[1]) / 1000.0
+                series.append((offset + prev, offset + t, float(parts[4]) * 1e6))
+                prev = t
+    except OSError:
+        pass
+    return series
+
+
+def mean_rate(series, start, end):
+    """[start, end) 와 겹치는 구간의 시간 가중 평균 bps"""
+    total = covered = 0.0
+    for s, e, bps in series:
+        lo, hi = max(s, start), min(e, end)
+        if hi > lo:
+            total += bps * (hi - lo)
+            covered += hi - lo
+    return total / covered if covered > 0 else 0.0
+
+
+def runExperiment(cc_algo='reno', duration=30, mode='mix'):
+    topo = CrossTrafficTopo()
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, 7)]
+    cross = net.get('h7')
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+
+    server_ip = server.IP()
+
+    calibrate(net, [(clients[0], server)])
+
+    info("*** Kill old iperf3 servers (if any)\n")
+    server.cmd("pkill iperf3; pkill xtraffic")
+
+    info("*** Start 5 iperf3 servers + xtraffic sink on h1\n")
+    for i in range(5):
+        port = 5201 + i
+        server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+    server.cmd(f"./xtraffic sink {SINK_PORT} -l /tmp/xtraffic_sink_{cc_algo}.csv "
+               f"> /tmp/xtraffic_sink.log 2>&1 &")
+
+    time.sleep(1)
+
+    t0 = time.time()
+    info(f"*** Start cross traffic ({mode}) on h7\n")
+    cross_logs = []
+    for k, tmpl in enumerate(CROSS_MODES[mode]):
+        logFile = f"/tmp/xtraffic_{mode}{k}_{cc_algo}.csv"
+        args = tmpl.format(ip=server_ip, port=SINK_PORT)
+        cross.cmd(f"./xtraffic {args} -t {duration} -S {k + 1} -L {INTERVAL * 1000:.0f} "
+                  f"-l {logFile} 2>> /tmp/xtraffic_send.log &")
+        cross_logs.append((time.time() - t0, logFile))
+
+    info("*** Start 5 concurrent iperf3 clients (h2~h6)\n")
+    flows = []
+    for i, c in enumerate(clients):
+        port = 5201 + i
+        host_num = i + 2
+        logFile = f"/tmp/iperf3_h{host_num}_{cc_algo}.json"
+        c.cmd(f"iperf3 -J -i {INTERVAL} -c {server_ip} -p {port} -t {duration} > {logFile} &")
+        info(f"h{host_num}: iperf3 -c {server_ip}:{port}\n")
+        flows.append((time.time() - t0, logFile))
+
+    live = LiveFeed(clients + [cross], [link_queue(net, 's1', 'h1')])
+    live.start()
+    info(f"*** Running {duration} seconds...\n")
+    time.sleep(duration + 3)
+    live.stop()
+    server.cmd("pkill -INT xtraffic")
+
+    report_adaptation(flows, cross_logs, duration, mode, cc_algo)
+
+    info("*** iperf3 finished. You can now run the analyzer script.\n")
+    CLI(net)
+    net.stop()
+
+
+def report_adaptation(flows, cross_logs, duration, mode, cc_algo):
+    """
+    구간별 잔여 용량(병목 - 교차 트래픽 실제 송신량) 대비 벌크 합계 처리량
+    on-off 처럼 교차 트래픽이 변하면 잔여 용량이 바뀌는 구간의 추종 정도가 드러남
+    """
+    bulk = [load_intervals(path, off) for off, path in flows]
+    cross = [load_cross_log(path, off) for off, path in cross_logs]
+    cap = BOTTLENECK_BW * 1e6
+
+    ratios, utils = [], []
+    t = 1.0   # 첫 구간(연결 설정) 제외
+    while t + INTERVAL <= duration:
+        b = sum(mean_rate(s, t, t + INTERVAL) for s in bulk)
+        x = sum(mean_rate(s, t, t + INTERVAL) for s in cross)
+        residual = max(cap - x, cap * 0.05)
+        ratios.append(min(b / residual, 1.5))
+        utils.append((b + x) / cap)
+        t += INTERVAL
+
+    info(f"\n=== Cross traffic adaptation ({mode}, {cc_algo}) ===\n")
+    if not ratios:
+        info("no samples\n")
+        return
+    cross_mean = sum(mean_rate(s, 0, duration) for s in cross) / 1e6
+    info(f"Cross traffic sent:      {cross_mean:.1f} Mbit/s (mean)\n")
+    info(f"Bulk / residual (mean):  {sum(ratios) / len(ratios) * 100:.1f}%\n")
+    info(f"Bulk / residual (min):   {min(ratios) * 100:.1f}%\n")
+    info(f"Link utilization (mean): {sum(utils) / len(utils) * 100:.1f}%\n")
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    mode = sys.argv[2] if len(sys.argv) > 2 else 'mix'
+    runExperiment(cc_algo, duration=10, mode=mode)
@@ -0,0 +1,129 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import time
+
+from exp_common import snapshot_hops, hop_utilization
+from calibration import calibrate
+from live_dashboard import LiveFeed
+
+# 덤벨: 병목은 s1 ↔ s2 링크 하나, 접속 링크는 충분히 넓고 짧게
+#   h2..h6 ─┐                    ┌─ h1 (서버)
+#           s1 ══ 병목 ══ s2 ────┤
+#           │                    └─ h7, h8 (역방향 송신)
+# 역방향 흐름(h7,h8 → h2,h3)이 s2→s1 큐를 채워 정방향 ACK 가 혼잡 큐를 지나게 함
+BOTTLENECK_BW = 100       # Mbit/s
+BOTTLENECK_DELAY = '10ms'
+ACCESS_BW = 1000
+ACCESS_DELAY = '1ms'
+QUEUE_PKTS = 500
+REVERSE_FLOWS = 2
+WARMUP = 2                # 이용률 측정 시작 전 대기 (초)
+
+
+class DumbbellTopo(Topo):
+    def build(self):
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, 7)]
+        rev = [self.addHost(f'h{i}', cls=Host) for i in range(7, 7 + REVERSE_FLOWS)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+        s2 = self.addSwitch('s2', cls=OVSKernelSwitch)
+
+        access = dict(cls=TCLink, bw=ACCESS_BW, delay=ACCESS_DELAY)
+        for h in clients:
+            self.addLink(h, s1, **access)
+        self.addLink(server, s2, **access)
+        for h in rev:
+            self.addLink(h, s2, **access)
+
+        # 병목 (양방향 모두 같은 용량, 지연, 큐)
+        self.addLink(s1, s2, cls=TCLink, bw=BOTTLENECK_BW, delay=BOTTLENECK_DELAY,
+                     max_queue_size=QUEUE_PKTS)
+
+
+def runExperiment(cc_algo='reno', duration=30):
+    topo = DumbbellTopo()
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, 7)]
+    rev = [net.get(f'h{i}') for i in range(7, 7 + REVERSE_FLOWS)]
+    s1, s2 = net.get('s1'), net.get('s2')
+
+    link = net.linksBetween(s1, s2)[0]
+    fwd_intf, rev_intf = (link.intf1, link.intf2) if link.intf1.node == s1 else (link.intf2, link.intf1)
+    hops = [('s1->s2', fwd_intf.name, BOTTLENECK_BW),
+            ('s2->s1', rev_intf.name, BOTTLENECK_BW)]
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+
+    server_ip = server.IP()
+
+    calibrate(net, [(clients[0], server), (rev[0], clients[0])])
+
+    info("*** Kill old iperf3 servers (if any)\n")
+    for h in net.hosts:
+        h.cmd("pkill iperf3")
+
+    info("*** Start 5 iperf3 servers on h1 (ports 5201~5205)\n")
+    for i in range(5):
+        port = 5201 + i
+        server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+    # 역방향 수신: h2, h3 ...
+    for i in range(REVERSE_FLOWS):
+        clients[i].cmd(f"iperf3 -s -p 5301 > /tmp/iperf3_s_rev_{i}.log 2>&1 &")
+
+    time.sleep(1)
+
+    info("*** Start 5 forward iperf3 clients (h2~h6 -> h1)\n")
+    for i, c in enumerate(clients):
+        port = 5201 + i
+        host_num = i + 2
+        logFile = f"/tmp/iperf3_h{host_num}_{cc_algo}.json"
+        c.cmd(f"iperf3 -J -c {server_ip} -p {port} -t {duration} > {logFile} &")
+        info(f"h{host_num}: iperf3 -c {server_ip}:{port}\n")
+
+    info(f"*** Start {REVERSE_FLOWS} reverse iperf3 flows\n")
+    for i, r in enumerate(rev):
+        dst = clients[i]
+        logFile = f"/tmp/iperf3_rev_{r.name}_{cc_algo}.json"
+        r.cmd(f"iperf3 -J -c {dst.IP()} -p 5301 -t {duration} > {logFile} &")
+        info(f"{r.name}: iperf3 -c {dst.IP()}:5301 (reverse)\n")
+
+    live = LiveFeed(clients + rev, [(label, s1 if label == 's1->s2' else s2, name)
+                                    for label, name, _ in hops])
+    live.start()
+    time.sleep(WARMUP)
+    before = snapshot_hops(hops)
+    t0 = time.time()
+    time.sleep(duration - WARMUP - 1)
+    after = snapshot_hops(hops)
+    report_utilization(hops, before, after, time.time() - t0)
+
+    time.sleep(4)
+    live.stop()
+
+    info("*** iperf3 finished. You can now run the analyzer script.\n")
+    CLI(net)
+    net.stop()
+
+
+def report_utilization(hops, before, after, seconds):
+    info("\n=== Per-hop utilization ===\n")
+    info("Hop\t\tMbit/s\tUtil\n")
+    for label, mbps, util in hop_utilization(hops, before, after, seconds):
+        info(f"{label}\t\t{mbps:.1f}\t{util * 100:.1f}%\n")
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    runExperiment(cc_algo, duration=10)
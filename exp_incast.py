@@ -0,0 +1,169 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import json
+import os
+import shutil
+import time
+
+from exp_common import host_tcp_counters, set_module_param, get_module_param, module_stats
+from calibration import calibrate
+from live_dashboard import LiveFeed, link_queue
+
+# 데이터센터 incast: 서버 여러 대가 한 집계 클라이언트에 동시에 응답 (partition/aggregate)
+#   h2..h{N+1} (응답 서버, app_workload.py server) ── s1 ══ 얕은 버퍼 포트 ══ h1 (집계)
+# 모든 링크 1 Gbit/s, 링크 지연 25us → 기본 RTT ~100us
+# 응답이 s1→h1 포트 버퍼에서 한꺼번에 넘치면 꼬리 패킷 손실이 RTO 로 이어져 QCT 가 폭증
+# fan-in 을 1, 2, 4, ... N 으로 늘려 가며 단계별 QCT 분위수 / RTO / goodput 을 기록하고
+# goodput 이 앞 단계 최대치의 절반 아래로 떨어지는 첫 fan-in 을 붕괴 지점으로 보고
+# gradient=1 이면 reno_custom 의 지연 기울기 모드(delay_gradient)를 켜고 단계별 감소 횟수도 기록
+#   (ECN 없는 µs RTT 패브릭 평가: 링크 지연을 5us 등으로 줄이면 기본 RTT 가 100us 아래)
+LINK_BW = 1000            # Mbit/s
+LINK_DELAY = '25us'
+QUEUE_PKTS = 32           # s1→h1 포트 버퍼 (얕은 ToR 버퍼, 약 48KB)
+PORT = 7000
+FANIN = 32                # 최대 응답 서버 수
+RESP_KB = 64              # 서버당 응답 크기
+QPS = 50                  # 초당 질의 수 (질의는 한 번에 하나)
+COLLAPSE = 0.5            # goodput 이 앞 단계 최대치의 이 비율 아래면 붕괴
+
+
+class IncastTopo(Topo):
+    def build(self, fanin=FANIN, delay=LINK_DELAY):
+        client = self.addHost('h1', cls=Host)
+        servers = [self.addHost(f'h{i}', cls=Host) for i in range(2, fanin + 2)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        self.addLink(client, s1, cls=TCLink, bw=LINK_BW, delay=delay,
+                     max_queue_size=QUEUE_PKTS)
+        for h in servers:
+            self.addLink(h, s1, cls=TCLink, bw=LINK_BW, delay=delay)
+
+
+def fanin_levels(fanin):
+    """1, 2, 4, ... 와 마지막으로 fanin"""
+    levels, k = [], 1
+    while k < fanin:
+        levels.append(k)
+        k *= 2
+    return levels + [fanin]
+
+
+def _pct(values, p):
+    v = sorted(values)
+    return v[min(len(v) - 1, int(p * len(v)))] if v else 0.0
+
+
+def runExperiment(cc_algo='reno', duration=3, fanin=FANIN, resp_kb=RESP_KB, qps=QPS,
+                  link_delay=LINK_DELAY, gradient=False):
+    """duration: fan-in 단계당 시간 (초)"""
+    topo = IncastTopo(fanin=fanin, delay=link_delay)
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    client = net.get('h1')
+    servers = [net.get(f'h{i}') for i in range(2, fanin + 2)]
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+
+    # 실험 중 예외가 나도 delay_gradient 는 실험 전 값으로 되돌림
+    old_gradient = get_module_param('delay_gradient')
+    try:
+        if gradient:
+            info("*** reno_custom delay_gradient=1\n")
+            set_module_param('delay_gradient', True)
+
+        calibrate(net, [(servers[0], client)])
+
+        info(f"*** Start response servers on h2~h{fanin + 1} (port {PORT})\n")
+        for s in servers:
+            s.cmd("pkill -f app_workload.py")
+            s.cmd(f"python3 app_workload.py server {PORT} > /dev/null 2>&1 &")
+        time.sleep(1)
+
+        live = LiveFeed(servers, [link_queue(net, 's1', 'h1')])
+        live.start()
+
+        resp = resp_kb * 1024
+        results = []
+        for k in fanin_levels(fanin):
+            ips = ','.join(s.IP() for s in servers[:k])
+            before = [host_tcp_counters(s) for s in servers[:k]]
+            m0 = module_stats()
+            logFile = f"/tmp/incast_{k}_{cc_algo}.json"
+            info(f"*** fan-in {k}: {resp_kb}KB x {k} per query, {qps} qps, {duration}s\n")
+            client.cmd(f"python3 app_workload.py incast {ips} {PORT} {resp} {qps} {duration} {logFile}")
+            after = [host_tcp_counters(s) for s in servers[:k]]
+            m1 = module_stats()
+
+            rto = sum(a['TcpExtTCPTimeouts'] - b['TcpExtTCPTimeouts'] for a, b in zip(after, before))
+            retx = sum(a['TcpRetransSegs'] - b['TcpRetransSegs'] for a, b in zip(after, before))
+            try:
+                with open(logFile) as f:
+                    data = json.load(f)
+            except (OSError, ValueError):
+                data = {}
+            results.append({'fanin': k, 'rto': rto, 'retrans': retx,
+                            'grad_cuts': m1.get('grad_reductions', 0) - m0.get('grad_reductions', 0),
+                            'goodput_bps': data.get('end', {}).get('sum_received', {}).get('bits_per_second', 0.0),
+                            'qct': [q['qct'] for q in data.get('queries', [])]})
+        live.stop()
+    finally:
+        if gradient and old_gradient is not None:
+            set_module_param('delay_gradient', 1 if old_gradient in ('1', 'Y') else 0)
+
+    # 최대 fan-in 단계를 분석 스크립트용 iperf3 형식 로그로도 남김
+    # (클라이언트가 실패해 로그가 없어도 net.stop() 까지는 가야 함)
+    last_log = f"/tmp/incast_{fanin}_{cc_algo}.json"
+    if os.path.exists(last_log):
+        shutil.copy(last_log, f"/tmp/iperf3_h1_{cc_algo}.json")
+    else:
+        info(f"!! {last_log} missing, skipping iperf3-format copy\n")
+    with open(f"/tmp/incast_summary_{cc_algo}.json", 'w') as f:
+        json.dump(results, f)
+    report(results, cc_algo + ('+gradient' if gradient else ''), resp_kb, qps)
+
+    for s in servers:
+        s.cmd("pkill -f app_workload.py")
+    info(f"*** Finished. Per-level results saved to /tmp/incast_summary_{cc_algo}.json\n")
+    CLI(net)
+    net.stop()
+
+
+def report(results, cc_algo, resp_kb, qps):
+    info(f"\n=== Incast ({cc_algo}, {resp_kb}KB per server, {qps} qps) ===\n")
+    info("Fan-in\tQueries\tQCT p50\tp99\tp99.9\tmax\tRTOs\tRetrans\tGradCut\tGoodput\n")
+    best, collapse = 0.0, None
+    for r in results:
+        q = r['qct']
+        info(f"{r['fanin']}\t{len(q)}\t{_pct(q, 0.5) * 1e3:.2f}ms\t{_pct(q, 0.99) * 1e3:.2f}ms\t"
+             f"{_pct(q, 0.999) * 1e3:.2f}ms\t{max(q, default=0) * 1e3:.2f}ms\t"
+             f"{r['rto']}\t{r['retrans']}\t{r.get('grad_cuts', 0)}\t{r['goodput_bps'] / 1e6:.1f}M\n")
+        if collapse is None and best > 0 and r['goodput_bps'] < best * COLLAPSE:
+            collapse = r['fanin']
+        best = max(best, r['goodput_bps'])
+    if collapse:
+        info(f"!! goodput collapse at fan-in {collapse} (< {COLLAPSE:.0%} of best {best / 1e6:.1f}M)\n")
+    else:
+        info("no goodput collapse within tested fan-in\n")
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    fanin = int(sys.argv[2]) if len(sys.argv) > 2 else FANIN
+    resp_kb = int(sys.argv[3]) if len(sys.argv) > 3 else RESP_KB
+    qps = float(sys.argv[4]) if len(sys.argv) > 4 else QPS
+    # exp_incast.py <cc> [fanin] [resp_kb] [qps] [link_delay] [gradient]
+    #   예: exp_incast.py reno_custom 32 64 50 5us 1  (기본 RTT ~20us, 지연 기울기 모드)
+    link_delay = sys.argv[5] if len(sys.argv) > 5 else LINK_DELAY
+    gradient = len(sys.argv) > 6 and sys.argv[6] not in ('0', 'off')
+    runExperiment(cc_algo, duration=3, fanin=fanin, resp_kb=resp_kb, qps=qps,
+                  link_delay=link_delay, gradient=gradient)
@@ -0,0 +1,276 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink, Link
+from mininet.log import setLogLevel, info
+import json
+import signal
+import struct
+import subprocess
+import time
+
+from exp_common import parse_ss_tcp_info, intf_tx_bytes, module_stats
+from calibration import calibrate
+from live_dashboard import LiveFeed
+
+# L4S 병목: 얕은 step 표시 AQM 에서 reno_l4s 의 큐 지연 / 이용률 측정
+#   h2..h6 ── s1 ──(htb 100M + fq_codel)── h1
+# 큐 모드
+#   step:     fq_codel ce_threshold 1ms (sojourn 1ms 넘으면 ECT 패킷에 CE, L4S 식 즉시 표시)
+#   classic:  fq_codel 기본 ECN (target 5ms, CoDel 제어 법칙) → reno_l4s 의 classic 전환 확인
+#   droptail: pfifo, ECN 표시 없음 (손실만)
+# DualPI2 는 ECT(1) 로 L4S 트래픽을 분류하는데 classic ECN 협상(ECT(0))만 쓰는 이 테스트베드에서는
+# L4S 큐로 들어가지 않으므로 step 표시 fq_codel 로 대신함
+# 측정: 병목 큐의 패킷별 체류 시간 분위수, 병목 이용률, CE 표시/드롭 수,
+#       /proc/net/reno_custom 의 CE 감소 / classic 전환 횟수
+#   체류 시간: s1 의 클라이언트 쪽 포트(수신)와 병목 포트(송신, qdisc 를 나온 뒤)를 tcpdump 로
+#   나노초 타임스탬프 캡처 → (출발 포트, seq) 로 같은 패킷을 짝지어 차이 (OVS 전달 µs 포함)
+#   ss rtt 는 1/8 EWMA 인 srtt 를 50ms 마다 본 값이라 꼬리를 숨기므로 참고용(srtt_qdelay_ms)으로만
+BOTTLENECK_BW = 100       # Mbit/s
+ACCESS_DELAY = '2ms'      # 기본 RTT 약 4ms
+CE_THRESHOLD = '1ms'
+SAMPLE = 0.05             # ss 샘플 간격 (초)
+WARMUP = 3                # slow start 제외 (초)
+SNAPLEN = 96              # 헤더만 캡처
+PCAP_NSEC_MAGIC = 0xa1b23c4d
+
+
+class L4STopo(Topo):
+    def build(self):
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, 7)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        # 병목 큐는 tc 로 직접 설정
+        self.addLink(server, s1, cls=Link)
+        for h in clients:
+            self.addLink(h, s1, cls=TCLink, bw=1000, delay=ACCESS_DELAY)
+
+
+def setup_aqm(intf, mode, rate_mbps):
+    """s1 → h1 송신 인터페이스: htb 속도 제한 + 모드별 큐"""
+    subprocess.run(['tc', 'qdisc', 'del', 'dev', intf, 'root'],
+                   stderr=subprocess.DEVNULL)
+    subprocess.run(['tc', 'qdisc', 'add', 'dev', intf, 'root', 'handle', '1:',
+                    'htb', 'default', '1'], check=True)
+    subprocess.run(['tc', 'class', 'add', 'dev', intf, 'parent', '1:', 'classid', '1:1',
+                    'htb', 'rate', f'{rate_mbps}mbit'], check=True)
+    if mode == 'step':
+        leaf = ['fq_codel', 'ecn', 'ce_threshold', CE_THRESHOLD]
+    elif mode == 'classic':
+        leaf = ['fq_codel', 'ecn']
+    else:
+        leaf = ['pfifo', 'limit', '1000']
+    subprocess.run(['tc', 'qdisc', 'add', 'dev', intf, 'parent', '1:1', 'handle', '10:']
+                   + leaf, check=True)
+
+
+def leaf_stats(intf):
+    """하위 큐의 {'ce_mark': n, 'drops': n}"""
+    out = subprocess.run(['tc', '-s', '-j', 'qdisc', 'show', 'dev', intf],
+                         capture_output=True, text=True).stdout
+    try:
+        for q in json.loads(out):
+            if q.get('handle') == '10:':
+                return {'ce_mark': q.get('options', {}).get('ce_mark', q.get('ce_mark', 0)),
+                        'drops': q.get('drops', 0)}
+    except ValueError:
+        pass
+    return {'ce_mark': 0, 'drops': 0}
+
+
+def start_capture(intf, path, server_ip):
+    """intf 에서 h1 로 가는 TCP 를 나노초 타임스탬프로 캡처 (루트 네임스페이스, s1 포트)"""
+    return subprocess.Popen(['tcpdump', '-i', intf, '-n', '-s', str(SNAPLEN), '-B', '16384',
+                             '--time-stamp-precision=nano', '-w', path,
+                             f'tcp and dst host {server_ip}'],
+                            stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+
+
+def stop_capture(proc):
+    """캡처 종료, 커널이 버린 패킷 수 (모르면 0)"""
+    proc.send_signal(signal.SIGINT)
+    err = proc.communicate()[1] or ''
+    for line in err.splitlines():
+        if 'dropped by kernel' in line:
+            return int(line.split()[0])
+    return 0
+
+
+def read_pcap(path):
+    """이더넷 pcap → [(시각 ns, (출발 포트, seq)), ...], 페이로드 있는 IPv4 TCP 만"""
+    out = []
+    try:
+        with open(path, 'rb') as f:
+            data = f.read()
+    except OSError:
+        return out
+    if len(data) < 24 or struct.unpack_from('<I', data)[0] != PCAP_NSEC_MAGIC:
+        return out
+    off = 24
+    while off + 16 <= len(data):
+        sec, nsec, incl, orig = struct.unpack_from('<IIII', data, off)
+        pkt = data[off + 16:off + 16 + incl]
+        off += 16 + incl
+        if len(pkt) < 14 + 20 + 20 or pkt[12:14] != b'\x08\x00':
+            continue
+        ihl = (pkt[14] & 0x0f) * 4
+        ip_len = struct.unpack_from('>H', pkt, 16)[0]
+        tcp = 14 + ihl
+        if len(pkt) < tcp + 20:
+            continue
+        sport, _, seq = struct.unpack_from('>HHI', pkt, tcp)
+        if ip_len - ihl - (pkt[tcp + 12] >> 4) * 4 <= 0:
+            continue
+        out.append((sec * 1_000_000_000 + nsec, (sport, seq)))
+    return out
+
+
+def sojourn_ms(ingress_paths, egress_path):
+    """같은 패킷의 병목 포트 송신 시각 - s1 수신 시각 (ms). 재전송처럼 키가 겹치는 패킷은 제외"""
+    arrive, dup = {}, set()
+    for path in ingress_paths:
+        for t, key in read_pcap(path):
+            if key in arrive:
+                dup.add(key)
+            arrive[key] = t
+    out, seen = [], set()
+    for t, key in read_pcap(egress_path):
+        if key in dup or key in seen or key not in arrive:
+            continue
+        seen.add(key)
+        if t >= arrive[key]:
+            out.append((t - arrive[key]) / 1e6)
+    return out
+
+
+def _pct(values, p):
+    v = sorted(values)
+    return v[min(len(v) - 1, int(p * len(v)))] if v else 0.0
+
+
+def runExperiment(cc_algo='reno_l4s', duration=20, mode='step'):
+    topo = L4STopo()
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, 7)]
+    s1 = net.get('s1')
+
+    link = net.linksBetween(server, s1)[0]
+    intf = (link.intf1 if link.intf1.node == s1 else link.intf2).name
+    info(f"*** {mode} queue, {BOTTLENECK_BW} Mbit/s on {intf}\n")
+    setup_aqm(intf, mode, BOTTLENECK_BW)
+
+    info(f"*** Set TCP CC to {cc_algo}, ECN on\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+        h.cmd("sysctl -w net.ipv4.tcp_ecn=1 > /dev/null")
+
+    server_ip = server.IP()
+
+    calibrate(net, [(clients[0], server)], limits={intf: {'bw': BOTTLENECK_BW}})
+
+    info("*** Kill old iperf3 servers (if any)\n")
+    server.cmd("pkill iperf3")
+
+    info("*** Start 5 iperf3 servers on h1 (ports 5201~5205)\n")
+    for i in range(5):
+        port = 5201 + i
+        server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+
+    time.sleep(1)
+
+    info("*** Start 5 concurrent iperf3 clients (h2~h6)\n")
+    for i, c in enumerate(clients):
+        port = 5201 + i
+        logFile = f"/tmp/iperf3_h{i + 2}_{cc_algo}.json"
+        c.cmd(f"iperf3 -J -c {server_ip} -p {port} -t {duration} > {logFile} &")
+
+    live = LiveFeed(clients, [('s1->h1', s1, intf)])
+    live.start()
+    time.sleep(WARMUP)
+
+    # 병목 큐 앞(s1 의 클라이언트 쪽 포트 수신)과 뒤(병목 포트 송신)에서 캡처
+    ingress = [(l.intf1 if l.intf1.node == s1 else l.intf2).name
+               for c in clients for l in net.linksBetween(c, s1)]
+    caps = [(start_capture(name, f'/tmp/l4s_in_{name}.pcap', server_ip), f'/tmp/l4s_in_{name}.pcap')
+            for name in ingress]
+    caps.append((start_capture(intf, '/tmp/l4s_out.pcap', server_ip), '/tmp/l4s_out.pcap'))
+    time.sleep(0.5)
+
+    info(f"*** Capturing bottleneck sojourn, sampling srtt every {SAMPLE}s\n")
+    q0, m0, b0, t0 = leaf_stats(intf), module_stats(), intf_tx_bytes(intf), time.time()
+    rtts, base = [], None
+    while time.time() - t0 < duration - WARMUP - 1:
+        for i, c in enumerate(clients):
+            cmd = ['ss', '-tin', 'state', 'established', f'dport = :{5201 + i}']
+            text = c.popen(cmd, stdout=subprocess.PIPE, text=True).communicate()[0]
+            # 같은 포트의 iperf3 제어 연결은 거의 유휴라 RTT 가 큐 지연을 반영하지 않음 → 데이터 소켓만
+            socks = [s for s in parse_ss_tcp_info(text) if s.get('bytes_acked')]
+            if not socks:
+                continue
+            s = max(socks, key=lambda s: s['bytes_acked'])
+            if s.get('rtt_ms'):
+                rtts.append(s['rtt_ms'])
+            if s.get('minrtt_ms'):
+                base = min(base, s['minrtt_ms']) if base else s['minrtt_ms']
+        time.sleep(SAMPLE)
+    elapsed = time.time() - t0
+    q1, m1, b1 = leaf_stats(intf), module_stats(), intf_tx_bytes(intf)
+    cap_drops = sum(stop_capture(proc) for proc, _ in caps)
+    live.stop()
+    time.sleep(2)
+
+    util = (b1 - b0) * 8 / elapsed / (BOTTLENECK_BW * 1e6)
+    qdelay = sojourn_ms([path for _, path in caps[:-1]], caps[-1][1])
+    srtt_q = [max(r - base, 0.0) for r in rtts] if base else []
+    result = {
+        'mode': mode, 'cc': cc_algo, 'utilization': util, 'base_rtt_ms': base,
+        'samples': len(qdelay), 'capture_drops': cap_drops,
+        'qdelay_ms': {'p50': _pct(qdelay, 0.5), 'p90': _pct(qdelay, 0.9),
+                      'p99': _pct(qdelay, 0.99), 'max': max(qdelay, default=0.0)},
+        'srtt_qdelay_ms': {'p50': _pct(srtt_q, 0.5), 'p99': _pct(srtt_q, 0.99),
+                           'samples': len(srtt_q)},
+        'ce_marks': q1['ce_mark'] - q0['ce_mark'], 'drops': q1['drops'] - q0['drops'],
+        'module': {k: m1[k] - m0.get(k, 0) for k in m1 if k.startswith('l4s_')},
+    }
+    with open(f"/tmp/l4s_{mode}_{cc_algo}.json", 'w') as f:
+        json.dump(result, f, indent=1)
+    report(result)
+
+    info(f"*** Finished. Saved to /tmp/l4s_{mode}_{cc_algo}.json\n")
+    CLI(net)
+    net.stop()
+
+
+def report(r):
+    q, sq = r['qdelay_ms'], r['srtt_qdelay_ms']
+    info(f"\n=== L4S bottleneck: {r['mode']} ({r['cc']}) ===\n")
+    info(f"Utilization:        {r['utilization'] * 100:.1f}%\n")
+    info(f"Sojourn (ms):       p50 {q['p50']:.3f}, p90 {q['p90']:.3f}, p99 {q['p99']:.3f}, "
+         f"max {q['max']:.3f} ({r['samples']} packets, {r['capture_drops']} capture drops)\n")
+    info(f"srtt - base (ms):   p50 {sq['p50']:.3f}, p99 {sq['p99']:.3f} "
+         f"(smoothed, base RTT {r['base_rtt_ms'] or 0:.3f})\n")
+    info(f"CE marks / drops:   {r['ce_marks']} / {r['drops']}\n")
+    for k, v in r['module'].items():
+        info(f"{k + ':':<20}{v}\n")
+    if not r['samples']:
+        info("!! FAIL: no matched packets from the bottleneck capture (tcpdump?), "
+             "queue delay unknown\n")
+        return
+    ok = r['utilization'] >= 0.9 and q['p99'] < 1.0
+    info(f"{'OK' if ok else '!!'} sub-ms p99 per-packet sojourn at >=90% utilization: "
+         f"{'yes' if ok else 'no'}\n")
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    # exp_l4s.py <cc> [step|classic|droptail]
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno_l4s'
+    mode = sys.argv[2] if len(sys.argv) > 2 else 'step'
+    runExperiment(cc_algo, duration=20, mode=mode)
@@ -6,6 +6,8 @@ from mininet.link import TCLink
 from mininet.log import setLogLevel, info
 import time
 
+from calibration import calibrate
+
 class MultiFlowTopo(Topo):
     def build(self):
         # 서버 1개, 클라이언트 5개
@@ -39,6 +41,8 @@ def runExperiment(cc_algo='reno_bwe', duration=30):
 
     server_ip = server.IP()
 
+    calibrate(net, [(clients[0], server)])
+
     info("*** Kill old iperf3 servers (if any)\n")
     server.cmd("pkill iperf3")
 
@@ -2,10 +2,13 @@ from mininet.net import Mininet
 from mininet.topo import Topo
 from mininet.node import OVSKernelSwitch, Host
 from mininet.cli import CLI
-from mininet.link import TCLink
 from mininet.log import setLogLevel, info
 import time
 
+from calibration import calibrate
+from edt_link import link_cls, backend
+from live_dashboard import LiveFeed, link_queue
+
 class MultiFlowTopo(Topo):
     def build(self):
         # 서버 1개, 클라이언트 5개
@@ -14,8 +17,9 @@ class MultiFlowTopo(Topo):
         s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
 
         # 높은 bandwidth + 높은 latency 테스트
+        # netem 이 10 Gbit/s x 50ms 를 못 따라가므로 run_all_tests.py 는 EDT 백엔드로 실행 (edt_link.py)
         link_opts = dict(
-            cls=TCLink,
+            cls=link_cls(),
             bw=10000,       # 10 Gbit/s - 높은 대역폭 ⭐
             delay='50ms',   # 100ms RTT - 높은 지연 ⭐
             loss=0.1        # 0.1% 패킷 손실 (기본)
@@ -30,6 +34,7 @@ def runExperiment(cc_algo='reno', duration=30):
     topo = MultiFlowTopo()
     net = Mininet(topo=topo, autoSetMacs=True, build=True)
     net.start()
+    info(f"*** Link emulation backend: {backend()}\n")
 
     server = net.get('h1')
     clients = [net.get(f'h{i}') for i in range(2, 7)]
@@ -40,6 +45,8 @@ def runExperiment(cc_algo='reno', duration=30):
 
     server_ip = server.IP()
 
+    calibrate(net, [(clients[0], server)])
+
     info("*** Kill old iperf3 servers (if any)\n")
     server.cmd("pkill iperf3")
 
@@ -62,8 +69,11 @@ def runExperiment(cc_algo='reno', duration=30):
         c.cmd(cmd)
         time.sleep(0.2)
 
+    live = LiveFeed(clients, [link_queue(net, 's1', 'h1')])
+    live.start()
     info(f"*** Running {duration} seconds...\n")
     time.sleep(duration + 3)
+    live.stop()
 
     info("*** iperf3 finished. You can now run the analyzer script.\n")
     CLI(net)
@@ -6,6 +6,9 @@ from mininet.link import TCLink
 from mininet.log import setLogLevel, info
 import time
 
+from calibration import calibrate
+from live_dashboard import LiveFeed, link_queue
+
 class MultiFlowTopo(Topo):
     def build(self):
         # 서버 1개, 클라이언트 5개
@@ -40,6 +43,8 @@ def runExperiment(cc_algo='reno', duration=30):
 
     server_ip = server.IP()
 
+    calibrate(net, [(clients[0], server)])
+
     info("*** Kill old iperf3 servers (if any)\n")
     server.cmd("pkill iperf3")
 
@@ -62,8 +67,11 @@ def runExperiment(cc_algo='reno', duration=30):
         c.cmd(cmd)
         time.sleep(0.2)
 
+    live = LiveFeed(clients, [link_queue(net, 's1', 'h1')])
+    live.start()
     info(f"*** Running {duration} seconds...\n")
     time.sleep(duration + 3)
+    live.stop()
 
     info("*** iperf3 finished. You can now run the analyzer script.\n")
     CLI(net)
@@ -0,0 +1,110 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import json
+import time
+
+from exp_common import set_module_param, get_module_param
+
+# reno_custom 가중치(MulTCP) 모드 검증: 공통 병목에서 가중치 비율대로 대역폭을 나누는지 확인
+WEIGHT_MARK_DEFAULT = 0x52430000    # reno_custom 의 weight_mark 기본값 (모듈이 없을 때)
+
+
+class WeightedTopo(Topo):
+    def build(self, num_clients=4):
+        # 서버 1개, 클라이언트 num_clients개
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, num_clients + 2)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        # s1 ↔ h1 만 병목 (모든 흐름이 같은 큐를 공유)
+        self.addLink(server, s1, cls=TCLink, bw=100, delay='10ms')
+        for h in clients:
+            self.addLink(h, s1, cls=TCLink, bw=1000, delay='1ms')
+
+
+def runExperiment(cc_algo='reno_custom', weights=(1, 1, 2, 4), duration=30):
+    topo = WeightedTopo(num_clients=len(weights))
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, len(weights) + 2)]
+
+    # 실험 중 예외가 나도 모듈 설정은 실험 전 값으로 되돌림
+    prev_weighted = get_module_param('weighted')
+    try:
+        if cc_algo == 'reno_custom':
+            info("*** Enable reno_custom weighted mode\n")
+            set_module_param('weighted', 1)
+        mark_base = int(get_module_param('weight_mark') or WEIGHT_MARK_DEFAULT)
+
+        server.cmd("pkill -f prio_bulk.py")
+        server.cmd("python3 prio_bulk.py server 5201 > /tmp/prio_bulk_server.log 2>&1 &")
+        time.sleep(1)
+
+        # 가중치 = SO_MARK - weight_mark
+        info(f"*** Start {len(weights)} weighted flows {list(weights)}\n")
+        logs = []
+        for i, (c, w) in enumerate(zip(clients, weights)):
+            host_num = i + 2
+            logFile = f"/tmp/iperf3_h{host_num}_{cc_algo}.json"
+            cmd = (f"python3 prio_bulk.py client {server.IP()} 5201 {duration} "
+                   f"{mark_base + w} {cc_algo} {logFile} &")
+            info(f"h{host_num} (weight {w}): {cmd}\n")
+            c.cmd(cmd)
+            logs.append((host_num, w, logFile))
+
+        info(f"*** Running {duration} seconds...\n")
+        time.sleep(duration + 3)
+
+        report_shares(logs)
+    finally:
+        if cc_algo == 'reno_custom' and prev_weighted is not None:
+            set_module_param('weighted', 1 if prev_weighted in ('1', 'Y') else 0)
+
+    server.cmd("pkill -f prio_bulk.py")
+    CLI(net)
+    net.stop()
+
+
+def report_shares(logs):
+    """가중치 비율 대비 실제 점유율 비교"""
+    rates = []
+    for host_num, w, path in logs:
+        try:
+            with open(path) as f:
+                bps = json.load(f)["end"]["sum_sent"]["bits_per_second"]
+        except Exception:
+            bps = 0
+        rates.append((host_num, w, bps))
+
+    total_bps = sum(r[2] for r in rates)
+    total_w = sum(r[1] for r in rates)
+    if total_bps == 0:
+        info("*** No results\n")
+        return
+
+    base = min(rates, key=lambda r: r[1])
+    info("\nHost\tWeight\tMbps\tShare\tTarget\tRatio vs min-weight flow\n")
+    max_err = 0.0
+    for host_num, w, bps in rates:
+        share = bps / total_bps
+        target = w / total_w
+        ratio = bps / base[2] if base[2] > 0 else 0
+        max_err = max(max_err, abs(share - target) / target)
+        info(f"h{host_num}\t{w}\t{bps / 1e6:.1f}\t{share:.3f}\t{target:.3f}\t"
+             f"{ratio:.2f} (want {w / base[1]:.2f})\n")
+    info(f"Max relative share error: {max_err * 100:.1f} %\n")
+
+
+if __name__ == "__main__":
+    import sys
+
+    setLogLevel('info')
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno_custom'
+    weights = tuple(int(w) for w in sys.argv[2].split(',')) if len(sys.argv) > 2 else (1, 1, 2, 4)
+    runExperiment(cc_algo, weights=weights, duration=30)
@@ -0,0 +1,142 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import time
+
+from exp_common import snapshot_hops, hop_utilization
+from calibration import calibrate
+from live_dashboard import LiveFeed
+
+# 파킹랏: s1 ─ s2 ─ s3 ─ s4 각 홉이 병목
+#   긴 흐름   h2..h6 (s1) → h1 (s4)          : 모든 홉 통과
+#   교차 트래픽 c{k} (s_k) → d{k} (s_{k+1})  : 홉 k 에서만 경쟁
+#   역방향     r1 (s4) → h2 (s1)             : ACK 경로의 모든 홉에 데이터 큐
+NUM_HOPS = 3
+HOP_BW = 100              # Mbit/s
+HOP_DELAY = '5ms'
+ACCESS_BW = 1000
+ACCESS_DELAY = '1ms'
+QUEUE_PKTS = 300
+WARMUP = 2
+
+
+class ParkingLotTopo(Topo):
+    def build(self):
+        switches = [self.addSwitch(f's{k}', cls=OVSKernelSwitch)
+                    for k in range(1, NUM_HOPS + 2)]
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, 7)]
+
+        access = dict(cls=TCLink, bw=ACCESS_BW, delay=ACCESS_DELAY)
+        for h in clients:
+            self.addLink(h, switches[0], **access)
+        self.addLink(server, switches[-1], **access)
+
+        for k in range(1, NUM_HOPS + 1):
+            src = self.addHost(f'c{k}', cls=Host)
+            dst = self.addHost(f'd{k}', cls=Host)
+            self.addLink(src, switches[k - 1], **access)
+            self.addLink(dst, switches[k], **access)
+
+        self.addLink(self.addHost('r1', cls=Host), switches[-1], **access)
+
+        for k in range(NUM_HOPS):
+            self.addLink(switches[k], switches[k + 1], cls=TCLink, bw=HOP_BW,
+                         delay=HOP_DELAY, max_queue_size=QUEUE_PKTS)
+
+
+def hop_interfaces(net):
+    """[(이름, 인터페이스, 용량), ...] 정방향 홉 다음 역방향 홉"""
+    fwd, rev = [], []
+    for k in range(1, NUM_HOPS + 1):
+        a, b = net.get(f's{k}'), net.get(f's{k + 1}')
+        link = net.linksBetween(a, b)[0]
+        ia, ib = (link.intf1, link.intf2) if link.intf1.node == a else (link.intf2, link.intf1)
+        fwd.append((f's{k}->s{k + 1}', ia.name, HOP_BW))
+        rev.append((f's{k + 1}->s{k}', ib.name, HOP_BW))
+    return fwd + rev
+
+
+def runExperiment(cc_algo='reno', duration=30):
+    topo = ParkingLotTopo()
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, 7)]
+    hops = hop_interfaces(net)
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+
+    server_ip = server.IP()
+
+    calibrate(net, [(clients[0], server)] +
+              [(net.get(f'c{k}'), net.get(f'd{k}')) for k in range(1, NUM_HOPS + 1)])
+
+    info("*** Kill old iperf3 servers (if any)\n")
+    for h in net.hosts:
+        h.cmd("pkill iperf3")
+
+    info("*** Start iperf3 servers (h1: 5201~5205, d1..dN, h2 reverse)\n")
+    for i in range(5):
+        port = 5201 + i
+        server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+    for k in range(1, NUM_HOPS + 1):
+        net.get(f'd{k}').cmd(f"iperf3 -s -p 5301 > /tmp/iperf3_s_d{k}.log 2>&1 &")
+    clients[0].cmd("iperf3 -s -p 5401 > /tmp/iperf3_s_rev.log 2>&1 &")
+
+    time.sleep(1)
+
+    info("*** Start 5 long iperf3 flows (h2~h6 -> h1, all hops)\n")
+    for i, c in enumerate(clients):
+        port = 5201 + i
+        host_num = i + 2
+        logFile = f"/tmp/iperf3_h{host_num}_{cc_algo}.json"
+        c.cmd(f"iperf3 -J -c {server_ip} -p {port} -t {duration} > {logFile} &")
+        info(f"h{host_num}: iperf3 -c {server_ip}:{port}\n")
+
+    info(f"*** Start {NUM_HOPS} cross flows (one per hop) and 1 reverse flow\n")
+    for k in range(1, NUM_HOPS + 1):
+        src, dst = net.get(f'c{k}'), net.get(f'd{k}')
+        logFile = f"/tmp/iperf3_cross_c{k}_{cc_algo}.json"
+        src.cmd(f"iperf3 -J -c {dst.IP()} -p 5301 -t {duration} > {logFile} &")
+    net.get('r1').cmd(f"iperf3 -J -c {clients[0].IP()} -p 5401 -t {duration} "
+                      f"> /tmp/iperf3_rev_r1_{cc_algo}.json &")
+
+    senders = clients + [net.get(f'c{k}') for k in range(1, NUM_HOPS + 1)] + [net.get('r1')]
+    live = LiveFeed(senders, [(label, net.get(label.split('->')[0]), name)
+                              for label, name, _ in hops])
+    live.start()
+    time.sleep(WARMUP)
+    before = snapshot_hops(hops)
+    t0 = time.time()
+    time.sleep(duration - WARMUP - 1)
+    after = snapshot_hops(hops)
+    report_utilization(hops, before, after, time.time() - t0)
+
+    time.sleep(4)
+    live.stop()
+
+    info("*** iperf3 finished. You can now run the analyzer script.\n")
+    CLI(net)
+    net.stop()
+
+
+def report_utilization(hops, before, after, seconds):
+    info("\n=== Per-hop utilization ===\n")
+    info("Hop\t\tMbit/s\tUtil\n")
+    for label, mbps, util in hop_utilization(hops, before, after, seconds):
+        info(f"{label}\t\t{mbps:.1f}\t{util * 100:.1f}%\n")
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    runExperiment(cc_algo, duration=10)
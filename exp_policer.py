@@ -0,0 +1,251 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink, Link
+from mininet.log import setLogLevel, info
+import json
+import subprocess
+import threading
+import time
+
+from exp_common import set_module_param, get_module_param, intf_tx_bytes
+from calibration import calibrate
+from live_dashboard import LiveFeed
+
+# 토큰 버킷 폴리서(초과분 드롭) / 셰이퍼(tbf, 큐잉) 병목
+#   h2..h6 ── s1 ──(police | tbf)── h1
+# 측정: 정책 속도 대비 goodput 효율, 손실 버스트 길이, 버스트 후 회복 시간
+RATE_MBPS = 50
+BURST_KB = 64             # 토큰 버킷 크기
+TBF_LATENCY = '50ms'      # 셰이퍼 큐 한도 (지연 기준)
+ACCESS_DELAY = '10ms'     # 클라이언트 접속 링크 (RTT 약 20ms)
+SAMPLE = 0.02             # 드롭 카운터 / 송신량 샘플 간격 (초)
+RECOVER_FRAC = 0.9        # 이 비율 이상의 속도로 돌아오면 회복
+RECOVER_WIN = 0.1         # 회복 판단용 속도 창 (초)
+MODES = ('police', 'shape')
+
+
+class PolicerTopo(Topo):
+    def build(self):
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, 7)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        # 병목 링크는 tc 를 직접 설정하므로 TCLink 가 아닌 일반 링크
+        self.addLink(server, s1, cls=Link)
+        for h in clients:
+            self.addLink(h, s1, cls=TCLink, bw=1000, delay=ACCESS_DELAY)
+
+
+def setup_limiter(intf, mode, rate_mbps, burst_kb):
+    """s1 → h1 방향 송신 인터페이스에 폴리서 또는 셰이퍼 설치"""
+    subprocess.run(['tc', 'qdisc', 'del', 'dev', intf, 'root'],
+                   stderr=subprocess.DEVNULL)
+    if mode == 'police':
+        subprocess.run(['tc', 'qdisc', 'add', 'dev', intf, 'root', 'handle', '1:', 'prio'],
+                       check=True)
+        subprocess.run(['tc', 'filter', 'add', 'dev', intf, 'parent', '1:', 'protocol', 'ip',
+                        'u32', 'match', 'u32', '0', '0',
+                        'police', 'rate', f'{rate_mbps}mbit', 'burst', f'{burst_kb}k',
+                        'drop', 'flowid', '1:1'], check=True)
+    elif mode == 'shape':
+        subprocess.run(['tc', 'qdisc', 'add', 'dev', intf, 'root', 'tbf',
+                        'rate', f'{rate_mbps}mbit', 'burst', f'{burst_kb}k',
+                        'latency', TBF_LATENCY], check=True)
+    else:
+        raise ValueError(f"unknown limiter mode: {mode}")
+
+
+def qdisc_drops(intf):
+    """루트 qdisc 드롭 수 (폴리서 드롭도 prio qdisc 드롭으로 집계됨)"""
+    out = subprocess.run(['tc', '-s', '-j', 'qdisc', 'show', 'dev', intf],
+                         capture_output=True, text=True).stdout
+    try:
+        for q in json.loads(out):
+            if q.get('root'):
+                return q.get('drops', 0)
+    except ValueError:
+        pass
+    return 0
+
+
+class Sampler(threading.Thread):
+    """SAMPLE 간격으로 (시각, 누적 드롭, 누적 송신 바이트) 기록"""
+
+    def __init__(self, intf):
+        super().__init__(daemon=True)
+        self.intf = intf
+        self.samples = []
+        self.stop_event = threading.Event()
+
+    def run(self):
+        while not self.stop_event.is_set():
+            self.samples.append((time.time(), qdisc_drops(self.intf),
+                                 intf_tx_bytes(self.intf)))
+            time.sleep(SAMPLE)
+
+    def stop(self):
+        self.stop_event.set()
+        self.join()
+
+
+def analyze_bursts(samples, rate_mbps):
+    """
+    연속으로 드롭이 관측된 샘플 구간 = 손실 버스트
+    회복 시간 = 버스트 끝부터 RECOVER_WIN 창 송신 속도가 정책 속도의 RECOVER_FRAC 이상이 될 때까지
+    """
+    bursts = []
+    cur = None
+    for (t0, d0, _), (t1, d1, _) in zip(samples, samples[1:]):
+        if d1 > d0:
+            if cur is None:
+                cur = [t0, t1, 0]
+            cur[1] = t1
+            cur[2] += d1 - d0
+        elif cur is not None:
+            bursts.append(tuple(cur))
+            cur = None
+    if cur is not None:
+        bursts.append(tuple(cur))
+
+    target = rate_mbps * 1e6 * RECOVER_FRAC
+    results = []
+    for start, end, drops in bursts:
+        recovery = None
+        for i, (t, _, b) in enumerate(samples):
+            if t < end:
+                continue
+            j = i
+            while j < len(samples) and samples[j][0] - t < RECOVER_WIN:
+                j += 1
+            if j >= len(samples):
+                break
+            if (samples[j][2] - b) * 8 / (samples[j][0] - t) >= target:
+                recovery = t - end
+                break
+        results.append((end - start, drops, recovery))
+    return results
+
+
+def goodput_bps(paths):
+    total = 0.0
+    for path in paths:
+        try:
+            with open(path) as f:
+                data = json.load(f)
+            total += data['end']['sum_received']['bits_per_second']
+        except (OSError, ValueError, KeyError):
+            pass
+    return total
+
+
+def runExperiment(cc_algo='reno', duration=30, mode='police',
+                  rate_mbps=RATE_MBPS, burst_kb=BURST_KB, cap_gain=None):
+    # 토폴로지를 띄우기 전에 거부 (다른 값이 조용히 tbf 로 바뀌지 않게)
+    if mode not in MODES:
+        raise ValueError(f"unknown limiter mode: {mode} (expected one of {MODES})")
+    topo = PolicerTopo()
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, 7)]
+    s1 = net.get('s1')
+
+    link = net.linksBetween(server, s1)[0]
+    intf = (link.intf1 if link.intf1.node == s1 else link.intf2).name
+    info(f"*** {mode} {rate_mbps} Mbit/s burst {burst_kb} KB on {intf}\n")
+    setup_limiter(intf, mode, rate_mbps, burst_kb)
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+    # 실험 중 예외가 나도 cap_gain 은 실험 전 값으로 되돌림
+    prev_cap_gain = get_module_param('cap_gain')
+    try:
+        if cc_algo == 'reno_custom' and cap_gain is not None:
+            set_module_param('cap_gain', cap_gain)
+
+        server_ip = server.IP()
+
+        # police 는 초과분 드롭, tbf 는 큐잉이지만 둘 다 전달 용량은 rate_mbps
+        calibrate(net, [(clients[0], server)], limits={intf: {'bw': rate_mbps}})
+
+        info("*** Kill old iperf3 servers (if any)\n")
+        server.cmd("pkill iperf3")
+
+        info("*** Start 5 iperf3 servers on h1 (ports 5201~5205)\n")
+        for i in range(5):
+            port = 5201 + i
+            server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+
+        time.sleep(1)
+
+        sampler = Sampler(intf)
+        sampler.start()
+
+        info("*** Start 5 concurrent iperf3 clients (h2~h6)\n")
+        logs = []
+        for i, c in enumerate(clients):
+            port = 5201 + i
+            host_num = i + 2
+            logFile = f"/tmp/iperf3_h{host_num}_{cc_algo}.json"
+            cmd = f"iperf3 -J -c {server_ip} -p {port} -t {duration} > {logFile} &"
+            info(f"h{host_num}: iperf3 -c {server_ip}:{port}\n")
+            c.cmd(cmd)
+            logs.append(logFile)
+            time.sleep(0.2)
+
+        live = LiveFeed(clients, [('s1->h1', s1, intf)])
+        live.start()
+        info(f"*** Running {duration} seconds...\n")
+        time.sleep(duration + 3)
+        live.stop()
+        sampler.stop()
+
+        report(cc_algo, mode, rate_mbps, logs, sampler.samples)
+    finally:
+        if cc_algo == 'reno_custom' and cap_gain is not None and prev_cap_gain is not None:
+            set_module_param('cap_gain', prev_cap_gain)
+
+    info("*** iperf3 finished. You can now run the analyzer script.\n")
+    CLI(net)
+    net.stop()
+
+
+def report(cc_algo, mode, rate_mbps, logs, samples):
+    bursts = analyze_bursts(samples, rate_mbps)
+    eff = goodput_bps(logs) / (rate_mbps * 1e6)
+
+    info(f"\n=== {mode} {rate_mbps} Mbit/s ({cc_algo}) ===\n")
+    info(f"Goodput / rate:     {eff * 100:.1f}%\n")
+    info(f"Loss bursts:        {len(bursts)}\n")
+    if bursts:
+        lengths = [b[0] * 1000 for b in bursts]
+        drops = [b[1] for b in bursts]
+        rec = [b[2] for b in bursts if b[2] is not None]
+        info(f"Burst length (ms):  mean {sum(lengths) / len(lengths):.0f}, max {max(lengths):.0f}\n")
+        info(f"Drops per burst:    mean {sum(drops) / len(drops):.1f}, max {max(drops)}\n")
+        if rec:
+            info(f"Recovery (ms):      mean {sum(rec) / len(rec) * 1000:.0f}, "
+                 f"max {max(rec) * 1000:.0f} ({len(rec)}/{len(bursts)} recovered)\n")
+        else:
+            info("Recovery (ms):      never reached "
+                 f"{RECOVER_FRAC * 100:.0f}% of rate\n")
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    # exp_policer.py <cc> [police|shape] [rate_mbps] [burst_kb] [cap_gain]
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    mode = sys.argv[2] if len(sys.argv) > 2 else 'police'
+    if mode not in MODES:
+        sys.exit(f"unknown mode: {mode} (expected {'|'.join(MODES)})")
+    rate = int(sys.argv[3]) if len(sys.argv) > 3 else RATE_MBPS
+    burst = int(sys.argv[4]) if len(sys.argv) > 4 else BURST_KB
+    gain = int(sys.argv[5]) if len(sys.argv) > 5 else None
+    runExperiment(cc_algo, duration=10, mode=mode, rate_mbps=rate,
+                  burst_kb=burst, cap_gain=gain)
@@ -0,0 +1,235 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import json
+import time
+
+from exp_common import jain_fairness, host_tcp_counters, load_corpus
+from calibration import calibrate
+
+# 파라미터 하나로 기술되는 일반 시나리오 (search_scenarios.py 의 탐색 공간과 같은 키)
+#   h2..h{N+1} (흐름별 접속 지연 = RTT_i/2, 지터) ── s1 ══ 병목 (bw, 버퍼, 손실) ══ h1
+#   cross_frac > 0 이면 h{N+2} 가 xtraffic onoff 로 병목의 cross_frac 만큼을 ON 구간에 사용
+# reno_sim 과 같은 모델: RTT_i = rtt_ms * (1 + rtt_spread * i/(N-1)), 흐름 i 는 stagger_s * i 초에 시작,
+#   burst > 1 이면 데이터 방향 손실을 평균 버스트 길이 burst 인 Gilbert-Elliott 로
+# 결과 요약(/tmp/scenario_{cc}.json)은 reno_sim 출력과 같은 키 → 탐색 결과를 에뮬레이터로 재확인
+DEFAULTS = {
+    'bw_mbps': 100, 'rtt_ms': 20, 'rtt_spread': 0, 'jitter_ms': 0, 'loss_pct': 0,
+    'burst': 1, 'buf_bdp': 1, 'flows': 5, 'stagger_s': 0, 'cross_frac': 0, 'cross_ms': 500,
+}
+PKT_BITS = 1500 * 8
+SINK_PORT = 6000
+INTERVAL = 0.5
+
+
+def flow_rtts(p):
+    n = p['flows']
+    return [p['rtt_ms'] * (1 + (p['rtt_spread'] * i / (n - 1) if n > 1 else 0)) for i in range(n)]
+
+
+class ScenarioTopo(Topo):
+    def build(self, p=DEFAULTS):
+        server = self.addHost('h1', cls=Host)
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        bdp = p['bw_mbps'] * 1e6 * p['rtt_ms'] / 1e3 / PKT_BITS
+        # 병목: 지연 없이 대역폭/버퍼만 (손실은 시작 후 s1 쪽 netem 에만 설정)
+        self.addLink(server, s1, cls=TCLink, bw=p['bw_mbps'],
+                     max_queue_size=max(2, int(round(p['buf_bdp'] * bdp))))
+        for i, rtt in enumerate(flow_rtts(p)):
+            h = self.addHost(f'h{i + 2}', cls=Host)
+            opts = dict(cls=TCLink, bw=max(1000, p['bw_mbps'] * 2), delay=f'{rtt / 2:.3f}ms')
+            if p['jitter_ms'] > 0:
+                opts['jitter'] = f"{p['jitter_ms'] / 2:.3f}ms"
+            self.addLink(h, s1, **opts)
+        if p['cross_frac'] > 0:
+            cross = self.addHost(f"h{p['flows'] + 2}", cls=Host)
+            self.addLink(cross, s1, cls=TCLink, bw=1000, delay='1ms')
+
+
+def set_bottleneck_loss(net, p):
+    """s1→h1 netem 에 데이터 방향 손실 (burst > 1 이면 gemodel, 나쁜 상태는 전부 손실)"""
+    if p['loss_pct'] <= 0:
+        return
+    s1 = net.get('s1')
+    intf = s1.connectionsTo(net.get('h1'))[0][0]
+    limit = intf.params.get('max_queue_size', 1000)
+    q = p['loss_pct'] / 100.0
+    if p['burst'] > 1:
+        r = 1.0 / p['burst']
+        g = q * r / (1.0 - q)
+        loss = f"loss gemodel {g * 100:.4f}% {r * 100:.4f}%"
+    else:
+        loss = f"loss {p['loss_pct']:.4f}%"
+    # TCLink(bw 지정) 은 htb 5:1 아래 netem 10: 을 둠
+    out = s1.cmd(f"tc qdisc change dev {intf} parent 5:1 handle 10: netem limit {limit} {loss}")
+    if out.strip():
+        info(f"!! tc: {out.strip()}\n")
+
+
+def qdisc_drops(node, intf):
+    out = node.cmd(f"tc -s qdisc show dev {intf}")
+    drops = 0
+    for line in out.splitlines():
+        if 'dropped' in line:
+            try:
+                drops += int(line.split('dropped')[1].split(',')[0])
+            except (IndexError, ValueError):
+                pass
+    return drops
+
+
+def cross_mbps(path):
+    """xtraffic 송신 로그의 구간 평균 Mbit/s"""
+    rates = []
+    try:
+        with open(path) as f:
+            for line in f:
+                parts = line.strip().split(',')
+                if parts[0] == 'ival':
+                    rates.append(float(parts[4]))
+    except OSError:
+        pass
+    return sum(rates) / len(rates) if rates else 0.0
+
+
+def _pct(values, p):
+    v = sorted(values)
+    return v[min(len(v) - 1, int(p * len(v)))] if v else 0.0
+
+
+def summarize(p, cc_algo, logs, rtts, cross_log, counters, drops):
+    """iperf3 로그 → reno_sim 과 같은 키의 요약"""
+    mbps, qdelay = [], []
+    for path, rtt in zip(logs, rtts):
+        try:
+            with open(path) as f:
+                data = json.load(f)
+        except (OSError, ValueError):
+            data = {}
+        mbps.append(data.get('end', {}).get('sum_received', {}).get('bits_per_second', 0.0) / 1e6)
+        for iv in data.get('intervals', []):
+            for st in iv.get('streams', []):
+                if 'rtt' in st:
+                    qdelay.append(max(0.0, st['rtt'] / 1e3 - rtt))
+
+    total = sum(mbps)
+    avail = p['bw_mbps'] - (cross_mbps(cross_log) if cross_log else 0.0)
+    mean = total / len(mbps) if mbps else 0.0
+    return {
+        'cc': cc_algo, 'params': p,
+        'goodput_mbps': [round(m, 3) for m in mbps],
+        'total_mbps': total,
+        'utilization': total / avail if avail > 0 else 0.0,
+        'jain': jain_fairness(mbps),
+        'min_share': min(m / mean for m in mbps) if mean > 0 else 0.0,
+        'qdelay_ms_avg': sum(qdelay) / len(qdelay) if qdelay else 0.0,
+        'qdelay_ms_p95': _pct(qdelay, 0.95),
+        'retrans': counters['TcpRetransSegs'],
+        'rtos': counters['TcpExtTCPTimeouts'],
+        'drops': drops,
+    }
+
+
+def runExperiment(cc_algo='reno', duration=10, params=None):
+    p = dict(DEFAULTS, **(params or {}))
+    p['flows'] = int(p['flows'])
+    topo = ScenarioTopo(p=p)
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, p['flows'] + 2)]
+    rtts = flow_rtts(p)
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+
+    calibrate(net, [(clients[0], server)])
+    set_bottleneck_loss(net, p)
+    s1 = net.get('s1')
+    bottleneck = s1.connectionsTo(server)[0][0]
+    drops0 = qdisc_drops(s1, bottleneck)
+
+    info("*** Kill old iperf3 servers (if any)\n")
+    server.cmd("pkill iperf3; pkill xtraffic")
+    info(f"*** Start {p['flows']} iperf3 servers on h1\n")
+    for i in range(p['flows']):
+        port = 5201 + i
+        server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+
+    cross_log = None
+    if p['cross_frac'] > 0:
+        cross_log = f"/tmp/xtraffic_scenario_{cc_algo}.csv"
+        server.cmd(f"./xtraffic sink {SINK_PORT} > /tmp/xtraffic_sink.log 2>&1 &")
+    time.sleep(1)
+
+    before = [host_tcp_counters(c) for c in clients]
+    span = duration + p['stagger_s'] * (p['flows'] - 1)
+    if cross_log:
+        cross = net.get(f"h{p['flows'] + 2}")
+        info(f"*** Start on-off cross traffic ({p['cross_frac']:.0%} of bottleneck) on {cross.name}\n")
+        cross.cmd(f"./xtraffic onoff {server.IP()} {SINK_PORT} -r {p['cross_frac'] * p['bw_mbps']:.3f} "
+                  f"-o {p['cross_ms']:.0f} -f {p['cross_ms']:.0f} -t {span:.0f} -S 1 "
+                  f"-L {INTERVAL * 1000:.0f} -l {cross_log} 2>> /tmp/xtraffic_send.log &")
+
+    info(f"*** Start {p['flows']} iperf3 clients (stagger {p['stagger_s']}s)\n")
+    logs = []
+    for i, c in enumerate(clients):
+        if i and p['stagger_s'] > 0:
+            time.sleep(p['stagger_s'])
+        logFile = f"/tmp/iperf3_h{i + 2}_{cc_algo}.json"
+        # 늦게 시작한 흐름도 마지막 흐름과 같은 시각에 끝나도록
+        t = span - p['stagger_s'] * i
+        c.cmd(f"iperf3 -J -i {INTERVAL} -c {server.IP()} -p {5201 + i} -t {t:.1f} > {logFile} &")
+        logs.append(logFile)
+
+    info(f"*** Running {duration} seconds after the last start...\n")
+    time.sleep(duration + 3)
+    server.cmd("pkill -INT xtraffic")
+
+    after = [host_tcp_counters(c) for c in clients]
+    counters = {k: sum(a[k] - b[k] for a, b in zip(after, before)) for k in before[0]}
+    summary = summarize(p, cc_algo, logs, rtts, cross_log, counters,
+                        qdisc_drops(s1, bottleneck) - drops0)
+    with open(f"/tmp/scenario_{cc_algo}.json", 'w') as f:
+        json.dump(summary, f)
+    report(summary)
+
+    info(f"*** Finished. Summary saved to /tmp/scenario_{cc_algo}.json\n")
+    CLI(net)
+    net.stop()
+
+
+def report(s):
+    p = s['params']
+    info(f"\n=== Scenario ({s['cc']}): {p['bw_mbps']}Mbit/s, RTT {p['rtt_ms']}ms, "
+         f"{p['flows']} flows, buffer {p['buf_bdp']} BDP, loss {p['loss_pct']}% ===\n")
+    info(f"Goodput {s['total_mbps']:.1f}M (util {s['utilization']:.1%}), Jain {s['jain']:.3f}, "
+         f"min share {s['min_share']:.2f}\n")
+    info(f"Queue delay avg {s['qdelay_ms_avg']:.1f}ms, p95 {s['qdelay_ms_p95']:.1f}ms, "
+         f"retrans {s['retrans']}, RTOs {s['rtos']}, drops {s['drops']}\n")
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    # exp_scenario.py <cc> [params json | 코퍼스 이름] [duration]
+    #   예: exp_scenario.py reno_custom '{"bw_mbps": 50, "rtt_ms": 80, "burst": 4, "loss_pct": 0.5}'
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    params = {}
+    if len(sys.argv) > 2:
+        arg = sys.argv[2]
+        if arg.lstrip().startswith('{'):
+            params = json.loads(arg)
+        else:
+            params = next((c['params'] for c in load_corpus() if c['name'] == arg), None)
+            if params is None:
+                sys.exit(f"unknown corpus scenario: {arg}")
+    duration = int(sys.argv[3]) if len(sys.argv) > 3 else 10
+    runExperiment(cc_algo, duration=duration, params=params)
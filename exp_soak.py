@@ -0,0 +1,165 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import subprocess
+import time
+
+from exp_common import parse_ss_tcp_info
+from calibration import calibrate
+from soak_collector import SoakCollector, format_report
+
+# 장시간 soak: 5 흐름을 수 시간 돌리며 ss 샘플을 고정 메모리 집계기로 흘려 보냄
+#   h2..h6 ── s1 ══ 병목 ══ h1
+# iperf3 는 -J 없이(-i 0) 돌려 로그가 커지지 않게 하고, 처리량은 bytes_acked 차분으로 계산
+# 느린 드리프트(min-RTT 고착, 추정치 감쇠, 카운터 오버플로) 검출이 목적
+BOTTLENECK_BW = 100       # Mbit/s
+BOTTLENECK_DELAY = '10ms'
+SAMPLE = 1.0              # ss 샘플 간격 (초)
+CHECKPOINT = 60           # 체크포인트 간격 (초)
+WARMUP = 10               # 집계 시작 전 대기 (초)
+DELAY_STEP = '15ms'       # step 모드: 중간 지점에서 병목 지연 증가 (min-RTT 고착 확인)
+
+METRICS = {
+    'tput_mbps': True,        # 5 흐름 합계
+    'flow_tput_mbps': True,   # 흐름별 (한 스케치에 모음)
+    'rtt_ms': False,
+    'cwnd': None,
+    'bwe_mbps': None,         # reno_custom get_info BWE
+    'mrtt_gap_ms': False,     # 커널 minrtt(창 최소) - 모듈 min_rtt, 커지면 모듈 min_rtt 가 고착
+    'retrans_per_s': False,
+}
+
+
+class SoakTopo(Topo):
+    def build(self):
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, 7)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        self.addLink(server, s1, cls=TCLink, bw=BOTTLENECK_BW, delay=BOTTLENECK_DELAY)
+        for h in clients:
+            self.addLink(h, s1, cls=TCLink, bw=1000, delay='1ms')
+
+
+def sample_flows(clients, ports):
+    """클라이언트별 송신 소켓 ss 정보 {호스트 이름: dict}"""
+    out = {}
+    for c, port in zip(clients, ports):
+        cmd = ['ss', '-tin', 'state', 'established', f'dport = :{port}']
+        text = c.popen(cmd, stdout=subprocess.PIPE, text=True).communicate()[0]
+        # iperf3 제어 연결도 같은 포트이므로 가장 많이 보낸 소켓을 데이터 흐름으로
+        socks = [s for s in parse_ss_tcp_info(text) if s.get('bytes_acked')]
+        if socks:
+            out[c.name] = max(socks, key=lambda s: s['bytes_acked'])
+    return out
+
+
+def runExperiment(cc_algo='reno', duration=3600, step=False):
+    topo = SoakTopo()
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, 7)]
+    ports = [5201 + i for i in range(5)]
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+
+    server_ip = server.IP()
+
+    calibrate(net, [(clients[0], server)])
+
+    info("*** Kill old iperf3 servers (if any)\n")
+    server.cmd("pkill iperf3")
+
+    info("*** Start 5 iperf3 servers on h1 (ports 5201~5205)\n")
+    for port in ports:
+        server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+
+    time.sleep(1)
+
+    info(f"*** Start 5 soak iperf3 clients (h2~h6), {duration / 3600:.2f} h\n")
+    for c, port in zip(clients, ports):
+        c.cmd(f"iperf3 -i 0 -c {server_ip} -p {port} -t {duration} "
+              f"> /tmp/soak_iperf3_{c.name}_{cc_algo}.log 2>&1 &")
+
+    collector = SoakCollector(METRICS, f"/tmp/soak_{cc_algo}.json", step=SAMPLE)
+    bneck = net.linksBetween(server, net.get('s1'))[0]
+    t0 = time.time()
+    last = {}
+    next_ckpt = CHECKPOINT
+    stepped = not step
+    time.sleep(WARMUP)
+
+    info(f"*** Sampling every {SAMPLE}s, checkpoint every {CHECKPOINT}s -> /tmp/soak_{cc_algo}.json\n")
+    while True:
+        t = time.time() - t0
+        if t >= duration:
+            break
+        if not stepped and t >= duration / 2:
+            info(f"*** t={t:.0f}s: bottleneck delay {BOTTLENECK_DELAY} -> {DELAY_STEP}\n")
+            bneck.intf1.config(bw=BOTTLENECK_BW, delay=DELAY_STEP)
+            bneck.intf2.config(bw=BOTTLENECK_BW, delay=DELAY_STEP)
+            stepped = True
+
+        flows = sample_flows(clients, ports)
+        total, measured = 0.0, False
+        for name, s in flows.items():
+            prev = last.get(name)
+            acked = s.get('bytes_acked')
+            if prev and acked is not None and prev[1] is not None:
+                dt = t - prev[0]
+                if acked < prev[1]:
+                    # 같은 연결에서 누적 카운터가 줄어들면 오버플로/리셋
+                    collector.anomaly(f'{name}_bytes_acked_backwards', t)
+                elif dt > 0:
+                    mbps = (acked - prev[1]) * 8 / dt / 1e6
+                    total += mbps
+                    measured = True
+                    collector.add('flow_tput_mbps', t, mbps)
+                    retx = s.get('retrans', 0) - (prev[2] or 0)
+                    collector.add('retrans_per_s', t, max(retx, 0) / dt)
+            last[name] = (t, acked, s.get('retrans', 0))
+
+            collector.add('rtt_ms', t, s.get('rtt_ms'))
+            collector.add('cwnd', t, s.get('cwnd'))
+            bwe = s.get('bbr_bw_bps')
+            if bwe is not None:
+                collector.add('bwe_mbps', t, bwe / 1e6)
+                if bwe > 4 * BOTTLENECK_BW * 1e6:
+                    collector.anomaly('bwe_above_4x_capacity', t)
+            if s.get('bbr_mrtt_ms') and s.get('minrtt_ms'):
+                collector.add('mrtt_gap_ms', t, s['minrtt_ms'] - s['bbr_mrtt_ms'])
+        if len(flows) < len(clients):
+            collector.anomaly('flow_missing', t)
+        if measured:
+            collector.add('tput_mbps', t, total)
+
+        if t >= next_ckpt:
+            collector.checkpoint()
+            next_ckpt += CHECKPOINT
+        time.sleep(SAMPLE)
+
+    collector.checkpoint()
+    info(f"\n=== Soak summary ({cc_algo}) ===\n")
+    info(format_report(collector.snapshot()) + "\n")
+
+    info("*** Soak finished. Checkpoint kept at "
+         f"/tmp/soak_{cc_algo}.json\n")
+    CLI(net)
+    net.stop()
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    hours = float(sys.argv[2]) if len(sys.argv) > 2 else 2.0
+    step = len(sys.argv) > 3 and sys.argv[3] == 'step'
+    runExperiment(cc_algo, duration=int(hours * 3600), step=step)
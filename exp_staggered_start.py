@@ -0,0 +1,121 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import time
+
+from exp_common import set_module_param, jain_fairness, load_intervals, rate_at
+
+# 흐름이 STAGGER 초 간격으로 하나씩 합류할 때 공정 점유율까지 수렴하는 시간 측정
+STAGGER = 10          # 합류 간격 (초)
+INTERVAL = 0.5        # iperf3 보고 간격 (초)
+FAIR_JFI = 0.9        # 이 이상의 Jain index 가
+HOLD = 2.0            # 이 시간 동안 유지되면 수렴으로 판단
+
+
+class StaggeredTopo(Topo):
+    def build(self, num_clients=4):
+        server = self.addHost('h1', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, num_clients + 2)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        # 병목: s1 ↔ h1 (100 Mbit/s, RTT 약 44ms)
+        self.addLink(server, s1, cls=TCLink, bw=100, delay='20ms')
+        for h in clients:
+            self.addLink(h, s1, cls=TCLink, bw=1000, delay='1ms')
+
+
+def runExperiment(cc_algo='reno_custom', fast_conv=False, num_clients=4):
+    label = f"{cc_algo}_fc" if fast_conv else cc_algo
+    total = STAGGER * num_clients + 10
+
+    topo = StaggeredTopo(num_clients=num_clients)
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    clients = [net.get(f'h{i}') for i in range(2, num_clients + 2)]
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+    if cc_algo == 'reno_custom':
+        set_module_param('fast_convergence', fast_conv)
+
+    server.cmd("pkill iperf3")
+    for i in range(num_clients):
+        port = 5201 + i
+        server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+    time.sleep(1)
+
+    # 모두 같은 시각에 끝나도록 늦게 시작한 흐름은 짧게 실행
+    t0 = time.time()
+    flows = []
+    for i, c in enumerate(clients):
+        host_num = i + 2
+        offset = time.time() - t0
+        duration = total - i * STAGGER
+        logFile = f"/tmp/iperf3_h{host_num}_{label}.json"
+        c.cmd(f"iperf3 -J -i {INTERVAL} -c {server.IP()} -p {5201 + i} "
+              f"-t {duration} > {logFile} &")
+        info(f"h{host_num}: start at {offset:.1f}s for {duration}s\n")
+        flows.append((host_num, offset, logFile))
+        if i < num_clients - 1:
+            time.sleep(STAGGER)
+
+    time.sleep(total - (time.time() - t0) + 3)
+
+    report_convergence(flows, label)
+
+    if cc_algo == 'reno_custom':
+        set_module_param('fast_convergence', 0)
+    CLI(net)
+    net.stop()
+
+
+def report_convergence(flows, label):
+    """각 합류 시점부터 활성 흐름들의 JFI 가 FAIR_JFI 이상으로 HOLD 초 유지될 때까지의 시간"""
+    series = [(h, off, load_intervals(path, off)) for h, off, path in flows]
+
+    info(f"\n=== Convergence ({label}) ===\n")
+    info("Join\tFlows\tConvergence (s)\n")
+    times = []
+    for k in range(1, len(series)):
+        join = series[k][1]
+        end = series[k + 1][1] if k + 1 < len(series) else join + STAGGER
+        active = series[:k + 1]
+
+        converged = None
+        held_since = None
+        t = join
+        while t < end:
+            rates = [rate_at(s, t) for _, _, s in active]
+            if None not in rates and jain_fairness(rates) >= FAIR_JFI:
+                if held_since is None:
+                    held_since = t
+                if t - held_since >= HOLD:
+                    converged = held_since - join
+                    break
+            else:
+                held_since = None
+            t += INTERVAL
+
+        times.append(converged)
+        shown = f"{converged:.1f}" if converged is not None else f"> {end - join:.0f}"
+        info(f"h{series[k][0]}\t{k + 1}\t{shown}\n")
+
+    done = [t for t in times if t is not None]
+    if done:
+        info(f"Mean convergence: {sum(done) / len(done):.1f} s "
+             f"({len(done)}/{len(times)} joins converged)\n")
+
+
+if __name__ == "__main__":
+    import sys
+
+    setLogLevel('info')
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno_custom'
+    fast_conv = len(sys.argv) > 2 and sys.argv[2] == 'fc'
+    runExperiment(cc_algo, fast_conv=fast_conv)
@@ -0,0 +1,147 @@
+from mininet.net import Mininet
+from mininet.topo import Topo
+from mininet.node import OVSKernelSwitch, Host
+from mininet.cli import CLI
+from mininet.link import TCLink
+from mininet.log import setLogLevel, info
+import os
+import subprocess
+import time
+
+from gen_trace import generate, write_trace
+import gen_impair
+from live_dashboard import LiveFeed
+
+# 병목을 linkemu (트레이스 기반 가변 용량 링크) 로 대체한 시나리오
+#   h2..h6 ── s1 ── r0 ══(le0 ⇄ linkemu ⇄ le1)══ h1
+TRACE_MBPS = 50           # 데이터 방향 트레이스 평균 용량
+ACK_MBPS = 50             # 역방향 (ACK) 트레이스 평균 용량
+DELAY_MS = 10             # 링크 편도 지연
+QUEUE_BYTES = 150000      # 병목 큐 (평균 용량 기준 약 1 BDP)
+UP_TRACE = '/tmp/trace_up.trace'
+DOWN_TRACE = '/tmp/trace_down.trace'
+LINKEMU_LOG = '/tmp/linkemu_queue.csv'
+# 데이터 방향 손상 패턴 (seed 별 고정 → 알고리즘끼리 같은 손실/지터 순서, run_paired.py)
+IMPAIR_PATTERN = '/tmp/impair_up_{}.pat'
+
+EMU_NET = '10.9.0'        # le0 = .1 (r0), le1 = .2 (h1)
+
+
+class TraceLinkTopo(Topo):
+    def build(self):
+        # 서버 h1 은 linkemu 장치로만 연결 (링크 없음)
+        self.addHost('h1', cls=Host)
+        router = self.addHost('r0', cls=Host)
+        clients = [self.addHost(f'h{i}', cls=Host) for i in range(2, 7)]
+        s1 = self.addSwitch('s1', cls=OVSKernelSwitch)
+
+        self.addLink(router, s1, cls=TCLink, bw=1000, delay='1ms')
+        for h in clients:
+            self.addLink(h, s1, cls=TCLink, bw=1000, delay='1ms')
+
+
+def impair_pattern(loss_pct, burst, jitter_ms, seed):
+    """손상 패턴 파일 경로 (손상이 없으면 None), 같은 인자면 매번 같은 파일"""
+    if loss_pct <= 0 and jitter_ms <= 0:
+        return None
+    path = IMPAIR_PATTERN.format(seed)
+    gen_impair.write_pattern(path, gen_impair.generate(loss_pct, burst, jitter_ms, seed))
+    return path
+
+
+def start_linkemu(router, server, qdisc, pattern=None):
+    """linkemu 실행 후 TUN 장치를 r0 / h1 네임스페이스로 옮기고 주소 설정"""
+    if not os.path.exists(UP_TRACE):
+        write_trace(UP_TRACE, generate(TRACE_MBPS, seed=1))
+    if not os.path.exists(DOWN_TRACE):
+        write_trace(DOWN_TRACE, generate(ACK_MBPS, seed=2))
+
+    cmd = ['./linkemu', '-u', UP_TRACE, '-d', DOWN_TRACE, '-D', str(DELAY_MS),
+           '-q', qdisc, '-B', str(QUEUE_BYTES), '-l', LINKEMU_LOG]
+    if pattern:
+        cmd += ['-i', pattern]
+    emu = subprocess.Popen(cmd, stdout=subprocess.PIPE, text=True)
+    emu.stdout.readline()   # "ready" 까지 대기
+
+    subprocess.run(['ip', 'link', 'set', 'le0', 'netns', str(router.pid)], check=True)
+    subprocess.run(['ip', 'link', 'set', 'le1', 'netns', str(server.pid)], check=True)
+
+    router.cmd(f"ip addr add {EMU_NET}.1 peer {EMU_NET}.2 dev le0 && ip link set le0 up")
+    router.cmd("sysctl -w net.ipv4.ip_forward=1 > /dev/null")
+    server.cmd(f"ip addr add {EMU_NET}.2 peer {EMU_NET}.1 dev le1 && ip link set le1 up")
+    server.cmd("ip route add default dev le1")
+    return emu
+
+
+def runExperiment(cc_algo='reno', duration=30, qdisc='droptail',
+                  loss_pct=0.0, burst=1.0, jitter_ms=0.0, seed=1):
+    topo = TraceLinkTopo()
+    net = Mininet(topo=topo, autoSetMacs=True, build=True)
+    net.start()
+
+    server = net.get('h1')
+    router = net.get('r0')
+    clients = [net.get(f'h{i}') for i in range(2, 7)]
+
+    pattern = impair_pattern(loss_pct, burst, jitter_ms, seed)
+    desc = f", loss {loss_pct}% burst {burst}, jitter {jitter_ms}ms, seed {seed}" if pattern else ''
+    info(f"*** Start linkemu ({TRACE_MBPS} Mbit/s trace, {qdisc}{desc})\n")
+    emu = start_linkemu(router, server, qdisc, pattern)
+    for c in clients:
+        c.cmd(f"ip route add {EMU_NET}.0/24 via {router.IP()}")
+
+    info(f"*** Set TCP CC to {cc_algo}\n")
+    for h in net.hosts:
+        h.cmd(f"sysctl -w net.ipv4.tcp_congestion_control={cc_algo} > /dev/null")
+
+    server_ip = f"{EMU_NET}.2"
+
+    info("*** Kill old iperf3 servers (if any)\n")
+    server.cmd("pkill iperf3")
+
+    info("*** Start 5 iperf3 servers on h1 (ports 5201~5205)\n")
+    for i in range(5):
+        port = 5201 + i
+        server.cmd(f"iperf3 -s -p {port} > /tmp/iperf3_s_{port}.log 2>&1 &")
+
+    time.sleep(1)
+
+    info("*** Start 5 concurrent iperf3 clients (h2~h6)\n")
+    for i, c in enumerate(clients):
+        port = 5201 + i
+        host_num = i + 2
+        logFile = f"/tmp/iperf3_h{host_num}_{cc_algo}.json"
+        cmd = f"iperf3 -J -c {server_ip} -p {port} -t {duration} > {logFile} &"
+        info(f"h{host_num}: iperf3 -c {server_ip}:{port}\n")
+        c.cmd(cmd)
+        time.sleep(0.2)
+
+    live = LiveFeed(clients)
+    live.start()
+    info(f"*** Running {duration} seconds...\n")
+    time.sleep(duration + 3)
+    live.stop()
+
+    emu.terminate()
+    emu.wait()
+    info(f"*** linkemu queue log: {LINKEMU_LOG}\n")
+
+    info("*** iperf3 finished. You can now run the analyzer script.\n")
+    CLI(net)
+    net.stop()
+
+
+if __name__ == "__main__":
+    setLogLevel('info')
+    import sys
+
+    # exp_trace_link.py <cc> [qdisc] [loss_pct] [burst] [jitter_ms] [seed]
+    #   예: exp_trace_link.py reno droptail 1 4 5 7  (Gilbert-Elliott 1%, 평균 버스트 4, 지터 0~5ms)
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno'
+    qdisc = sys.argv[2] if len(sys.argv) > 2 else 'droptail'
+    loss_pct = float(sys.argv[3]) if len(sys.argv) > 3 else 0.0
+    burst = float(sys.argv[4]) if len(sys.argv) > 4 else 1.0
+    jitter_ms = float(sys.argv[5]) if len(sys.argv) > 5 else 0.0
+    seed = int(sys.argv[6]) if len(sys.argv) > 6 else 1
+    runExperiment(cc_algo, duration=10, qdisc=qdisc, loss_pct=loss_pct, burst=burst,
+                  jitter_ms=jitter_ms, seed=seed)
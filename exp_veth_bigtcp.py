@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+100 Gbit/s 급 큰 윈도우 검증용 veth/네임스페이스 테스트베드
+- mininet(OVS + TCLink) 대신 veth 한 쌍을 직접 연결해 호스트가 낼 수 있는 최대 속도로 실행
+- BIG TCP (gso/gro_max_size 확대), 점보 MTU, netem 으로 RTT 100ms 이상
+- 실행 중 `ss -tin` 을 샘플링해 cwnd wrap/붕괴 같은 이상 징후를 검사
+
+사용법: sudo python3 exp_veth_bigtcp.py [cc_algo] [rtt_ms] [streams]
+"""
+
+import json
+import subprocess
+import sys
+import threading
+import time
+
+from exp_common import parse_ss_tcp_info
+
+SND_NS = 'rc_snd'
+RCV_NS = 'rc_rcv'
+SND_IP = '10.200.0.1'
+RCV_IP = '10.200.0.2'
+MTU = 9000
+BIG_GSO = 185000          # BIG TCP 최대 GSO 크기
+BUF_MAX = 1 << 30         # 소켓 버퍼 최대 1 GiB
+DURATION = 60
+SAMPLE_INTERVAL = 0.5
+
+
+def sh(cmd, check=True):
+    return subprocess.run(cmd, shell=True, check=check, text=True,
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE).stdout
+
+
+def ns(name, cmd, check=True):
+    return sh(f"ip netns exec {name} {cmd}", check=check)
+
+
+def setup(rtt_ms):
+    teardown()
+    sh(f"ip netns add {SND_NS}")
+    sh(f"ip netns add {RCV_NS}")
+    sh(f"ip link add veth_snd netns {SND_NS} type veth peer name veth_rcv netns {RCV_NS}")
+
+    one_way = f"{rtt_ms / 2:g}ms"
+    for name, dev, ip in ((SND_NS, 'veth_snd', SND_IP), (RCV_NS, 'veth_rcv', RCV_IP)):
+        ns(name, f"ip link set lo up")
+        ns(name, f"ip link set {dev} mtu {MTU}")
+        # BIG TCP: IPv4 는 커널 6.3+ 에서 gso_ipv4_max_size 지원, 없으면 무시
+        ns(name, f"ip link set {dev} gso_max_size {BIG_GSO} gro_max_size {BIG_GSO}", check=False)
+        ns(name, f"ip link set {dev} gso_ipv4_max_size {BIG_GSO} gro_ipv4_max_size {BIG_GSO}",
+           check=False)
+        ns(name, f"ip addr add {ip}/24 dev {dev}")
+        ns(name, f"ip link set {dev} up")
+
+        # 양방향 지연 → RTT; 큐가 BDP 를 담을 수 있도록 limit 크게
+        ns(name, f"tc qdisc add dev {dev} root netem delay {one_way} limit 10000000")
+
+        for key in ('tcp_rmem', 'tcp_wmem'):
+            ns(name, f"sysctl -w net.ipv4.{key}='4096 131072 {BUF_MAX}'", check=False)
+        for key in ('rmem_max', 'wmem_max'):
+            ns(name, f"sysctl -w net.core.{key}={BUF_MAX}", check=False)
+
+
+def teardown():
+    sh(f"ip netns del {SND_NS}", check=False)
+    sh(f"ip netns del {RCV_NS}", check=False)
+
+
+def sampler(stop, samples):
+    while not stop.is_set():
+        t = time.time()
+        out = ns(SND_NS, f"ss -tin dst {RCV_IP}", check=False)
+        for sock in parse_ss_tcp_info(out):
+            if sock['peer'].endswith(':5201'):
+                sock['t'] = t
+                samples.append(sock)
+        stop.wait(SAMPLE_INTERVAL)
+
+
+def check_samples(samples):
+    """큰 윈도우에서 나타나는 산술 오류 징후 검사"""
+    problems = []
+    by_flow = {}
+    for s in samples:
+        by_flow.setdefault(s['local'], []).append(s)
+
+    for flow, seq in by_flow.items():
+        prev = None
+        for s in seq:
+            cwnd = s.get('cwnd', 0)
+            ssthresh = s.get('ssthresh')
+            # ssthresh 는 설계상 cwnd*4 를 넘지 않음
+            if ssthresh and prev and ssthresh > max(prev.get('cwnd', 0), cwnd) * 4:
+                problems.append(f"{flow}: ssthresh {ssthresh} > 4 x cwnd")
+            # 재전송 없이 cwnd 가 1/4 이하로 급락하면 wrap 의심
+            if prev and cwnd * 4 < prev.get('cwnd', 0) and \
+                    s.get('retrans', 0) == prev.get('retrans', 0):
+                problems.append(f"{flow}: cwnd {prev['cwnd']} -> {cwnd} without retransmits")
+            prev = s
+    return by_flow, problems
+
+
+def run(cc_algo='reno_custom', rtt_ms=100, streams=4):
+    setup(rtt_ms)
+    try:
+        ns(RCV_NS, "iperf3 -s -D -p 5201")
+        time.sleep(1)
+
+        samples = []
+        stop = threading.Event()
+        th = threading.Thread(target=sampler, args=(stop, samples))
+        th.start()
+
+        out = ns(SND_NS, f"iperf3 -J -c {RCV_IP} -p 5201 -t {DURATION} -P {streams} "
+                         f"-C {cc_algo} -w {BUF_MAX // 4} -l 1M", check=False)
+        stop.set()
+        th.join()
+
+        logFile = f"/tmp/iperf3_bigtcp_{cc_algo}.json"
+        with open(logFile, 'w') as f:
+            f.write(out)
+        with open(f"/tmp/ss_bigtcp_{cc_algo}.json", 'w') as f:
+            json.dump(samples, f)
+
+        try:
+            bps = json.loads(out)["end"]["sum_sent"]["bits_per_second"]
+        except (ValueError, KeyError):
+            bps = 0
+
+        by_flow, problems = check_samples(samples)
+        print(f"\n=== BIG TCP validation: {cc_algo}, RTT {rtt_ms} ms, {streams} streams ===")
+        print(f"Throughput: {bps / 1e9:.2f} Gbps")
+        for flow, seq in by_flow.items():
+            cwnds = [s.get('cwnd', 0) for s in seq]
+            print(f"{flow}: max cwnd {max(cwnds)}, final cwnd {cwnds[-1]}, "
+                  f"retrans {seq[-1].get('retrans', 0)}")
+        if problems:
+            print(f"❌ {len(problems)} anomalies:")
+            for p in problems[:20]:
+                print(f"  - {p}")
+        else:
+            print("✅ No cwnd/ssthresh anomalies")
+        return not problems
+    finally:
+        ns(RCV_NS, "pkill iperf3", check=False)
+        teardown()
+
+
+if __name__ == '__main__':
+    cc_algo = sys.argv[1] if len(sys.argv) > 1 else 'reno_custom'
+    rtt_ms = float(sys.argv[2]) if len(sys.argv) > 2 else 100
+    streams = int(sys.argv[3]) if len(sys.argv) > 3 else 4
+    sys.exit(0 if run(cc_algo, rtt_ms, streams) else 1)
@@ -0,0 +1,117 @@
+"""
+linkemu 용 패킷 단위 손상 패턴 생성기 (seed 고정 손실 + 지터)
+
+  python3 gen_impair.py <출력파일> [손실%] [버스트] [지터ms] [seed] [패킷 수]
+
+- 한 줄 = 링크를 통과하는 패킷 하나의 운명: "-" 면 손실, 아니면 추가 지연(µs)
+  "값 개수" 로 같은 값이 이어지는 구간을 압축 (gen_trace.py 의 확장 형식과 같은 방식)
+  linkemu -i/-I 로 방향별 패턴을 주면 n 번째 패킷이 패턴 n 번째 줄을 따르고 끝나면 처음부터 반복
+- 손실: 버스트 <= 1 이면 독립(Bernoulli), 크면 평균 버스트 길이가 그 값인 Gilbert-Elliott
+  (나쁜 상태는 전부 손실, 장기 손실률 = 손실%) — reno_sim / exp_scenario.py 와 같은 모델
+- 지터: 0 ~ 지터ms 균등 추가 지연. linkemu 지연 라인은 기본 FIFO 라 패킷이 앞 패킷보다 먼저
+  나가지 못해 실제 지연 = 지금까지의 최댓값. 지터 창 하나에 패킷이 여러 개 지나가는 속도면
+  균등 지터가 거의 일정한 +지터ms 로 뭉개짐 (아래 통계의 FIFO 적용 평균, linkemu 로그의
+  extra_avg_us 로 확인). 지터 분포를 그대로 쓰려면 linkemu -R (재정렬 허용, netem 과 같음)
+- 같은 seed 면 비트 단위로 같은 파일 → reno / reno_custom 을 같은 손상 순서로 짝지어 비교
+"""
+
+import random
+import sys
+
+DEFAULT_PKTS = 200000     # 약 2.4 Gbit 분량, 넘으면 반복
+FIFO_REPORT_PPS = (100, 1000, 10000)   # 1500B 기준 약 1.2 / 12 / 120 Mbit/s
+
+
+def generate(loss_pct=0.0, burst=1.0, jitter_ms=0.0, seed=1, pkts=DEFAULT_PKTS):
+    """패킷별 [None(손실) | 추가 지연 µs, ...]"""
+    rng = random.Random(seed)
+    q = loss_pct / 100.0
+    if burst > 1:
+        p_bg = 1.0 / burst
+        p_gb = q * p_bg / (1.0 - q) if q < 1 else 1.0
+    bad = False
+    jitter_us = int(jitter_ms * 1000)
+    out = []
+    for _ in range(pkts):
+        if burst > 1:
+            bad = rng.random() >= p_bg if bad else rng.random() < p_gb
+            lost = bad
+        else:
+            lost = q > 0 and rng.random() < q
+        # 손실 여부와 무관하게 지터 난수를 뽑아 손실률만 바꿔도 지터 순서는 같게
+        extra = rng.randint(0, jitter_us) if jitter_us else 0
+        out.append(None if lost else extra)
+    return out
+
+
+def write_pattern(path, pattern):
+    with open(path, 'w') as f:
+        prev, run = None, 0
+        for v in pattern + ['end']:
+            if run and v == prev:
+                run += 1
+                continue
+            if run:
+                val = '-' if prev is None else str(prev)
+                f.write(f"{val} {run}\n" if run > 1 else f"{val}\n")
+            prev, run = v, 1
+
+
+def fifo_extra_ms(pattern, pps):
+    """pps 로 고르게 도착할 때 FIFO 지연 라인이 실제로 주는 평균 추가 지연 (ms)"""
+    gap_us = 1e6 / pps
+    depart = total = 0.0
+    n = 0
+    for i, extra in enumerate(pattern):
+        if extra is None:
+            continue
+        t = i * gap_us
+        depart = max(depart, t + extra)
+        total += depart - t
+        n += 1
+    return total / n / 1000 if n else 0.0
+
+
+def pattern_stats(path):
+    """(패킷 수, 손실률 %, 평균 버스트 길이, 생성된 평균 추가 지연 ms)"""
+    n = lost = bursts = 0
+    delay = 0
+    prev_lost = False
+    with open(path) as f:
+        for line in f:
+            parts = line.split()
+            if not parts:
+                continue
+            cnt = int(parts[1]) if len(parts) > 1 else 1
+            n += cnt
+            if parts[0] == '-':
+                lost += cnt
+                bursts += not prev_lost
+                prev_lost = True
+            else:
+                delay += int(parts[0]) * cnt
+                prev_lost = False
+    return (n, lost * 100.0 / n if n else 0.0, lost / bursts if bursts else 0.0,
+            delay / (n - lost) / 1000 if n > lost else 0.0)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("usage: gen_impair.py <out> [loss_pct] [burst] [jitter_ms] [seed] [pkts]")
+        sys.exit(1)
+    out = sys.argv[1]
+    loss = float(sys.argv[2]) if len(sys.argv) > 2 else 0.0
+    burst = float(sys.argv[3]) if len(sys.argv) > 3 else 1.0
+    jitter = float(sys.argv[4]) if len(sys.argv) > 4 else 0.0
+    seed = int(sys.argv[5]) if len(sys.argv) > 5 else 1
+    pkts = int(sys.argv[6]) if len(sys.argv) > 6 else DEFAULT_PKTS
+
+    pattern = generate(loss, burst, jitter, seed, pkts)
+    write_pattern(out, pattern)
+    n, lp, b, d = pattern_stats(out)
+    print(f"{out}: {n} pkts, loss {lp:.3f}%, mean burst {b:.2f}, "
+          f"generated mean extra delay {d:.2f} ms")
+    if jitter > 0:
+        applied = ', '.join(f"{fifo_extra_ms(pattern, pps):.2f} ms at {pps} pkt/s"
+                            for pps in FIFO_REPORT_PPS)
+        print(f"  applied by a FIFO delay line (linkemu without -R): {applied}")
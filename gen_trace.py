@@ -0,0 +1,105 @@
+"""
+linkemu 용 전달 기회 트레이스 생성기 (셀룰러/Wi-Fi 풍 가변 용량)
+
+  python3 gen_trace.py <출력파일> <평균 Mbit/s> [길이(초)] [seed] [--mahimahi]
+
+- 마르코프 체인으로 상태(good/fair/poor/outage)를 오가며 ms 단위 용량을 생성
+- 생성 후 전체 평균이 <평균 Mbit/s> 가 되도록 스케일
+- 기본 출력은 압축 형식 "ms 개수" (linkemu 전용),
+  --mahimahi 면 한 줄에 전달 기회 하나 (Mahimahi 와 호환)
+"""
+
+import random
+import sys
+
+MTU_BITS = 1500 * 8
+
+# 상태: (상대 용량, 평균 체류 시간 ms)
+STATES = {
+    'good':   (1.6, 400),
+    'fair':   (1.0, 300),
+    'poor':   (0.4, 200),
+    'outage': (0.0, 40),
+}
+TRANSITIONS = {
+    'good':   [('fair', 0.8), ('poor', 0.2)],
+    'fair':   [('good', 0.45), ('poor', 0.45), ('outage', 0.1)],
+    'poor':   [('fair', 0.7), ('outage', 0.3)],
+    'outage': [('poor', 0.6), ('fair', 0.4)],
+}
+
+
+def _next_state(rng, state):
+    r = rng.random()
+    for nxt, p in TRANSITIONS[state]:
+        r -= p
+        if r <= 0:
+            return nxt
+    return TRANSITIONS[state][-1][0]
+
+
+def generate(mean_mbps, seconds=60, seed=1):
+    """ms 별 전달 기회 개수 목록 (평균이 mean_mbps 가 되도록 스케일)"""
+    rng = random.Random(seed)
+    total_ms = int(seconds * 1000)
+    rel = []
+    state = 'fair'
+    while len(rel) < total_ms:
+        level, dwell = STATES[state]
+        length = max(1, int(rng.expovariate(1.0 / dwell)))
+        for _ in range(length):
+            # 상태 내 빠른 변동 (페이딩)
+            rel.append(level * rng.uniform(0.7, 1.3))
+        state = _next_state(rng, state)
+    rel = rel[:total_ms]
+
+    # 목표 평균으로 스케일 후 소수부는 누적해서 정수 개수로
+    target_per_ms = mean_mbps * 1e6 / 1000 / MTU_BITS
+    scale = target_per_ms * total_ms / sum(rel) if sum(rel) > 0 else 0
+    counts, acc = [], 0.0
+    for v in rel:
+        acc += v * scale
+        n = int(acc)
+        acc -= n
+        counts.append(n)
+    return counts
+
+
+def write_trace(path, counts, mahimahi=False):
+    with open(path, 'w') as f:
+        for ms, n in enumerate(counts, start=1):
+            if mahimahi:
+                f.writelines(f"{ms}\n" for _ in range(n))
+            elif n:
+                f.write(f"{ms} {n}\n")
+        # 주기 = 마지막 시각 이므로 마지막 ms 는 항상 기록
+        if not counts[-1]:
+            f.write(f"{len(counts)} 0\n" if not mahimahi else f"{len(counts)}\n")
+
+
+def trace_mean_mbps(path):
+    """트레이스 파일의 평균 용량 (Mbit/s)"""
+    opps, last = 0, 0
+    with open(path) as f:
+        for line in f:
+            parts = line.split()
+            if not parts:
+                continue
+            last = int(parts[0])
+            opps += int(parts[1]) if len(parts) > 1 else 1
+    return opps * MTU_BITS / (last / 1000) / 1e6 if last else 0.0
+
+
+if __name__ == "__main__":
+    args = [a for a in sys.argv[1:] if not a.startswith('--')]
+    if len(args) < 2:
+        print("usage: gen_trace.py <out> <mean_mbps> [seconds] [seed] [--mahimahi]")
+        sys.exit(1)
+    out = args[0]
+    mean = float(args[1])
+    seconds = float(args[2]) if len(args) > 2 else 60
+    seed = int(args[3]) if len(args) > 3 else 1
+
+    counts = generate(mean, seconds, seed)
+    write_trace(out, counts, mahimahi='--mahimahi' in sys.argv)
+    print(f"{out}: {len(counts)} ms, mean {trace_mean_mbps(out):.1f} Mbit/s")
@@ -0,0 +1,55 @@
+#!/bin/bash
+# tcp_ca_direct_calls.patch 가 기준 커널에 적용되고 reno_custom 빌트인(=y) + retpoline 으로 빌드되는지 확인
+# 커널 git 트리의 임시 worktree 에서 net/ipv4/ 만 빌드 (원래 트리는 건드리지 않음)
+# 사용법: ./kpatch_check.sh <커널 git 트리> [태그]   (기본 v6.6, 패치 머리말의 기준 커널)
+
+set -e
+
+KSRC=$1
+BASE=${2:-v6.6}
+HERE=$(cd "$(dirname "$0")" && pwd)
+
+if [ -z "$KSRC" ] || ! git -C "$KSRC" rev-parse --git-dir > /dev/null 2>&1; then
+    echo "usage: $0 <kernel git tree> [tag]"
+    exit 1
+fi
+
+WT=$(mktemp -d /tmp/kpatch_check.XXXXXX)
+trap 'git -C "$KSRC" worktree remove --force "$WT"' EXIT
+git -C "$KSRC" worktree add --detach "$WT" "$BASE"
+cd "$WT"
+
+echo "Applying tcp_ca_direct_calls.patch to $BASE..."
+git apply --verbose "$HERE/tcp_ca_direct_calls.patch"
+
+# Kconfig 안내대로 소스 복사 + Kconfig/Makefile 항목 추가 (Kconfig 항목은 TCP_CONG_BBR 앞)
+cp "$HERE/reno_custom.c" "$HERE/reno_custom_core.h" "$HERE/reno_custom_repair.h" net/ipv4/
+awk -v f="$HERE/Kconfig" '/^config TCP_CONG_BBR$/ { while ((getline l < f) > 0) if (l !~ /^#/) print l; print "" } { print }' \
+    net/ipv4/Kconfig > net/ipv4/Kconfig.new
+mv net/ipv4/Kconfig.new net/ipv4/Kconfig
+echo 'obj-$(CONFIG_TCP_CONG_RENO_CUSTOM) += reno_custom.o' >> net/ipv4/Makefile
+
+make -s defconfig
+scripts/config -e TCP_CONG_ADVANCED -e TCP_CONG_RENO_CUSTOM -e RETPOLINE -e MITIGATION_RETPOLINE
+make -s olddefconfig
+if ! grep -q '^CONFIG_TCP_CONG_RENO_CUSTOM=y' .config; then
+    echo "CONFIG_TCP_CONG_RENO_CUSTOM=y did not survive olddefconfig"
+    exit 1
+fi
+
+echo "Building net/ipv4/..."
+make -j"$(nproc)" net/ipv4/
+
+# 직접 호출 대상이 전역 심볼이어야 tcp_input.o 의 INDIRECT_CALL 이 vmlinux 에서 링크됨
+for sym in reno_custom_pkts_acked reno_custom_cong_avoid; do
+    if ! nm net/ipv4/reno_custom.o | grep -q " T $sym$"; then
+        echo "$sym is not a global symbol in reno_custom.o"
+        exit 1
+    fi
+done
+if ! nm net/ipv4/tcp_input.o | grep -q " U reno_custom_pkts_acked$"; then
+    echo "tcp_input.o does not call reno_custom_pkts_acked directly"
+    exit 1
+fi
+
+echo "OK: patch applies to $BASE and builds with reno_custom built in"
@@ -0,0 +1,716 @@
+/*
+ * linkemu: 트레이스 기반 가변 용량 링크 에뮬레이터 (TUN, 유저스페이스)
+ *
+ *   ./linkemu -u up.trace -d down.trace [-D 지연ms] [-q droptail|drophead|codel]
+ *             [-p 큐패킷 | -B 큐바이트] [-l log.csv] [-L 로그간격ms]
+ *             [-a le0] [-b le1] [-n 배치] [-i up.pat] [-I down.pat] [-R]
+ *
+ * - TUN 장치 두 개(a, b)를 만들고 a→b 는 up 트레이스, b→a 는 down 트레이스로 전달
+ *   러너가 장치를 각 네임스페이스로 옮긴다 (ip link set le0 netns X, fd 는 그대로 유효)
+ * - 트레이스 형식: Mahimahi 와 같이 한 줄 = 1500바이트 전달 기회의 ms 시각,
+ *   또는 확장 형식 "ms 개수". 마지막 시각을 주기로 반복한다.
+ * - 전달 기회가 큐가 빈 상태로 지나가면 버려짐 (무선 링크처럼)
+ * - IFF_VNET_HDR + 오프로드로 GSO 패킷(최대 64KB)을 그대로 받아 처리해
+ *   시스템콜 당 바이트를 늘림 (멀티 Gbit/s)
+ * - 손상 패턴(-i/-I, gen_impair.py): 병목을 나온 n 번째 패킷이 패턴 n 번째 항목에 따라
+ *   손실되거나 추가 지연을 받음 (끝나면 반복). netem 난수와 달리 실행마다 같은 순서라
+ *   알고리즘끼리 같은 손실/지터 순서로 짝지어 비교 가능. 패킷 번호가 세그먼트 단위가
+ *   되도록 패턴을 쓰면 GSO 오프로드를 끔 (대신 최대 속도는 낮아짐)
+ * - 지연 라인은 기본 FIFO: 패킷은 지금까지 출력 시각의 최댓값에 나감. 지터 창(J) 하나에
+ *   패킷이 여러 개 지나가는 속도면 0..J 균등 지터가 거의 일정한 +J 지연으로 뭉개짐
+ *   (로그의 extra_avg_us 로 실제 적용된 추가 지연을 확인). -R 이면 출력 시각 순으로 끼워
+ *   넣어 재정렬을 허용 (netem 지터와 같은 동작, 패턴의 지연 분포가 그대로 적용됨)
+ * - 큐별 로그(CSV): 구간마다 입력/출력/드롭/큐 길이/제공 용량/최대 체류 시간/패턴 손실/
+ *   지연 라인에서 실제 적용된 추가 지연(평균, 최대)
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <linux/if.h>
+#include <linux/if_tun.h>
+#include <linux/virtio_net.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LE_MTU              1500U
+#define LE_MAX_PKT          (65536 + sizeof(struct virtio_net_hdr))
+#define LE_DEFAULT_QPKTS    1000U
+#define LE_CODEL_TARGET_NS  5000000ULL
+#define LE_CODEL_INTVL_NS   100000000ULL
+
+enum { Q_DROPTAIL, Q_DROPHEAD, Q_CODEL };
+
+struct pkt {
+    struct pkt *next, *prev;
+    uint64_t t_ns;          /* 큐: 입력 시각, 지연 라인: 출력 시각 */
+    uint32_t len;           /* IP 패킷 길이 (vnet 헤더 제외) */
+    uint32_t buflen;        /* vnet 헤더 포함 */
+    unsigned char buf[];
+};
+
+struct pktq {
+    struct pkt *head, *tail;
+    uint32_t pkts;
+    uint64_t bytes;
+};
+
+struct trace {
+    uint32_t *ms;           /* 전달 기회 시각 (ms, 중복 = 같은 ms 에 여러 번) */
+    size_t n;
+    uint64_t period_ns;
+    size_t idx;
+    uint64_t base_ns;       /* 현재 반복 시작 시각 */
+};
+
+/* 패킷별 손상: LE_IMP_LOST 면 손실, 아니면 추가 지연 (µs) */
+#define LE_IMP_LOST         (-1)
+
+struct impair {
+    int32_t *v;
+    size_t n;
+    size_t idx;
+};
+
+struct stats {
+    uint64_t enq_pkts, enq_bytes, deq_pkts, deq_bytes, drops, opps, lost;
+    uint64_t max_sojourn_ns;
+    uint64_t extra_sum_ns, extra_max_ns;    /* 지연 라인: 기본 지연을 넘는 실제 추가 지연 */
+};
+
+struct dir {
+    const char *name;
+    int in_fd, out_fd;
+    struct trace tr;
+    struct impair imp;
+    struct pktq q, delay;
+    uint64_t next_opp_ns;
+    uint64_t credit;
+
+    /* CoDel 상태 */
+    uint64_t first_above_ns, drop_next_ns;
+    uint32_t drop_count, last_count;
+    int dropping;
+
+    struct stats iv, total;
+};
+
+static struct {
+    int qdisc;
+    uint32_t qlimit_pkts;
+    uint64_t qlimit_bytes;
+    uint64_t delay_ns;
+    int batch;
+    int reorder;
+} cfg = { Q_DROPTAIL, LE_DEFAULT_QPKTS, 0, 0, 32, 0 };
+
+static volatile sig_atomic_t stop_flag;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop_flag = 1;
+}
+
+/* ------------------------------------------------------------------ */
+
+static int load_trace(const char *path, struct trace *tr)
+{
+    FILE *f = fopen(path, "r");
+    size_t cap = 1024;
+    char line[128];
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    tr->ms = malloc(cap * sizeof(uint32_t));
+    tr->n = 0;
+
+    while (tr->ms && fgets(line, sizeof(line), f)) {
+        unsigned long t, cnt = 1;
+        int k = sscanf(line, "%lu %lu", &t, &cnt);
+
+        if (k < 1)
+            continue;
+        if (tr->n && t < tr->ms[tr->n - 1]) {
+            fprintf(stderr, "%s: timestamps must be non-decreasing\n", path);
+            fclose(f);
+            return -1;
+        }
+        while (cnt--) {
+            if (tr->n == cap) {
+                uint32_t *ms = realloc(tr->ms, cap * 2 * sizeof(uint32_t));
+
+                if (!ms) {
+                    free(tr->ms);
+                    tr->ms = NULL;
+                    break;
+                }
+                tr->ms = ms;
+                cap *= 2;
+            }
+            tr->ms[tr->n++] = (uint32_t)t;
+        }
+    }
+    fclose(f);
+
+    if (!tr->ms || tr->n == 0 || tr->ms[tr->n - 1] == 0) {
+        fprintf(stderr, "%s: empty trace or zero period\n", path);
+        return -1;
+    }
+    tr->period_ns = (uint64_t)tr->ms[tr->n - 1] * 1000000ULL;
+    return 0;
+}
+
+/* gen_impair.py 형식: 줄마다 "-" (손실) 또는 추가 지연 µs, 뒤에 선택적 반복 개수 */
+static int load_pattern(const char *path, struct impair *imp)
+{
+    FILE *f = fopen(path, "r");
+    size_t cap = 1024;
+    char line[128];
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    imp->v = malloc(cap * sizeof(int32_t));
+    imp->n = 0;
+
+    while (imp->v && fgets(line, sizeof(line), f)) {
+        char val[32];
+        unsigned long cnt = 1;
+        int32_t v;
+        int k = sscanf(line, "%31s %lu", val, &cnt);
+
+        if (k < 1)
+            continue;
+        v = !strcmp(val, "-") ? LE_IMP_LOST : (int32_t)atol(val);
+        if (v < 0 && v != LE_IMP_LOST) {
+            fprintf(stderr, "%s: negative delay\n", path);
+            fclose(f);
+            return -1;
+        }
+        while (cnt--) {
+            if (imp->n == cap) {
+                int32_t *v2 = realloc(imp->v, cap * 2 * sizeof(int32_t));
+
+                if (!v2) {
+                    free(imp->v);
+                    imp->v = NULL;
+                    break;
+                }
+                imp->v = v2;
+                cap *= 2;
+            }
+            imp->v[imp->n++] = v;
+        }
+    }
+    fclose(f);
+
+    if (!imp->v || imp->n == 0) {
+        fprintf(stderr, "%s: empty pattern\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+/* 다음 패킷의 손상 (패턴이 없으면 0 = 그대로 통과) */
+static int32_t impair_next(struct impair *imp)
+{
+    int32_t v;
+
+    if (!imp->n)
+        return 0;
+    v = imp->v[imp->idx];
+    if (++imp->idx == imp->n)
+        imp->idx = 0;
+    return v;
+}
+
+static uint64_t trace_next(struct trace *tr)
+{
+    uint64_t t = tr->base_ns + (uint64_t)tr->ms[tr->idx] * 1000000ULL;
+
+    if (++tr->idx == tr->n) {
+        tr->idx = 0;
+        tr->base_ns += tr->period_ns;
+    }
+    return t;
+}
+
+/* ------------------------------------------------------------------ */
+
+static void q_push(struct pktq *q, struct pkt *p)
+{
+    p->next = NULL;
+    p->prev = q->tail;
+    if (q->tail)
+        q->tail->next = p;
+    else
+        q->head = p;
+    q->tail = p;
+    q->pkts++;
+    q->bytes += p->len;
+}
+
+static struct pkt *q_pop(struct pktq *q)
+{
+    struct pkt *p = q->head;
+
+    if (!p)
+        return NULL;
+    q->head = p->next;
+    if (q->head)
+        q->head->prev = NULL;
+    else
+        q->tail = NULL;
+    q->pkts--;
+    q->bytes -= p->len;
+    return p;
+}
+
+/*
+ * 지연 라인에 넣기. 기본(FIFO)은 앞 패킷보다 일찍 나갈 시각이면 앞 패킷 시각으로 늦춤,
+ * -R 이면 출력 시각 순서 자리에 끼워 넣음 (지터 창 안의 패킷만 뒤에서부터 훑음)
+ */
+static void delay_push(struct pktq *q, struct pkt *p)
+{
+    struct pkt *at = q->tail;
+
+    if (!at || at->t_ns <= p->t_ns) {
+        q_push(q, p);
+        return;
+    }
+    if (!cfg.reorder) {
+        p->t_ns = at->t_ns;
+        q_push(q, p);
+        return;
+    }
+    while (at && at->t_ns > p->t_ns)
+        at = at->prev;
+    p->prev = at;
+    p->next = at ? at->next : q->head;
+    p->next->prev = p;
+    if (at)
+        at->next = p;
+    else
+        q->head = p;
+    q->pkts++;
+    q->bytes += p->len;
+}
+
+static int q_full(const struct pktq *q, uint32_t len)
+{
+    if (cfg.qlimit_bytes)
+        return q->bytes + len > cfg.qlimit_bytes;
+    return q->pkts >= cfg.qlimit_pkts;
+}
+
+static void drop(struct dir *d, struct pkt *p)
+{
+    d->iv.drops++;
+    d->total.drops++;
+    free(p);
+}
+
+static void enqueue(struct dir *d, struct pkt *p, uint64_t now)
+{
+    p->t_ns = now;
+    d->iv.enq_pkts++;
+    d->iv.enq_bytes += p->len;
+    d->total.enq_pkts++;
+    d->total.enq_bytes += p->len;
+
+    if (q_full(&d->q, p->len)) {
+        if (cfg.qdisc == Q_DROPHEAD && d->q.head) {
+            drop(d, q_pop(&d->q));
+        } else {
+            drop(d, p);
+            return;
+        }
+    }
+    q_push(&d->q, p);
+}
+
+/* RFC 8289 control law: interval / sqrt(count) */
+static uint64_t codel_next(uint64_t t, uint32_t count)
+{
+    uint64_t s = 1;
+
+    while ((s + 1) * (s + 1) <= count)
+        s++;
+    return t + LE_CODEL_INTVL_NS / s;
+}
+
+static int codel_ok_to_drop(struct dir *d, struct pkt *p, uint64_t now)
+{
+    uint64_t sojourn = now > p->t_ns ? now - p->t_ns : 0;
+
+    if (sojourn < LE_CODEL_TARGET_NS || d->q.bytes <= LE_MTU) {
+        d->first_above_ns = 0;
+        return 0;
+    }
+    if (!d->first_above_ns) {
+        d->first_above_ns = now + LE_CODEL_INTVL_NS;
+        return 0;
+    }
+    return now >= d->first_above_ns;
+}
+
+/*
+ * CoDel: 꺼내기 직전의 맨 앞 패킷에 체류 시간 기반 드롭을 적용. 한 번에 하나만 드롭하고
+ * 1 을 돌려줌. 새 맨 앞은 serve() 가 도착 시각과 크레딧을 다시 확인한 뒤 여기로 다시 옴
+ * (드롭 상태의 연속 드롭도 이 반복으로 처리)
+ */
+static int codel_drop_head(struct dir *d, uint64_t now)
+{
+    int drop_ok;
+
+    if (cfg.qdisc != Q_CODEL)
+        return 0;
+
+    drop_ok = codel_ok_to_drop(d, d->q.head, now);
+    if (d->dropping) {
+        if (!drop_ok) {
+            d->dropping = 0;
+            return 0;
+        }
+        if (now < d->drop_next_ns)
+            return 0;
+        drop(d, q_pop(&d->q));
+        d->drop_count++;
+        d->drop_next_ns = codel_next(d->drop_next_ns, d->drop_count);
+        return 1;
+    }
+    if (!drop_ok)
+        return 0;
+
+    drop(d, q_pop(&d->q));
+    d->dropping = 1;
+    /* 최근에 드롭 상태였으면 이전 count 근처에서 재시작 */
+    if (d->drop_count > d->last_count + 2 &&
+        now - d->drop_next_ns < 16 * LE_CODEL_INTVL_NS)
+        d->drop_count = d->drop_count - d->last_count;
+    else
+        d->drop_count = 1;
+    d->last_count = d->drop_count;
+    d->drop_next_ns = codel_next(now, d->drop_count);
+    return 1;
+}
+
+/* 지난 전달 기회들을 처리해 큐 → 지연 라인으로 이동 */
+static void serve(struct dir *d, uint64_t now)
+{
+    while (d->next_opp_ns <= now) {
+        uint64_t t = d->next_opp_ns;
+
+        d->iv.opps++;
+        d->total.opps++;
+        d->next_opp_ns = trace_next(&d->tr);
+
+        /*
+         * 빈 큐에서 지나간 기회는 버림. 패킷이 도착하면 그때까지 밀린 기회를 한꺼번에
+         * 처리하므로, 맨 앞 패킷보다 이른 기회도 빈 큐였던 시점이라 버림
+         */
+        if (!d->q.head || d->q.head->t_ns > t) {
+            d->credit = 0;
+            continue;
+        }
+
+        d->credit += LE_MTU;
+        while (d->q.head && d->q.head->t_ns <= t && d->q.head->len <= d->credit) {
+            struct pkt *p;
+            uint64_t sojourn, extra;
+            int32_t imp;
+
+            if (codel_drop_head(d, t))
+                continue;
+            p = q_pop(&d->q);
+            sojourn = t > p->t_ns ? t - p->t_ns : 0;
+            if (sojourn > d->iv.max_sojourn_ns)
+                d->iv.max_sojourn_ns = sojourn;
+            d->credit -= p->len;
+            d->iv.deq_pkts++;
+            d->iv.deq_bytes += p->len;
+            d->total.deq_pkts++;
+            d->total.deq_bytes += p->len;
+
+            /* 병목 용량은 쓰고 나서 링크 위에서 손실 */
+            imp = impair_next(&d->imp);
+            if (imp == LE_IMP_LOST) {
+                d->iv.lost++;
+                d->total.lost++;
+                free(p);
+                continue;
+            }
+            p->t_ns = t + cfg.delay_ns + (uint64_t)imp * 1000ULL;
+            delay_push(&d->delay, p);
+            extra = p->t_ns - t - cfg.delay_ns;
+            d->iv.extra_sum_ns += extra;
+            d->total.extra_sum_ns += extra;
+            if (extra > d->iv.extra_max_ns)
+                d->iv.extra_max_ns = extra;
+            if (extra > d->total.extra_max_ns)
+                d->total.extra_max_ns = extra;
+        }
+        if (!d->q.head || d->q.head->t_ns > t)
+            d->credit = 0;
+    }
+}
+
+static void release(struct dir *d, uint64_t now)
+{
+    while (d->delay.head && d->delay.head->t_ns <= now) {
+        struct pkt *p = q_pop(&d->delay);
+
+        if (write(d->out_fd, p->buf, p->buflen) < 0 && errno != EAGAIN && errno != EIO)
+            perror("linkemu: write");
+        free(p);
+    }
+}
+
+static void ingest(struct dir *d, unsigned char *scratch, uint64_t now)
+{
+    int i;
+
+    for (i = 0; i < cfg.batch; i++) {
+        ssize_t n = read(d->in_fd, scratch, LE_MAX_PKT);
+        struct pkt *p;
+
+        if (n <= (ssize_t)sizeof(struct virtio_net_hdr))
+            break;
+        p = malloc(sizeof(*p) + n);
+        if (!p)
+            break;
+        memcpy(p->buf, scratch, n);
+        p->buflen = (uint32_t)n;
+        p->len = (uint32_t)(n - sizeof(struct virtio_net_hdr));
+        enqueue(d, p, now);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+
+static int tun_open(const char *name, int gso)
+{
+    struct ifreq ifr;
+    int fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+    unsigned int offload = TUN_F_CSUM | TUN_F_TSO4 | TUN_F_TSO6 | TUN_F_TSO_ECN;
+
+    if (fd < 0) {
+        perror("/dev/net/tun");
+        return -1;
+    }
+    memset(&ifr, 0, sizeof(ifr));
+    ifr.ifr_flags = IFF_TUN | IFF_NO_PI | IFF_VNET_HDR;
+    strncpy(ifr.ifr_name, name, IFNAMSIZ - 1);
+    if (ioctl(fd, TUNSETIFF, &ifr) < 0) {
+        perror("TUNSETIFF");
+        close(fd);
+        return -1;
+    }
+    /* GSO/체크섬 오프로드를 받아야 큰 패킷 단위로 처리 가능 */
+    if (gso && ioctl(fd, TUNSETOFFLOAD, offload) < 0)
+        perror("TUNSETOFFLOAD (continuing without GSO)");
+    return fd;
+}
+
+/* 지연 라인에 들어간 패킷당 평균 추가 지연 (µs) */
+static uint64_t extra_avg_us(const struct stats *st)
+{
+    uint64_t n = st->deq_pkts - st->lost;
+
+    return n ? st->extra_sum_ns / n / 1000 : 0;
+}
+
+static void log_interval(FILE *log, struct dir *d, uint64_t t_ms)
+{
+    if (log)
+        fprintf(log, "%llu,%s,%llu,%llu,%llu,%llu,%llu,%u,%llu,%llu,%llu,%llu,%llu,%llu\n",
+                (unsigned long long)t_ms, d->name,
+                (unsigned long long)d->iv.enq_pkts, (unsigned long long)d->iv.enq_bytes,
+                (unsigned long long)d->iv.deq_pkts, (unsigned long long)d->iv.deq_bytes,
+                (unsigned long long)d->iv.drops, d->q.pkts,
+                (unsigned long long)d->q.bytes,
+                (unsigned long long)d->iv.opps * LE_MTU,
+                (unsigned long long)d->iv.max_sojourn_ns / 1000,
+                (unsigned long long)d->iv.lost,
+                (unsigned long long)extra_avg_us(&d->iv),
+                (unsigned long long)d->iv.extra_max_ns / 1000);
+    memset(&d->iv, 0, sizeof(d->iv));
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: linkemu -u up.trace -d down.trace [-D delay_ms] [-q droptail|drophead|codel]\n"
+            "               [-p queue_pkts | -B queue_bytes] [-l log.csv] [-L log_ms]\n"
+            "               [-a dev_a] [-b dev_b] [-n batch] [-i up.pat] [-I down.pat] [-R]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    const char *up = NULL, *down = NULL, *log_path = NULL;
+    const char *up_pat = NULL, *down_pat = NULL;
+    const char *dev_a = "le0", *dev_b = "le1";
+    uint64_t log_ns = 100000000ULL, start, next_log;
+    struct dir dirs[2];
+    unsigned char *scratch;
+    FILE *log = NULL;
+    int fd_a, fd_b, c, i;
+
+    while ((c = getopt(argc, argv, "u:d:D:q:p:B:l:L:a:b:n:i:I:R")) != -1) {
+        switch (c) {
+        case 'u': up = optarg; break;
+        case 'd': down = optarg; break;
+        case 'D': cfg.delay_ns = (uint64_t)(atof(optarg) * 1e6); break;
+        case 'p': cfg.qlimit_pkts = (uint32_t)atoi(optarg); break;
+        case 'B': cfg.qlimit_bytes = strtoull(optarg, NULL, 10); break;
+        case 'l': log_path = optarg; break;
+        case 'L': log_ns = (uint64_t)(atof(optarg) * 1e6); break;
+        case 'a': dev_a = optarg; break;
+        case 'b': dev_b = optarg; break;
+        case 'n': cfg.batch = atoi(optarg); break;
+        case 'i': up_pat = optarg; break;
+        case 'I': down_pat = optarg; break;
+        case 'R': cfg.reorder = 1; break;
+        case 'q':
+            if (!strcmp(optarg, "droptail"))
+                cfg.qdisc = Q_DROPTAIL;
+            else if (!strcmp(optarg, "drophead"))
+                cfg.qdisc = Q_DROPHEAD;
+            else if (!strcmp(optarg, "codel"))
+                cfg.qdisc = Q_CODEL;
+            else
+                usage();
+            break;
+        default:
+            usage();
+        }
+    }
+    if (!up || !down || cfg.batch < 1 || !log_ns)
+        usage();
+
+    memset(dirs, 0, sizeof(dirs));
+    if (load_trace(up, &dirs[0].tr) < 0 || load_trace(down, &dirs[1].tr) < 0)
+        return 1;
+    if ((up_pat && load_pattern(up_pat, &dirs[0].imp) < 0) ||
+        (down_pat && load_pattern(down_pat, &dirs[1].imp) < 0))
+        return 1;
+
+    /* 패턴 항목 = MTU 세그먼트 하나가 되도록 패턴이 있으면 GSO 를 받지 않음 */
+    fd_a = tun_open(dev_a, !up_pat && !down_pat);
+    fd_b = tun_open(dev_b, !up_pat && !down_pat);
+    if (fd_a < 0 || fd_b < 0)
+        return 1;
+
+    if (log_path) {
+        log = fopen(log_path, "w");
+        if (!log) {
+            perror(log_path);
+            return 1;
+        }
+        fprintf(log, "t_ms,dir,enq_pkts,enq_bytes,deq_pkts,deq_bytes,drops,"
+                     "qlen_pkts,qlen_bytes,cap_bytes,max_sojourn_us,lost,extra_avg_us,extra_max_us\n");
+    }
+
+    scratch = malloc(LE_MAX_PKT);
+    if (!scratch)
+        return 1;
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    start = now_ns();
+    dirs[0].name = "up";
+    dirs[0].in_fd = fd_a;
+    dirs[0].out_fd = fd_b;
+    dirs[1].name = "down";
+    dirs[1].in_fd = fd_b;
+    dirs[1].out_fd = fd_a;
+    for (i = 0; i < 2; i++) {
+        dirs[i].tr.base_ns = start;
+        dirs[i].next_opp_ns = trace_next(&dirs[i].tr);
+    }
+    next_log = start + log_ns;
+
+    printf("linkemu: %s <-> %s ready\n", dev_a, dev_b);
+    fflush(stdout);
+
+    while (!stop_flag) {
+        struct pollfd pfd[2] = { { fd_a, POLLIN, 0 }, { fd_b, POLLIN, 0 } };
+        uint64_t now = now_ns(), wake = next_log;
+        struct timespec ts;
+
+        for (i = 0; i < 2; i++) {
+            struct dir *d = &dirs[i];
+
+            serve(d, now);
+            release(d, now);
+            if (d->q.head && d->next_opp_ns < wake)
+                wake = d->next_opp_ns;
+            if (d->delay.head && d->delay.head->t_ns < wake)
+                wake = d->delay.head->t_ns;
+        }
+
+        if (now >= next_log) {
+            uint64_t t_ms = (now - start) / 1000000ULL;
+
+            log_interval(log, &dirs[0], t_ms);
+            log_interval(log, &dirs[1], t_ms);
+            if (log)
+                fflush(log);
+            next_log += log_ns;
+            continue;
+        }
+
+        wake = wake > now ? wake - now : 0;
+        ts.tv_sec = wake / 1000000000ULL;
+        ts.tv_nsec = wake % 1000000000ULL;
+        if (ppoll(pfd, 2, &ts, NULL) <= 0)
+            continue;
+
+        now = now_ns();
+        if (pfd[0].revents & POLLIN)
+            ingest(&dirs[0], scratch, now);
+        if (pfd[1].revents & POLLIN)
+            ingest(&dirs[1], scratch, now);
+    }
+
+    for (i = 0; i < 2; i++) {
+        struct dir *d = &dirs[i];
+
+        fprintf(stderr, "linkemu %s: enq %llu pkts, deq %llu pkts (%llu bytes), drops %llu, "
+                "lost %llu, extra delay avg %llu us max %llu us\n",
+                d->name, (unsigned long long)d->total.enq_pkts,
+                (unsigned long long)d->total.deq_pkts,
+                (unsigned long long)d->total.deq_bytes,
+                (unsigned long long)d->total.drops,
+                (unsigned long long)d->total.lost,
+                (unsigned long long)extra_avg_us(&d->total),
+                (unsigned long long)d->total.extra_max_ns / 1000);
+        free(d->imp.v);
+    }
+    if (log)
+        fclose(log);
+    free(scratch);
+    return 0;
+}
@@ -0,0 +1,415 @@
+"""
+실행 중 실험 라이브 대시보드 (localhost 전용)
+
+  실험 스크립트 (root 로 실행, Mininet 호스트 안의 ss / tc 샘플)
+      LiveFeed ──UDP JSON 배치── 127.0.0.1:LIVE_PORT
+  run_all_tests.py
+      DashboardServer: UDP 수신 → 1초마다 프레임으로 다운샘플 → SSE 로 브라우저에 push
+      http://127.0.0.1:DASH_PORT/  (Abort 버튼 → 러너가 현재 실행을 조기 종료)
+
+Abort 는 상태를 바꾸는 POST 라 다른 사이트가 브라우저를 통해 보내지 못하게:
+Host 가 127.0.0.1/localhost:DASH_PORT 인 요청만 받고 (DNS rebinding 차단),
+POST /abort 는 Origin 이 같은 주소여야 하며 실행마다 새로 만드는 토큰을 X-Abort-Token 헤더로 요구.
+토큰은 SSE reset 이벤트로만 전달 (교차 출처 페이지는 CORS 때문에 읽을 수 없음)
+
+프레임은 흐름 수와 무관하게 크기가 일정하다: 흐름이 DETAIL_FLOWS 개 이하면 흐름별 값,
+그보다 많으면 처리량/RTT/cwnd 의 p10/p50/p90 과 처리량 하위 WORST_FLOWS 개 흐름만 보낸다.
+그래서 1,000 흐름에서도 브라우저는 1초에 작은 JSON 하나만 그린다.
+
+LiveFeed 는 같은 샘플을 ESTIMATOR_LOG(CSV)에도 남겨 analyze_estimator.py 가
+추정기 정확도(BWE/BDP 오차, 편향, 지연)를 계산할 수 있게 한다.
+
+RENO_LIVE=0 이면 UDP 전송만 끔 (CSV 기록은 유지)
+"""
+
+import json
+import os
+import secrets
+import socket
+import subprocess
+import threading
+import time
+from collections import deque
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+from exp_common import parse_ss_tcp_info
+
+LIVE_PORT = int(os.environ.get('RENO_LIVE_PORT', 8089))
+DASH_PORT = int(os.environ.get('RENO_DASH_PORT', 8088))
+FEED_INTERVAL = 0.5       # 실험 쪽 샘플 간격 (초)
+FRAME_INTERVAL = 1.0      # 브라우저 push 간격 (초)
+FLOWS_PER_DATAGRAM = 150  # 한 UDP 데이터그램에 담는 흐름 수 (64KB 이하 유지)
+MIN_FLOW_BYTES = 100000   # 이보다 적게 보낸 소켓(iperf3 제어 연결 등)은 제외
+DETAIL_FLOWS = 24
+WORST_FLOWS = 10
+ESTIMATOR_LOG = '/tmp/estimator_samples.csv'
+HISTORY_FRAMES = 300      # 새로 접속한 브라우저에 보내는 최근 프레임 수
+FLOW_TIMEOUT = 3.0        # 이 시간 동안 갱신 없는 흐름은 프레임에서 제외
+
+
+# ---------------------------------------------------------------- 실험 쪽
+
+def link_queue(net, a, b):
+    """a-b 링크의 a 쪽 인터페이스 (a → b 방향 송신 큐): (라벨, 노드, 인터페이스 이름)"""
+    na, nb = net.get(a), net.get(b)
+    link = net.linksBetween(na, nb)[0]
+    intf = link.intf1 if link.intf1.node == na else link.intf2
+    return (f'{a}->{b}', na, intf.name)
+
+
+def _qdisc_stats(node, intf):
+    """인터페이스 qdisc 의 (backlog 바이트, 누적 drops). 루트가 자식 통계를 포함하므로 최대값 사용"""
+    out = node.popen(['tc', '-s', '-j', 'qdisc', 'show', 'dev', intf],
+                     stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                     text=True).communicate()[0]
+    try:
+        qdiscs = json.loads(out)
+    except ValueError:
+        return None, None
+    backlog = max((q.get('backlog', 0) for q in qdiscs), default=0)
+    drops = max((q.get('drops', 0) for q in qdiscs), default=0)
+    return backlog, drops
+
+
+class LiveFeed(threading.Thread):
+    """
+    senders: 송신 호스트 목록 (ss -tin 으로 소켓 정보 수집)
+    queues:  [(라벨, 노드, 인터페이스 이름), ...] backlog 를 볼 큐 (link_queue 참고)
+    """
+
+    def __init__(self, senders, queues=(), interval=FEED_INTERVAL, record=ESTIMATOR_LOG):
+        super().__init__(daemon=True)
+        self.senders = senders
+        self.queues = list(queues)
+        self.interval = interval
+        self.stop_event = threading.Event()
+        self.last = {}
+        self.enabled = os.environ.get('RENO_LIVE', '1') != '0'
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.record = record
+
+    def _send(self, msg):
+        try:
+            self.sock.sendto(json.dumps(msg, separators=(',', ':')).encode(),
+                             ('127.0.0.1', LIVE_PORT))
+        except OSError:
+            pass    # 대시보드가 없으면 버림
+
+    def sample(self, now):
+        rows = []
+        for host in self.senders:
+            out = host.popen(['ss', '-tin', 'state', 'established'],
+                             stdout=subprocess.PIPE, text=True).communicate()[0]
+            for s in parse_ss_tcp_info(out):
+                acked = s.get('bytes_acked')
+                if acked is None or acked < MIN_FLOW_BYTES:
+                    continue
+                fid = f"{host.name} {s['local']}>{s['peer']}"
+                prev = self.last.get(fid)
+                self.last[fid] = (now, acked)
+                if not prev or now <= prev[0] or acked < prev[1]:
+                    continue
+                mbps = (acked - prev[1]) * 8 / (now - prev[0]) / 1e6
+                bwe = s.get('bbr_bw_bps')
+                rows.append([fid, round(mbps, 3), s.get('cwnd'), s.get('rtt_ms'),
+                             round(bwe / 1e6, 3) if bwe is not None else None,
+                             s.get('bbr_mrtt_ms'), s.get('ssthresh'), s.get('mss')])
+        queues = []
+        for label, node, intf in self.queues:
+            backlog, drops = _qdisc_stats(node, intf)
+            queues.append([label, backlog, drops])
+        return rows, queues
+
+    def run(self):
+        log = open(self.record, 'w') if self.record else None
+        if log:
+            log.write('t,flow,tput_mbps,cwnd,rtt_ms,bwe_mbps,mrtt_ms,ssthresh,mss\n')
+        t0 = time.time()
+        seq = 0
+        while not self.stop_event.is_set():
+            now = time.time()
+            rows, queues = self.sample(now)
+            if log:
+                for r in rows:
+                    log.write(f"{now - t0:.2f}," + ','.join('' if x is None else str(x) for x in r) + '\n')
+                log.flush()
+            if self.enabled:
+                parts = [rows[i:i + FLOWS_PER_DATAGRAM]
+                         for i in range(0, len(rows), FLOWS_PER_DATAGRAM)] or [[]]
+                for k, part in enumerate(parts):
+                    self._send({'seq': seq, 't': now, 'flows': part,
+                                'queues': queues if k == 0 else []})
+            seq += 1
+            self.stop_event.wait(max(0.0, self.interval - (time.time() - now)))
+        if log:
+            log.close()
+
+    def stop(self):
+        self.stop_event.set()
+        if self.is_alive():
+            self.join()
+
+
+# ---------------------------------------------------------------- 러너 쪽
+
+def _quantiles(values):
+    v = sorted(x for x in values if x is not None)
+    if not v:
+        return None
+    return [v[int(q * (len(v) - 1))] for q in (0.1, 0.5, 0.9)]
+
+
+class DashboardServer:
+    def __init__(self, http_port=DASH_PORT, live_port=LIVE_PORT):
+        self.http_port = http_port
+        self.live_port = live_port
+        self.lock = threading.Lock()
+        self.cond = threading.Condition(self.lock)
+        self.abort_event = threading.Event()
+        self.abort_token = secrets.token_urlsafe(16)
+        self.label = ''
+        self.t0 = time.time()
+        self.flows = {}          # fid → (수신 시각, 행)
+        self.queues = {}         # 라벨 → (backlog, drops)
+        self.frames = deque(maxlen=HISTORY_FRAMES)
+        self.frame_seq = 0
+        self.run_seq = 0
+
+    # -- 러너 API
+    def start(self):
+        handler = type('Handler', (_Handler,), {'dash': self})
+        self.httpd = ThreadingHTTPServer(('127.0.0.1', self.http_port), handler)
+        self.httpd.daemon_threads = True
+        self.udp = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.udp.bind(('127.0.0.1', self.live_port))
+        for target in (self.httpd.serve_forever, self._recv_loop, self._frame_loop):
+            threading.Thread(target=target, daemon=True).start()
+        return f"http://127.0.0.1:{self.http_port}/"
+
+    def new_run(self, label):
+        with self.cond:
+            self.label = label
+            self.t0 = time.time()
+            self.flows.clear()
+            self.queues.clear()
+            self.frames.clear()
+            self.run_seq += 1
+            self.abort_token = secrets.token_urlsafe(16)
+            self.abort_event.clear()
+            self.cond.notify_all()
+
+    def wait(self, seconds):
+        """seconds 동안 대기, 도중에 Abort 가 눌리면 True"""
+        return self.abort_event.wait(seconds)
+
+    # -- 내부
+    def _recv_loop(self):
+        while True:
+            data, _ = self.udp.recvfrom(65535)
+            try:
+                msg = json.loads(data)
+            except ValueError:
+                continue
+            now = time.time()
+            with self.lock:
+                for row in msg.get('flows', []):
+                    self.flows[row[0]] = (now, row)
+                for label, backlog, drops in msg.get('queues', []):
+                    self.queues[label] = (backlog, drops)
+
+    def _frame_loop(self):
+        while True:
+            time.sleep(FRAME_INTERVAL)
+            with self.cond:
+                now = time.time()
+                rows = [r for seen, r in self.flows.values() if now - seen < FLOW_TIMEOUT]
+                for fid in [f for f, (seen, _) in self.flows.items() if now - seen >= FLOW_TIMEOUT]:
+                    del self.flows[fid]
+                frame = self._build_frame(now, rows)
+                self.frames.append(frame)
+                self.frame_seq += 1
+                self.cond.notify_all()
+
+    def _build_frame(self, now, rows):
+        rows.sort(key=lambda r: r[0])
+        col = lambda i: [r[i] for r in rows]
+        bwe = [x for x in col(4) if x is not None]
+        mrtt = [x for x in col(5) if x]
+        frame = {
+            't': round(now - self.t0, 2),
+            'n': len(rows),
+            'total_mbps': round(sum(col(1)), 2),
+            'bwe_mbps': round(sum(bwe) / len(bwe), 2) if bwe else None,
+            'mean_mbps': round(sum(col(1)) / len(rows), 2) if rows else None,
+            'mrtt_ms': round(sum(mrtt) / len(mrtt), 2) if mrtt else None,
+            'queues': {k: v for k, v in self.queues.items()},
+        }
+        if len(rows) <= DETAIL_FLOWS:
+            frame['flows'] = {r[0]: r[1:4] for r in rows}
+        else:
+            frame['q'] = {'tput': _quantiles(col(1)), 'cwnd': _quantiles(col(2)),
+                          'rtt': _quantiles(col(3))}
+        frame['worst'] = sorted(rows, key=lambda r: r[1])[:WORST_FLOWS]
+        return frame
+
+    def _stream(self, wfile):
+        """SSE: 접속 시 현재 실행의 최근 프레임 전체, 이후 새 프레임마다 하나씩"""
+        with self.cond:
+            run, seq = self.run_seq, self.frame_seq
+            hello = {'run': self.label, 'frames': list(self.frames), 'token': self.abort_token}
+        self._event(wfile, 'reset', hello)
+        while True:
+            with self.cond:
+                self.cond.wait_for(lambda: self.frame_seq != seq or self.run_seq != run, timeout=15)
+                if self.run_seq != run:
+                    run, seq = self.run_seq, self.frame_seq
+                    ev, payload = 'reset', {'run': self.label, 'frames': list(self.frames),
+                                            'token': self.abort_token}
+                elif self.frame_seq != seq:
+                    ev, payload = 'frame', self.frames[-1] if self.frames else None
+                    seq = self.frame_seq
+                else:
+                    ev, payload = None, None
+            if ev is None:
+                wfile.write(b': keepalive\n\n')
+                wfile.flush()
+            elif payload is not None:
+                self._event(wfile, ev, payload)
+
+    @staticmethod
+    def _event(wfile, name, payload):
+        wfile.write(f"event: {name}\ndata: {json.dumps(payload, separators=(',', ':'))}\n\n".encode())
+        wfile.flush()
+
+
+class _Handler(BaseHTTPRequestHandler):
+    dash = None
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def _local_host(self):
+        """Host 헤더가 이 서버의 루프백 주소인지 (아니면 403)"""
+        port = self.dash.http_port
+        if self.headers.get('Host') in (f'127.0.0.1:{port}', f'localhost:{port}'):
+            return True
+        self.send_error(403)
+        return False
+
+    def do_GET(self):
+        if not self._local_host():
+            return
+        if self.path == '/':
+            body = PAGE.encode()
+            self.send_response(200)
+            self.send_header('Content-Type', 'text/html; charset=utf-8')
+            self.send_header('Content-Length', str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+        elif self.path == '/events':
+            self.send_response(200)
+            self.send_header('Content-Type', 'text/event-stream')
+            self.send_header('Cache-Control', 'no-cache')
+            self.end_headers()
+            try:
+                self.dash._stream(self.wfile)
+            except (BrokenPipeError, ConnectionResetError):
+                pass
+        else:
+            self.send_error(404)
+
+    def do_POST(self):
+        if not self._local_host():
+            return
+        if self.path != '/abort':
+            self.send_error(404)
+            return
+        origin = self.headers.get('Origin')
+        token = self.headers.get('X-Abort-Token', '')
+        with self.dash.lock:
+            expected = self.dash.abort_token
+        if (origin is not None and origin != f"http://{self.headers['Host']}") or \
+                not secrets.compare_digest(token, expected):
+            self.send_error(403)
+            return
+        self.dash.abort_event.set()
+        self.send_response(204)
+        self.end_headers()
+
+
+PAGE = r"""<!doctype html>
+<html><head><meta charset="utf-8"><title>reno_custom live</title>
+<style>
+body{font:13px sans-serif;margin:12px;background:#fafafa}
+#grid{display:grid;grid-template-columns:1fr 1fr;gap:10px}
+.panel{background:#fff;border:1px solid #ddd;padding:6px}
+.panel h3{margin:0 0 4px;font-size:13px}
+canvas{width:100%;height:180px}
+#abort{background:#c33;color:#fff;border:0;padding:6px 14px;font-weight:bold;cursor:pointer}
+table{border-collapse:collapse;font-size:12px}td,th{padding:1px 8px;text-align:right}
+</style></head><body>
+<div><b id="run">(waiting)</b> &nbsp; t=<span id="t">-</span>s &nbsp; flows=<span id="n">-</span>
+&nbsp; <button id="abort">Abort run</button></div>
+<div id="grid">
+<div class="panel"><h3>Throughput (Mbit/s)</h3><canvas id="c_tput"></canvas></div>
+<div class="panel"><h3>RTT (ms)</h3><canvas id="c_rtt"></canvas></div>
+<div class="panel"><h3>cwnd (packets)</h3><canvas id="c_cwnd"></canvas></div>
+<div class="panel"><h3>Queue backlog (KB)</h3><canvas id="c_queue"></canvas></div>
+<div class="panel"><h3>reno_custom BWE vs delivered (Mbit/s, per-flow mean)</h3><canvas id="c_bwe"></canvas></div>
+<div class="panel"><h3>Lowest-throughput flows</h3><table id="worst"></table></div>
+</div>
+<script>
+const MAX = 300, COLORS = ['#1f77b4','#d62728','#2ca02c','#ff7f0e','#9467bd','#8c564b','#e377c2','#7f7f7f','#bcbd22','#17becf'];
+let frames = [];
+function series(f) {
+  // 패널 → {이름: 값}, 흐름 상세가 없으면 p10/p50/p90 으로 대체
+  const s = {tput: {total: f.total_mbps}, rtt: {}, cwnd: {}, queue: {}, bwe: {bwe: f.bwe_mbps, delivered: f.mean_mbps, 'minRTT(ms)': f.mrtt_ms}};
+  if (f.flows) for (const [id, v] of Object.entries(f.flows)) {
+    const k = id.split(' ')[0] + ' ' + id.split('>')[1];
+    s.tput[k] = v[0]; s.cwnd[k] = v[1]; s.rtt[k] = v[2];
+  }
+  if (f.q) for (const m of ['tput', 'cwnd', 'rtt']) if (f.q[m])
+    ['p10', 'p50', 'p90'].forEach((p, i) => s[m][p] = f.q[m][i]);
+  for (const [k, v] of Object.entries(f.queues || {})) if (v[0] != null) s.queue[k] = v[0] / 1000;
+  return s;
+}
+function draw(name) {
+  const c = document.getElementById('c_' + name), ctx = c.getContext('2d');
+  c.width = c.clientWidth; c.height = c.clientHeight;
+  const pts = frames.map(f => [f.t, series(f)[name]]);
+  const keys = [...new Set(pts.flatMap(p => Object.keys(p[1])))];
+  let ymax = 0;
+  for (const [, v] of pts) for (const k of keys) if (v[k] != null) ymax = Math.max(ymax, v[k]);
+  ymax = ymax * 1.1 || 1;
+  const t0 = pts.length ? pts[0][0] : 0, t1 = pts.length ? pts[pts.length - 1][0] : 1;
+  const X = t => 40 + (c.width - 50) * (t - t0) / Math.max(t1 - t0, 1), Y = y => c.height - 15 - (c.height - 25) * y / ymax;
+  ctx.fillStyle = '#666'; ctx.fillText(ymax.toFixed(1), 2, 12); ctx.fillText('0', 2, c.height - 15);
+  keys.forEach((k, i) => {
+    ctx.strokeStyle = COLORS[i % COLORS.length]; ctx.beginPath();
+    let first = true;
+    for (const [t, v] of pts) { if (v[k] == null) { first = true; continue; }
+      first ? ctx.moveTo(X(t), Y(v[k])) : ctx.lineTo(X(t), Y(v[k])); first = false; }
+    ctx.stroke();
+    if (keys.length <= 12) { ctx.fillStyle = COLORS[i % COLORS.length]; ctx.fillText(k, 45 + (i % 4) * 110, 12 + Math.floor(i / 4) * 12); }
+  });
+}
+function render() {
+  const f = frames[frames.length - 1];
+  if (!f) return;
+  document.getElementById('t').textContent = f.t;
+  document.getElementById('n').textContent = f.n;
+  ['tput', 'rtt', 'cwnd', 'queue', 'bwe'].forEach(draw);
+  document.getElementById('worst').innerHTML = '<tr><th>flow</th><th>Mbit/s</th><th>cwnd</th><th>RTT</th><th>BWE</th><th>minRTT</th><th>ssthresh</th><th>mss</th></tr>' +
+    f.worst.map(r => '<tr><td>' + r.map(x => x == null ? '-' : x).join('</td><td>') + '</td></tr>').join('');
+}
+let pending = false;
+function schedule() { if (!pending) { pending = true; requestAnimationFrame(() => { pending = false; render(); }); } }
+const es = new EventSource('/events');
+let token = '';
+es.addEventListener('reset', e => { const d = JSON.parse(e.data); document.getElementById('run').textContent = d.run || '(idle)'; frames = d.frames; token = d.token; schedule(); });
+es.addEventListener('frame', e => { frames.push(JSON.parse(e.data)); if (frames.length > MAX) frames.shift(); schedule(); });
+document.getElementById('abort').onclick = () => {
+  if (confirm('Abort ' + document.getElementById('run').textContent + '?')) fetch('/abort', {method: 'POST', headers: {'X-Abort-Token': token}});
+};
+</script></body></html>
+"""
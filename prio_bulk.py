@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+SO_MARK 를 지정할 수 있는 bulk TCP 송신/수신기
+iperf3 는 소켓 마크를 설정할 수 없으므로 reno_custom 가중치 실험에 사용
+(reno_custom 은 마크 weight_mark + N 을 가중치 N 으로 읽음, SO_MARK 는 CAP_NET_ADMIN 필요)
+
+  서버:     python3 prio_bulk.py server <port>
+  클라이언트: python3 prio_bulk.py client <server_ip> <port> <duration> <mark> <cc> <json_out>
+
+결과 JSON 은 iperf3 -J 와 같은 키(end.sum_sent.bits_per_second, intervals)를 사용하므로
+기존 분석 스크립트로도 읽을 수 있음
+"""
+
+import json
+import socket
+import sys
+import threading
+import time
+
+CHUNK = 256 * 1024
+
+
+def serve_one(conn):
+    with conn:
+        while conn.recv(CHUNK):
+            pass
+
+
+def run_server(port):
+    s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    s.bind(('0.0.0.0', port))
+    s.listen(16)
+    while True:
+        conn, _ = s.accept()
+        threading.Thread(target=serve_one, args=(conn,), daemon=True).start()
+
+
+def run_client(server_ip, port, duration, mark, cc_algo, json_out):
+    s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    # 연결 전에 설정해야 reno_custom_init 에서 가중치로 읽힘
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_MARK, mark)
+    s.setsockopt(socket.IPPROTO_TCP, socket.TCP_CONGESTION, cc_algo.encode())
+    s.connect((server_ip, port))
+
+    buf = b'\0' * CHUNK
+    intervals = []
+    total = 0
+    start = time.time()
+    next_mark = start + 1.0
+    interval_bytes = 0
+
+    while True:
+        now = time.time()
+        if now >= start + duration:
+            break
+        sent = s.send(buf)
+        total += sent
+        interval_bytes += sent
+        if now >= next_mark:
+            intervals.append({'sum': {
+                'start': next_mark - 1.0 - start,
+                'end': now - start,
+                'bytes': interval_bytes,
+                'bits_per_second': interval_bytes * 8 / (now - next_mark + 1.0)
+            }})
+            interval_bytes = 0
+            next_mark += 1.0
+
+    elapsed = time.time() - start
+    s.close()
+
+    result = {
+        'start': {'mark': mark, 'cc': cc_algo},
+        'intervals': intervals,
+        'end': {'sum_sent': {
+            'seconds': elapsed,
+            'bytes': total,
+            'bits_per_second': total * 8 / elapsed
+        }}
+    }
+    with open(json_out, 'w') as f:
+        json.dump(result, f)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) >= 3 and sys.argv[1] == 'server':
+        run_server(int(sys.argv[2]))
+    elif len(sys.argv) >= 8 and sys.argv[1] == 'client':
+        run_client(sys.argv[2], int(sys.argv[3]), float(sys.argv[4]),
+                   int(sys.argv[5], 0), sys.argv[6], sys.argv[7])
+    else:
+        print(__doc__)
+        sys.exit(1)
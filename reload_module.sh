@@ -1,4 +1,5 @@
 #!/bin/bash
+# 호스트 커널에 직접 다시 로드 (빌드 여러 개를 호스트와 격리해 비교하려면 vm_run.py)
 
 # TCP congestion control을 cubic으로 변경
 echo "Setting congestion control to cubic..."
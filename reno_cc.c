@@ -0,0 +1,135 @@
+/*
+ * 유저스페이스 reno_custom 라이브러리
+ * slow start / AI 는 커널 tcp_slow_start(), tcp_cong_avoid_ai() 와 같은 동작
+ */
+
+#include "reno_cc.h"
+
+#define RENO_CC_INFINITE_SSTHRESH 0x7fffffffU
+
+void reno_cc_init(struct reno_cc *cc, const struct reno_cc_config *cfg)
+{
+    reno_bwe_reset(&cc->bwe, cfg->weighted && !cfg->classic ? cfg->weight : 1);
+    cc->params.weighted = cfg->weighted && !cfg->classic;
+    cc->params.fc_beta  = cfg->classic ? 0 : cfg->fc_beta;
+    cc->params.loss_beta = 0;
+    cc->params.cap_gain = cfg->no_cap || cfg->classic ? 0 :
+                          cfg->cap_gain ? cfg->cap_gain : RENO_CAP_GAIN_DEF;
+    cc->classic = cfg->classic;
+
+    cc->cwnd       = cfg->init_cwnd ? cfg->init_cwnd : RENO_CC_INIT_CWND;
+    cc->ssthresh   = RENO_CC_INFINITE_SSTHRESH;
+    cc->cwnd_cnt   = 0;
+    cc->cwnd_clamp = cfg->cwnd_clamp ? cfg->cwnd_clamp : 0xffffffffU;
+    cc->mss        = cfg->mss;
+    cc->srtt_us    = 0;
+}
+
+/* tcp_slow_start(): ssthresh 까지 ACK 당 1 증가, 남은 ACK 반환 */
+static uint32_t reno_cc_slow_start(struct reno_cc *cc, uint32_t acked)
+{
+    uint64_t cwnd = (uint64_t)cc->cwnd + acked;
+
+    if (cwnd > cc->ssthresh)
+        cwnd = cc->ssthresh;
+    acked -= (uint32_t)(cwnd - cc->cwnd);
+    cc->cwnd = reno_sat_u32(cwnd < cc->cwnd_clamp ? cwnd : cc->cwnd_clamp);
+    return acked;
+}
+
+/* tcp_cong_avoid_ai(): w 개 ACK 당 1 증가 */
+static void reno_cc_cong_avoid_ai(struct reno_cc *cc, uint32_t w, uint32_t acked)
+{
+    if (cc->cwnd_cnt >= w) {
+        cc->cwnd_cnt = 0;
+        cc->cwnd++;
+    }
+
+    cc->cwnd_cnt += acked;
+    if (cc->cwnd_cnt >= w) {
+        uint32_t delta = cc->cwnd_cnt / w;
+
+        cc->cwnd_cnt -= delta * w;
+        cc->cwnd = reno_sat_u32((uint64_t)cc->cwnd + delta);
+    }
+    if (cc->cwnd > cc->cwnd_clamp)
+        cc->cwnd = cc->cwnd_clamp;
+}
+
+void reno_cc_on_ack(struct reno_cc *cc, uint32_t acked, int32_t rtt_us,
+                    bool cwnd_limited)
+{
+    uint32_t cap, w;
+
+    /* pkts_acked: 최소 RTT + BWE */
+    reno_bwe_update(&cc->bwe, acked, rtt_us);
+
+    if (rtt_us > 0) {
+        if (cc->srtt_us == 0)
+            cc->srtt_us = (uint32_t)rtt_us;
+        else
+            cc->srtt_us = cc->srtt_us - (cc->srtt_us >> 3) + ((uint32_t)rtt_us >> 3);
+    }
+
+    /* cong_avoid */
+    if (!cwnd_limited || acked == 0)
+        return;
+
+    if (reno_cc_in_slow_start(cc)) {
+        acked = reno_cc_slow_start(cc, acked);
+        if (!acked)
+            return;
+    }
+
+    /* 가중치 N: RTT 당 N 패킷 증가 */
+    w = cc->cwnd / cc->bwe.weight;
+    reno_cc_cong_avoid_ai(cc, w ? w : 1, acked);
+
+    /* cwnd가 BDP의 cap_gain 배(기본 2배) 이상이면 제한 */
+    cap = reno_bwe_cap(&cc->bwe, &cc->params);
+    if (cap > 0 && cc->cwnd > cap)
+        cc->cwnd = cap;
+}
+
+/* 손실 시 ssthresh: reno_custom 은 BDP 기반, 기준선은 tcp_reno_ssthresh() */
+static uint32_t reno_cc_loss_ssthresh(struct reno_cc *cc)
+{
+    if (cc->classic)
+        return cc->cwnd >> 1 > 2U ? cc->cwnd >> 1 : 2U;
+    return reno_bwe_ssthresh(&cc->bwe, cc->cwnd, &cc->params);
+}
+
+void reno_cc_on_loss(struct reno_cc *cc)
+{
+    cc->ssthresh = reno_cc_loss_ssthresh(cc);
+    /* 복구 종료 시 커널(PRR)이 도달하는 값으로 바로 설정 */
+    cc->cwnd     = cc->ssthresh;
+    cc->cwnd_cnt = 0;
+}
+
+void reno_cc_on_rto(struct reno_cc *cc)
+{
+    cc->ssthresh = reno_cc_loss_ssthresh(cc);
+    cc->cwnd     = 1;
+    cc->cwnd_cnt = 0;
+}
+
+uint64_t reno_cc_pacing_rate(const struct reno_cc *cc, uint32_t inflight)
+{
+    /* tcp_update_pacing_rate(): max(cwnd, packets_out), 200% 는 cwnd < ssthresh/2 일 때만 */
+    uint64_t bytes = (uint64_t)cc->mss * (cc->cwnd > inflight ? cc->cwnd : inflight);
+    uint64_t rate;
+
+    if (cc->srtt_us == 0)
+        return 0;   /* RTT 샘플 전에는 페이싱 없음 */
+
+    /* bytes * 2 * 1e6 이 u64 를 넘는 극단값은 나눗셈을 먼저 */
+    if (bytes > UINT64_MAX / (2ULL * RENO_USEC_PER_SEC))
+        rate = bytes / cc->srtt_us * RENO_USEC_PER_SEC;
+    else
+        rate = bytes * RENO_USEC_PER_SEC / cc->srtt_us;
+
+    if (rate > UINT64_MAX / 2)
+        return UINT64_MAX;
+    return cc->cwnd < cc->ssthresh / 2 ? rate * 2 : rate / 5 * 6;
+}
@@ -0,0 +1,90 @@
+#ifndef RENO_CC_H
+#define RENO_CC_H
+
+/*
+ * 유저스페이스 reno_custom 혼잡 제어 라이브러리 (QUIC 등 유저스페이스 전송용)
+ *
+ * - 커널 모듈과 같은 코어(reno_custom_core.h)를 사용
+ * - 할당 없음: 호출자가 struct reno_cc 를 연결 구조체 안에 직접 포함
+ * - 단위: cwnd/ssthresh 는 패킷(MSS), RTT 는 µs, 페이싱 속도는 bytes/s
+ * - 스레드 안전하지 않음 (연결 단위로 한 스레드에서 호출)
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "reno_custom_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RENO_CC_INIT_CWND   10U
+
+struct reno_cc_config {
+    uint32_t mss;           /* 바이트 */
+    uint32_t init_cwnd;     /* 0 이면 RENO_CC_INIT_CWND */
+    uint32_t cwnd_clamp;    /* 0 이면 제한 없음 */
+    uint32_t weight;        /* MulTCP 가중치, 0/1 = 일반 */
+    bool weighted;
+    uint32_t fc_beta;       /* fast convergence 계수 /1024, 0 이면 끔 */
+    uint32_t cap_gain;      /* cwnd 상한 BDP 배수 /1024, 0 이면 RENO_CAP_GAIN_DEF */
+    bool no_cap;            /* cwnd 상한 끄기 */
+    bool classic;           /* 기준선: 고전 Reno (손실 시 cwnd/2, 상한/가중치 없음) */
+};
+
+/* 72 B (x86-64): bwe 28 + params 16 + 나머지 28, reno_cc_bench 가 sizeof 를 출력 */
+struct reno_cc {
+    struct reno_bwe bwe;        /* 커널 icsk_ca_priv 와 같은 레이아웃 */
+    struct reno_bwe_params params;
+    uint32_t cwnd;
+    uint32_t ssthresh;
+    uint32_t cwnd_cnt;          /* AI 누적 ACK (커널 snd_cwnd_cnt) */
+    uint32_t cwnd_clamp;
+    uint32_t mss;
+    uint32_t srtt_us;           /* EWMA 1/8, 페이싱용 */
+    bool classic;
+};
+
+void reno_cc_init(struct reno_cc *cc, const struct reno_cc_config *cfg);
+
+/*
+ * 새로 ACK 된 패킷 수와 RTT 샘플 (없으면 rtt_us <= 0)
+ * cwnd_limited: 직전 RTT 동안 cwnd 가 전송을 제한했는지 (앱 제한이면 false)
+ */
+void reno_cc_on_ack(struct reno_cc *cc, uint32_t acked, int32_t rtt_us,
+                    bool cwnd_limited);
+
+/* 혼잡 이벤트 1회당 한 번 호출 (같은 RTT 안의 손실은 호출자가 묶음) */
+void reno_cc_on_loss(struct reno_cc *cc);
+
+/* 재전송 타임아웃: ssthresh 갱신 후 cwnd = 1 */
+void reno_cc_on_rto(struct reno_cc *cc);
+
+static inline uint32_t reno_cc_cwnd(const struct reno_cc *cc)
+{
+    return cc->cwnd;
+}
+
+static inline uint64_t reno_cc_cwnd_bytes(const struct reno_cc *cc)
+{
+    return (uint64_t)cc->cwnd * cc->mss;
+}
+
+static inline bool reno_cc_in_slow_start(const struct reno_cc *cc)
+{
+    return cc->cwnd < cc->ssthresh;
+}
+
+/*
+ * 페이싱 속도 (bytes/s), 커널 tcp_update_pacing_rate() 와 같은 규칙:
+ * mss * max(cwnd, inflight) / srtt 의 200% (cwnd < ssthresh/2), 그 외 120%
+ * inflight: 호출자가 아는 전송 중 패킷 수 (커널의 packets_out)
+ */
+uint64_t reno_cc_pacing_rate(const struct reno_cc *cc, uint32_t inflight);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RENO_CC_H */
@@ -0,0 +1,87 @@
+/*
+ * reno_cc 라이브러리 ACK 당 비용 벤치마크
+ *
+ *   ./reno_cc_bench [연결 수] [연결당 ACK 수]
+ *
+ * 연결 수를 늘리면 struct reno_cc 가 캐시에 다 들어가지 않는 경우
+ * (서버에서 많은 연결을 처리하는 상황)의 비용을 볼 수 있다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "reno_cc.h"
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* xorshift32: 벤치마크 안에서 rand() 비용을 피하기 위함 */
+static uint32_t rnd(uint32_t *s)
+{
+    *s ^= *s << 13;
+    *s ^= *s >> 17;
+    *s ^= *s << 5;
+    return *s;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t nconn = argc > 1 ? (uint32_t)atoi(argv[1]) : 1;
+    uint32_t nacks = argc > 2 ? (uint32_t)atoi(argv[2]) : 10000000;
+    struct reno_cc_config cfg = { .mss = 1448, .fc_beta = 870 };
+    struct reno_cc *conns;
+    uint64_t t0, t_ack, t_loss, total = (uint64_t)nconn * nacks;
+    uint64_t losses = 0, sink = 0;
+    uint32_t seed = 12345;
+    uint32_t i, c;
+
+    if (nconn == 0 || nacks == 0)
+        return 1;
+
+    conns = calloc(nconn, sizeof(*conns));
+    if (!conns)
+        return 1;
+    for (c = 0; c < nconn; c++)
+        reno_cc_init(&conns[c], &cfg);
+
+    /* ACK 경로: 연결을 번갈아 가며 (20ms ± 1ms RTT) */
+    t0 = now_ns();
+    for (i = 0; i < nacks; i++) {
+        for (c = 0; c < nconn; c++) {
+            uint32_t r = rnd(&seed);
+
+            reno_cc_on_ack(&conns[c], 1 + (r & 1), 19500 + (int32_t)(r >> 22), true);
+        }
+    }
+    t_ack = now_ns() - t0;
+
+    /* 손실 경로 */
+    t0 = now_ns();
+    for (i = 0; i < nacks / 100 + 1; i++) {
+        for (c = 0; c < nconn; c++) {
+            reno_cc_on_loss(&conns[c]);
+            losses++;
+        }
+    }
+    t_loss = now_ns() - t0;
+
+    for (c = 0; c < nconn; c++)
+        sink += reno_cc_cwnd(&conns[c]) + reno_cc_pacing_rate(&conns[c], 0);
+
+    printf("sizeof(struct reno_cc) = %zu bytes, sizeof(struct reno_bwe) = %zu bytes\n",
+           sizeof(struct reno_cc), sizeof(struct reno_bwe));
+    printf("connections: %u, acks: %llu\n", nconn, (unsigned long long)total);
+    printf("on_ack : %.2f ns/ack (%.1f M acks/s)\n",
+           (double)t_ack / total, total * 1e3 / t_ack);
+    printf("on_loss: %.2f ns/event\n", (double)t_loss / losses);
+    printf("(checksum %llu)\n", (unsigned long long)sink);
+
+    free(conns);
+    return 0;
+}
@@ -1,92 +1,409 @@
 #include <linux/module.h>
 #include <linux/kernel.h>
+#include <linux/hash.h>
+#include <linux/indirect_call_wrapper.h>
+#include <linux/inet_diag.h>
+#include <linux/percpu.h>
+#include <linux/proc_fs.h>
+#include <linux/seq_file.h>
+#include <net/ipv6.h>
+#include <net/net_namespace.h>
 #include <net/tcp.h>
 
+#include "reno_custom_repair.h"
+
 /*
  * Reno + Westwood 스타일 하이브리드
  * - pkts_acked: 대역폭(BWE) + 최소 RTT 추정
  * - ssthresh: 손실 시 cwnd/2 대신 BDP 기반으로 설정
  * - cong_avoid: Reno 증가 (공정성 유지)
+ * - weighted=1: MulTCP 스타일 가중치 N (N개 Reno 흐름처럼 동작)
+ * - fast_convergence=1: 손실 때마다 BWE 가 줄어들면 BDP 보다 낮게 양보
+ * - cap_gain: cwnd 상한 (BDP 배수) 조정, 폴리서/셰이퍼 경로 튜닝용
+ * - get_info: BWE/최소 RTT 를 ss -i 에 노출 (BBR 정보 형식)
+ * - bwe_mode: BWE 추정 방식 선택 (추정기 정확도 비교용)
+ * - /proc/net/reno_custom: per-cpu 집계 카운터 (손실 분기, cwnd 상한 적용 횟수)
+ *   모든 netns 에 생성되지만 값은 모듈 전체 합 (Mininet 호스트 안에서 읽어도 같음)
+ * - bandit=1: 흐름별로 cap/감소 설정을 epoch 단위로 평가해 고르고, 결과를 목적지별 기본값으로 남김
+ * - delay_gradient=1: 라운드별 RTT 기울기로 혼잡 감지 (ECN 없는 µs RTT 패브릭), BDP 하한 유지
+ * - /proc/net/reno_custom_repair: TCP_REPAIR 중인 소켓의 추정기 상태 덤프/복원 (ioctl)
+ *   netns 마다 생성 (CRIU 는 컨테이너 netns 안에서 복원), 권한은 소켓의 netns 기준
+ * - CONFIG_TCP_CONG_RENO_CUSTOM=y 로 빌트인하면 tcp_input.c 가 ACK 경로 훅을 직접 호출
+ *   (tcp_ca_direct_calls.patch)
  *
  * reno_custom (원래 reno_bwe)
+ *
+ * reno_l4s: 같은 모듈의 두 번째 혼잡 제어 (L4S / scalable ECN)
+ * - ECN 필수 (TCP_CONG_NEEDS_ECN), 항상 페이싱
+ * - CE 표시 비율(alpha)에 비례한 감소, BDP 아래로는 내리지 않음
+ * - 혼잡 회피 증가: RTT 당 max(1, cwnd/64)
+ * - 손실은 reno_custom 과 같은 BDP 기반 처리, classic 큐로 판단되면 reno_custom 으로 동작
+ */
+
+/*
+ * 가중치 모드 (MulTCP)
+ *  - weighted=0 이면 기존 동작과 완전히 동일
+ *  - 가중치 결정 순서: SO_MARK = weight_mark + N (N = 1..16) → net_cls cgroup classid minor
+ *    → default_weight (sysfs 로 런타임 변경 가능)
+ *  - sk_priority 는 쓰지 않음: IP_TOS 가 rt_tos2priority 로 바꾸고 비특권 SO_PRIORITY(0..6)도
+ *    허용되므로 관계없는 앱이 가중치를 받게 됨. SO_MARK 와 cgroup 은 CAP_NET_ADMIN 이 필요한
+ *    명시적 설정이고, weight_mark 로 다른 정책의 마크와 겹치지 않는 구간을 고름 (0 이면 끔)
+ */
+static bool weighted __read_mostly;
+module_param(weighted, bool, 0644);
+MODULE_PARM_DESC(weighted, "enable MulTCP-style per-flow weights (default: 0)");
+
+static unsigned int weight_mark __read_mostly = 0x52430000;    /* "RC" */
+module_param(weight_mark, uint, 0644);
+MODULE_PARM_DESC(weight_mark, "SO_MARK base: mark weight_mark+N gives weight N (0: disabled)");
+
+static int default_weight __read_mostly = 1;
+module_param(default_weight, int, 0644);
+MODULE_PARM_DESC(default_weight, "weight for flows without mark/cgroup weight (1..16)");
+
+/*
+ * Fast convergence (CUBIC 과 같은 아이디어)
+ *  - 연속된 손실 이벤트 사이에 bwe_filt_pps 가 감소했다면 새 경쟁 흐름이
+ *    들어온 것으로 보고 ssthresh 를 BDP * fc_beta/1024 로 낮춰 대역폭을 양보
+ */
+static bool fast_convergence __read_mostly;
+module_param(fast_convergence, bool, 0644);
+MODULE_PARM_DESC(fast_convergence, "release bandwidth when BWE falls between losses (default: 0)");
+
+static int fc_beta __read_mostly = 870;
+module_param(fc_beta, int, 0644);
+MODULE_PARM_DESC(fc_beta, "fast convergence ssthresh factor, scaled by 1024 (default: 870)");
+
+/*
+ * cwnd 상한 계수 (BDP 의 배수, /1024)
+ *  - 기본 2048 = 기존 BDP * 2, 0 이면 상한 없음
+ *  - 폴리서(초과분 드롭) 경로에서는 1024~1280 으로 낮추면 손실 버스트가 줄고,
+ *    셰이퍼(큐잉) 경로에서는 기본값이 큐를 채워 이용률이 높음
+ */
+static int cap_gain __read_mostly = RENO_CAP_GAIN_DEF;
+module_param(cap_gain, int, 0644);
+MODULE_PARM_DESC(cap_gain, "cwnd cap as BDP multiple, scaled by 1024, 0 = no cap (default: 2048)");
+
+/*
+ * BWE 추정 방식
+ *  - 0 (RENO_BWE_ACK): ACK 당 pkts_acked / RTT, 기존 동작
+ *  - 1 (RENO_BWE_WINDOW): min_rtt 이상 구간의 누적 ACK / 경과 시간
+ *  연결 도중 바꿔도 됨 (구간 상태는 처음 쓰일 때 시작)
+ */
+static int bwe_mode __read_mostly = RENO_BWE_ACK;
+module_param(bwe_mode, int, 0644);
+MODULE_PARM_DESC(bwe_mode, "bandwidth estimator: 0 = per-ACK pkts/RTT, 1 = windowed ACK rate (default: 0)");
+
+/*
+ * 흐름별 파라미터 학습 (reno_custom_core.h 의 reno_bandit)
+ *  - 연결 시작 시 켜져 있던 흐름만 사용, cap_gain=0 (상한 없음)이면 상한은 그대로 끔
+ *  - 연결이 끝날 때 충분히 학습한 흐름(RENO_DST_MIN_EPOCHS 이상)의 최선 arm 을
+ *    목적지 주소 해시 표에 기록하고, 같은 목적지의 다음 흐름은 그 arm 으로 시작
+ */
+static bool bandit __read_mostly;
+module_param(bandit, bool, 0644);
+MODULE_PARM_DESC(bandit, "learn cap/backoff settings per flow and per destination (default: 0)");
+
+/*
+ * 지연 기울기 모드 (reno_custom_core.h 의 reno_grad)
+ *  - grad_thresh: 라운드당 RTT 증가가 min_rtt * grad_thresh/1024 를 넘으면 감소
+ *  - grad_beta:   감소 비율 /1024 (기본 205 = 20%), BDP 아래로는 내리지 않음
+ *  런타임에 켜고 꺼도 됨: 상태는 켜져 있는 동안만 갱신하고, 흐름마다 켜지는 것을 처음
+ *  본 ACK 에서 새로 시작 (꺼져 있던 동안의 오래된 RTT 와 비교하지 않음)
+ *  cwnd 감소 중(CWR/Recovery/Loss)에는 기울기만 갱신하고 감소하지 않음
+ */
+static bool delay_gradient __read_mostly;
+module_param(delay_gradient, bool, 0644);
+MODULE_PARM_DESC(delay_gradient, "reduce cwnd on positive RTT gradient per round (default: 0)");
+
+static int grad_thresh __read_mostly = 50;
+module_param(grad_thresh, int, 0644);
+MODULE_PARM_DESC(grad_thresh, "normalized RTT gradient threshold per round, scaled by 1024 (default: 50)");
+
+static int grad_beta __read_mostly = 205;
+module_param(grad_beta, int, 0644);
+MODULE_PARM_DESC(grad_beta, "multiplicative decrease on gradient, scaled by 1024 (default: 205)");
+
+#define RENO_DST_BITS       10
+#define RENO_DST_MIN_EPOCHS 8U
+
+/* 항목 = 해시 상위 24비트 | (arm + 1), 0 = 비어 있음. 경합 시 마지막 기록이 이김 */
+static u32 reno_dst_arm[1 << RENO_DST_BITS];
+
+/*
+ * reno_l4s classic 큐 판단 임계값 (µs)
+ *  - 표시/손실이 있는 RTT 창에서 srtt - min_rtt 가 이 값을 넘으면 classic 점수 증가
+ *  - L4S step 표시(~1ms)보다 크고 classic AQM 목표(CoDel 5ms, PIE 15ms)보다 작게
  */
+static int l4s_classic_qdelay_us __read_mostly = 2000;
+module_param(l4s_classic_qdelay_us, int, 0644);
+MODULE_PARM_DESC(l4s_classic_qdelay_us, "reno_l4s: queue delay above which marks/losses count as classic (default: 2000)");
 
-struct reno_bwe {
-    u32 min_rtt_us;
-    u32 bwe_pps;
-    u32 bwe_filt_pps;
-    u32 spare;
+/*
+ * 모듈 전체 집계 카운터 (per-cpu, 읽을 때 합산)
+ *  - 손실 분기: reno_bwe_ssthresh_why() 의 RENO_SS_* 비트별 횟수
+ *  - cap: cong_avoid 에서 cwnd 가 BDP 상한에 잘린 횟수
+ * 소켓 수와 무관하게 고정 크기라 reno_exporter 가 매 수집마다 읽어도 부담이 없음
+ */
+struct reno_custom_stats {
+    u64 inits;
+    u64 acks;
+    u64 loss_events;
+    u64 loss_no_est;
+    u64 loss_bdp;
+    u64 loss_floor;
+    u64 loss_clamp;
+    u64 loss_weighted;
+    u64 loss_fc;
+    u64 cap_events;
+    u64 l4s_ce_reductions;
+    u64 l4s_classic_enter;
+    u64 l4s_classic_exit;
+    u64 bandit_epochs;
+    u64 bandit_dst_updates;
+    u64 grad_reductions;
+    u64 repair_dumps;
+    u64 repair_restores;
+    u64 repair_rejects;
 };
 
-static void reno_custom_init(struct sock *sk)
+static DEFINE_PER_CPU(struct reno_custom_stats, reno_custom_stats);
+
+#define RENO_STAT_INC(field) this_cpu_inc(reno_custom_stats.field)
+
+static u32 reno_custom_flow_weight(const struct sock *sk)
 {
-    struct reno_bwe *ca = inet_csk_ca(sk);
+    u32 base = READ_ONCE(weight_mark);
+    u32 w;
+
+    if (!weighted)
+        return 1;
+
+    /* 1) 소켓 마크 (SO_MARK = weight_mark + N) */
+    w = READ_ONCE(sk->sk_mark) - base;
+    if (base && w >= 1 && w <= RENO_MAX_WEIGHT)
+        return w;
+
+#ifdef CONFIG_CGROUP_NET_CLASSID
+    /* 2) net_cls cgroup classid 의 minor 번호 */
+    w = sock_cgroup_classid(&sk->sk_cgrp_data) & 0xffff;
+    if (w >= 1 && w <= RENO_MAX_WEIGHT)
+        return w;
+#endif
+
+    /* 3) control plane 기본값 */
+    return clamp_t(u32, READ_ONCE(default_weight), 1U, RENO_MAX_WEIGHT);
+}
 
-    ca->min_rtt_us   = 0x7fffffff;
-    ca->bwe_pps      = 0;
-    ca->bwe_filt_pps = 0;
-    ca->spare        = 0;
+static void reno_custom_params(struct reno_bwe_params *p)
+{
+    p->weighted  = weighted;
+    p->fc_beta   = fast_convergence ?
+                   clamp_t(u32, READ_ONCE(fc_beta), 512U, 1024U) : 0;
+    p->cap_gain  = READ_ONCE(cap_gain) > 0 ?
+                   clamp_t(u32, READ_ONCE(cap_gain), 1024U, 8192U) : 0;
+    p->loss_beta = 0;
 }
 
-static void reno_custom_pkts_acked(struct sock *sk, const struct ack_sample *sample)
+/*
+ * icsk_ca_priv (ICSK_CA_PRIV_SIZE = 104 B) 안의 소켓별 상태
+ * 합계 102 B (플래그 2 포함), 정렬 후 104 B 로 여유 없음
+ * 필드를 더하려면 합계를 먼저 확인 (module_init 의 BUILD_BUG_ON 이 검사)
+ */
+struct reno_custom_sock {
+    struct reno_bwe bwe;            /* 28 B */
+    struct reno_bandit bandit;      /* 52 B */
+    struct reno_grad grad;          /* 20 B */
+    u8 bandit_on;
+    u8 grad_on;             /* grad 가 현재 모드 구간에서 갱신 중 */
+};
+
+static struct tcp_congestion_ops tcp_reno_custom;
+
+/* reno_l4s 도 같은 함수를 쓰므로 reno_custom 소켓일 때만 학습 상태를 돌려줌 */
+static struct reno_bandit *reno_custom_bandit(const struct sock *sk)
 {
-    struct reno_bwe *ca = inet_csk_ca(sk);
-    s32 rtt_us = sample->rtt_us;
-    u32 pkts   = sample->pkts_acked;
-    u64 inst_pps;
+    struct reno_custom_sock *ca = inet_csk_ca(sk);
 
-    if (rtt_us <= 0 || pkts == 0)
-        return;
+    if (inet_csk(sk)->icsk_ca_ops != &tcp_reno_custom || !ca->bandit_on)
+        return NULL;
+    return &ca->bandit;
+}
 
-    /* RTT 업데이트 */
-    if (ca->min_rtt_us == 0x7fffffff || (u32)rtt_us < ca->min_rtt_us)
-        ca->min_rtt_us = (u32)rtt_us;
+/* 지연 기울기 모드가 켜진 reno_custom 소켓의 상태, 아니면 NULL */
+static struct reno_grad *reno_custom_grad(const struct sock *sk)
+{
+    struct reno_custom_sock *ca = inet_csk_ca(sk);
 
-    /* BWE = pkts / RTT */
-    inst_pps = (u64)pkts * USEC_PER_SEC;
-    do_div(inst_pps, (u32)rtt_us);
+    if (inet_csk(sk)->icsk_ca_ops != &tcp_reno_custom || !ca->grad_on)
+        return NULL;
+    return &ca->grad;
+}
 
-    ca->bwe_pps = (u32)inst_pps;
+/* ACK 마다 모드 전환 반영: 꺼져 있다가 켜지면 상태를 지금부터 새로 시작 */
+static struct reno_grad *reno_custom_grad_sync(struct sock *sk)
+{
+    struct reno_custom_sock *ca = inet_csk_ca(sk);
+    bool on = READ_ONCE(delay_gradient);
+
+    if (inet_csk(sk)->icsk_ca_ops != &tcp_reno_custom)
+        return NULL;
+    if (on && !ca->grad_on)
+        reno_grad_reset(&ca->grad, tcp_sk(sk)->snd_nxt);
+    ca->grad_on = on;
+    return reno_custom_grad(sk);
+}
 
-    /* EWMA 필터 */
-    if (ca->bwe_filt_pps == 0)
-        ca->bwe_filt_pps = ca->bwe_pps;
-    else
-        ca->bwe_filt_pps = (7 * ca->bwe_filt_pps + ca->bwe_pps) >> 3;
+/* 모듈 파라미터 + 학습 중인 흐름이면 현재 arm 의 cap/감소 설정 */
+static void reno_custom_flow_params(const struct sock *sk, struct reno_bwe_params *p)
+{
+    const struct reno_bandit *b = reno_custom_bandit(sk);
+
+    reno_custom_params(p);
+    if (b)
+        reno_bandit_apply(b, p);
 }
 
-static u32 reno_custom_ssthresh(struct sock *sk)
+static u32 reno_custom_dst_hash(const struct sock *sk)
+{
+#if IS_ENABLED(CONFIG_IPV6)
+    if (sk->sk_family == AF_INET6 && !ipv6_addr_v4mapped(&sk->sk_v6_daddr))
+        return hash_32(ipv6_addr_hash(&sk->sk_v6_daddr), 32);
+#endif
+    return hash_32((__force u32)sk->sk_daddr, 32);
+}
+
+/* 목적지 기본 arm, 기록이 없으면 기본 설정(arm 1) */
+static u32 reno_custom_dst_arm(const struct sock *sk)
+{
+    u32 h = reno_custom_dst_hash(sk);
+    u32 e = READ_ONCE(reno_dst_arm[h & ((1 << RENO_DST_BITS) - 1)]);
+
+    if (e && (e & ~0xffU) == (h & ~0xffU))
+        return (e & 0xffU) - 1;
+    return 1;
+}
+
+static void reno_custom_init(struct sock *sk)
 {
     const struct tcp_sock *tp = tcp_sk(sk);
+    struct reno_custom_sock *ca = inet_csk_ca(sk);
+
+    reno_bwe_reset(&ca->bwe, reno_custom_flow_weight(sk));
+    ca->bandit_on = 0;
+    ca->grad_on = 0;
+    if (inet_csk(sk)->icsk_ca_ops == &tcp_reno_custom && READ_ONCE(bandit)) {
+        reno_bandit_reset(&ca->bandit, reno_custom_dst_arm(sk), tp->snd_nxt,
+                          tp->delivered, tp->lost, (u32)tp->tcp_mstamp);
+        ca->bandit_on = 1;
+    }
+    RENO_STAT_INC(inits);
+}
+
+static void reno_custom_release(struct sock *sk)
+{
+    const struct reno_bandit *b = reno_custom_bandit(sk);
+    u32 h;
+
+    if (!b || b->epochs < RENO_DST_MIN_EPOCHS)
+        return;
+    h = reno_custom_dst_hash(sk);
+    WRITE_ONCE(reno_dst_arm[h & ((1 << RENO_DST_BITS) - 1)],
+               (h & ~0xffU) | (reno_bandit_best(b) + 1));
+    RENO_STAT_INC(bandit_dst_updates);
+}
+
+/*
+ * ACK 마다 불리는 두 훅은 빌트인일 때 tcp_ca_pkts_acked()/tcp_ca_cong_avoid() (include/net/tcp.h) 가
+ * INDIRECT_CALL 로 직접 호출. INDIRECT_CALLABLE_SCOPE 는 CONFIG_RETPOLINE 에 따라 정해짐:
+ * retpoline 커널이면 (모듈로 빌드해도) 전역 심볼, 아니면 static
+ */
+INDIRECT_CALLABLE_DECLARE(void reno_custom_pkts_acked(struct sock *sk,
+                                                      const struct ack_sample *sample));
+INDIRECT_CALLABLE_DECLARE(void reno_custom_cong_avoid(struct sock *sk, u32 ack, u32 acked));
+
+INDIRECT_CALLABLE_SCOPE
+void reno_custom_pkts_acked(struct sock *sk, const struct ack_sample *sample)
+{
     struct reno_bwe *ca = inet_csk_ca(sk);
 
-    u32 reno_half = max(tp->snd_cwnd >> 1U, 2U);
+    RENO_STAT_INC(acks);
 
-    if (ca->min_rtt_us == 0x7fffffff || ca->bwe_filt_pps == 0)
-        return reno_half;
+    /* 최소 RTT + BWE(EWMA) 갱신 */
+    if (READ_ONCE(bwe_mode) == RENO_BWE_WINDOW)
+        reno_bwe_update_window(ca, sample->pkts_acked, sample->rtt_us,
+                               (u32)tcp_sk(sk)->tcp_mstamp);
+    else
+        reno_bwe_update(ca, sample->pkts_acked, sample->rtt_us);
 
-    /* BDP = BWE * min_rtt */
+    /* 학습: ACK 마다는 RTT 경계 비교만 */
     {
-        u64 bdp_pkts = (u64)ca->bwe_filt_pps * (u64)ca->min_rtt_us;
-        u32 target_cwnd;
+        const struct tcp_sock *tp = tcp_sk(sk);
+        struct reno_bandit *b = reno_custom_bandit(sk);
 
-        do_div(bdp_pkts, USEC_PER_SEC);
+        if (b && reno_bandit_on_ack(b, tp->snd_una, tp->snd_nxt, tp->delivered, tp->lost,
+                                    (u32)tp->tcp_mstamp, tp->srtt_us >> 3, ca->min_rtt_us))
+            RENO_STAT_INC(bandit_epochs);
+    }
 
-        if (bdp_pkts < 2)
-            target_cwnd = 2;
-        else if (bdp_pkts > (u64)tp->snd_cwnd * 4U)
-            target_cwnd = tp->snd_cwnd * 4U;
-        else
-            target_cwnd = (u32)bdp_pkts;
+    /* 지연 기울기: 라운드마다 판단, 감소는 라운드당 한 번 */
+    {
+        struct tcp_sock *tp = tcp_sk(sk);
+        struct reno_grad *g = reno_custom_grad_sync(sk);
 
-        return max(target_cwnd, 2U);
+        if (!g)
+            return;
+        reno_grad_sample(g, sample->rtt_us);
+        /* CWR/Recovery/Loss 에서는 PRR/RTO 처리가 cwnd 를 정하므로 기울기만 갱신 */
+        if (reno_grad_round(g, tp->snd_una, tp->snd_nxt, ca->min_rtt_us,
+                            clamp_t(u32, READ_ONCE(grad_thresh), 1U, 1024U)) == RENO_GRAD_DOWN &&
+            inet_csk(sk)->icsk_ca_state < TCP_CA_CWR) {
+            u32 target = reno_grad_target(ca, tp->snd_cwnd,
+                                          clamp_t(u32, READ_ONCE(grad_beta), 1U, 512U));
+
+            if (target < tp->snd_cwnd) {
+                tp->snd_cwnd = target;
+                tp->snd_ssthresh = target;
+                RENO_STAT_INC(grad_reductions);
+            }
+        }
     }
 }
 
-static void reno_custom_cong_avoid(struct sock *sk, u32 ack, u32 acked)
+static u32 reno_custom_ssthresh(struct sock *sk)
+{
+    const struct tcp_sock *tp = tcp_sk(sk);
+    struct reno_bwe *ca = inet_csk_ca(sk);
+    struct reno_bwe_params p;
+    u32 ssthresh, why;
+
+    reno_custom_flow_params(sk, &p);
+
+    /* BDP 기반, 추정값이 없으면 Reno 절반 */
+    ssthresh = reno_bwe_ssthresh_why(ca, tp->snd_cwnd, &p, &why);
+
+    RENO_STAT_INC(loss_events);
+    if (why & RENO_SS_NO_EST)
+        RENO_STAT_INC(loss_no_est);
+    if (why & RENO_SS_BDP)
+        RENO_STAT_INC(loss_bdp);
+    if (why & RENO_SS_FLOOR)
+        RENO_STAT_INC(loss_floor);
+    if (why & RENO_SS_CLAMP)
+        RENO_STAT_INC(loss_clamp);
+    if (why & RENO_SS_WEIGHTED)
+        RENO_STAT_INC(loss_weighted);
+    if (why & RENO_SS_FC)
+        RENO_STAT_INC(loss_fc);
+    return ssthresh;
+}
+
+/* 증가 + BDP 상한 공통부, w: tcp_cong_avoid_ai 계수 (RTT 당 cwnd/w 패킷) */
+static void reno_custom_grow(struct sock *sk, u32 acked, u32 w)
 {
     struct tcp_sock *tp = tcp_sk(sk);
     struct reno_bwe *ca = inet_csk_ca(sk);
+    struct reno_bwe_params p;
 
     if (!tcp_is_cwnd_limited(sk))
         return;
@@ -97,57 +414,453 @@ static void reno_custom_cong_avoid(struct sock *sk, u32 ack, u32 acked)
             return;
     }
 
-    tcp_cong_avoid_ai(tp, tp->snd_cwnd, acked);
-
-    /* cwnd가 BDP의 2배 이상이면 제한 */
-    if (ca->min_rtt_us != 0x7fffffff && ca->bwe_filt_pps > 0) {
-        u64 bdp_pkts = (u64)ca->bwe_filt_pps * (u64)ca->min_rtt_us;
-        u32 cap;
+    tcp_cong_avoid_ai(tp, w, acked);
 
-        do_div(bdp_pkts, USEC_PER_SEC);
-        cap = (u32)bdp_pkts * 2U;
+    /* cwnd가 BDP의 cap_gain 배(기본 2배) 이상이면 제한 */
+    reno_custom_flow_params(sk, &p);
+    {
+        u32 cap = reno_bwe_cap(ca, &p);
 
-        if (cap > 0 && tp->snd_cwnd > cap)
+        if (cap > 0 && tp->snd_cwnd > cap) {
             tp->snd_cwnd = cap;
+            RENO_STAT_INC(cap_events);
+        }
     }
 
     tp->snd_cwnd = min(tp->snd_cwnd, tp->snd_cwnd_clamp);
 }
 
+INDIRECT_CALLABLE_SCOPE
+void reno_custom_cong_avoid(struct sock *sk, u32 ack, u32 acked)
+{
+    const struct reno_bwe *ca = inet_csk_ca(sk);
+    const struct reno_grad *g = reno_custom_grad(sk);
+    u32 n = ca->weight;
+
+    /* 기울기 모드에서 지연이 계속 줄면 HAI: RTT 당 RENO_GRAD_HAI_N 배 */
+    if (g && g->neg_rounds >= RENO_GRAD_HAI_ROUNDS)
+        n *= RENO_GRAD_HAI_N;
+
+    /* 가중치 N: RTT 당 N 패킷 증가 */
+    reno_custom_grow(sk, acked, max(tcp_sk(sk)->snd_cwnd / n, 1U));
+}
+
 static u32 reno_custom_undo_cwnd(struct sock *sk)
 {
     return tcp_sk(sk)->snd_cwnd;
 }
 
+/*
+ * ss -i 로 추정기 상태를 보기 위해 BBR 형식(INET_DIAG_BBRINFO)으로 보고
+ *  - bw: bwe_filt_pps * mss (bytes/s), mrtt: min_rtt_us
+ *  - cwnd_gain: cwnd 상한 배수 (cap_gain/1024 → /256), pacing_gain 은 1.0
+ * ss 는 "bbr:(bw:..,mrtt:..,pacing_gain:1,cwnd_gain:2)" 로 출력
+ */
+static size_t reno_custom_get_info(struct sock *sk, u32 ext, int *attr,
+                                   union tcp_cc_info *info)
+{
+    if (ext & (1 << (INET_DIAG_BBRINFO - 1)) ||
+        ext & (1 << (INET_DIAG_VEGASINFO - 1))) {
+        const struct tcp_sock *tp = tcp_sk(sk);
+        const struct reno_bwe *ca = inet_csk_ca(sk);
+        struct reno_bwe_params p;
+        u64 bw = (u64)ca->bwe_filt_pps * tp->mss_cache;
+
+        reno_custom_flow_params(sk, &p);
+        memset(&info->bbr, 0, sizeof(info->bbr));
+        info->bbr.bbr_bw_lo       = (u32)bw;
+        info->bbr.bbr_bw_hi       = (u32)(bw >> 32);
+        info->bbr.bbr_min_rtt     = ca->min_rtt_us == RENO_MIN_RTT_UNSET ?
+                                    0 : ca->min_rtt_us;
+        info->bbr.bbr_pacing_gain = 256;
+        info->bbr.bbr_cwnd_gain   = p.cap_gain >> 2;
+        *attr = INET_DIAG_BBRINFO;
+        return sizeof(info->bbr);
+    }
+    return 0;
+}
+
+/*
+ * reno_l4s
+ * icsk_ca_priv 앞부분은 struct reno_bwe 이므로 pkts_acked/get_info/ssthresh 는
+ * reno_custom 것을 그대로 사용 (소켓별 상태 60 B)
+ */
+struct reno_l4s_sock {
+    struct reno_bwe bwe;
+    struct reno_l4s l4s;
+    u32 prior_rcv_nxt;      /* 수신측: 지연 ACK 를 이전 CE 상태로 보낼 때의 rcv_nxt */
+    u32 ce_state;           /* 수신측: 마지막으로 받은 패킷의 CE 여부 */
+};
+
+static bool reno_l4s_classic(const struct sock *sk)
+{
+    const struct reno_l4s_sock *ca = inet_csk_ca(sk);
+
+    /* ECN 협상이 안 된 연결은 표시를 받을 수 없으므로 항상 classic */
+    return ca->l4s.classic || !(tcp_sk(sk)->ecn_flags & TCP_ECN_OK);
+}
+
+static void reno_l4s_init(struct sock *sk)
+{
+    const struct tcp_sock *tp = tcp_sk(sk);
+    struct reno_l4s_sock *ca = inet_csk_ca(sk);
+
+    reno_custom_init(sk);
+    reno_l4s_reset(&ca->l4s, tp->snd_nxt, tp->delivered, tp->delivered_ce);
+    ca->prior_rcv_nxt = tp->rcv_nxt;
+    ca->ce_state = 0;
+
+    /* fq 가 없어도 TCP 내부 페이싱 사용 (BBR 과 같은 방식) */
+    cmpxchg(&sk->sk_pacing_status, SK_PACING_NONE, SK_PACING_NEEDED);
+}
+
+/* RTT 창 끝마다 alpha / classic 점수 갱신 */
+static void reno_l4s_in_ack_event(struct sock *sk, u32 flags)
+{
+    const struct tcp_sock *tp = tcp_sk(sk);
+    struct reno_l4s_sock *ca = inet_csk_ca(sk);
+    u32 srtt_us, qdelay_us = 0;
+
+    if (before(tp->snd_una, ca->l4s.next_seq))
+        return;
+
+    srtt_us = tp->srtt_us >> 3;
+    if (ca->bwe.min_rtt_us != RENO_MIN_RTT_UNSET && srtt_us > ca->bwe.min_rtt_us)
+        qdelay_us = srtt_us - ca->bwe.min_rtt_us;
+
+    if (reno_l4s_end_window(&ca->l4s, tp->delivered, tp->delivered_ce, qdelay_us,
+                            max(READ_ONCE(l4s_classic_qdelay_us), 0))) {
+        if (ca->l4s.classic)
+            RENO_STAT_INC(l4s_classic_enter);
+        else
+            RENO_STAT_INC(l4s_classic_exit);
+    }
+    ca->l4s.next_seq = tp->snd_nxt;
+}
+
+/*
+ * 스택은 ECE 를 받으면 창당 한 번 CWR 로 들어가며 ssthresh 를 부름 (손실 복구도 같은 함수)
+ * 여기서는 CE 응답을 돌려주고, 손실이면 reno_l4s_react_to_loss 가 BDP 기반 값으로 덮어씀
+ * (DCTCP 와 같은 구조: Recovery 는 set_state, RTO 는 CA_EVENT_LOSS)
+ */
+static u32 reno_l4s_ssthresh(struct sock *sk)
+{
+    const struct tcp_sock *tp = tcp_sk(sk);
+    struct reno_l4s_sock *ca = inet_csk_ca(sk);
+
+    if (reno_l4s_classic(sk))
+        return reno_custom_ssthresh(sk);
+    return reno_l4s_ce_ssthresh(&ca->l4s, &ca->bwe, tp->snd_cwnd);
+}
+
+/*
+ * 손실 응답: ssthresh 콜백 직후, cwnd 가 줄기 전에 불림
+ * (tcp_enter_recovery 는 set_state(Recovery), tcp_enter_loss 는 CA_EVENT_LOSS 뒤에 cwnd 재설정)
+ * set_state(Loss) 시점에는 cwnd 가 이미 1 근처라 여기서 다시 계산하면 ssthresh 가 무너짐
+ */
+static void reno_l4s_react_to_loss(struct sock *sk)
+{
+    struct reno_l4s_sock *ca = inet_csk_ca(sk);
+
+    ca->l4s.window_signal = 1;
+    /* classic 이면 ssthresh 가 이미 손실 처리를 했음 */
+    if (!reno_l4s_classic(sk))
+        tcp_sk(sk)->snd_ssthresh = reno_custom_ssthresh(sk);
+}
+
+static void reno_l4s_set_state(struct sock *sk, u8 new_state)
+{
+    if (new_state == inet_csk(sk)->icsk_ca_state)
+        return;
+    if (new_state == TCP_CA_CWR && !reno_l4s_classic(sk))
+        RENO_STAT_INC(l4s_ce_reductions);
+    if (new_state == TCP_CA_Recovery)
+        reno_l4s_react_to_loss(sk);
+}
+
+static void reno_l4s_cong_avoid(struct sock *sk, u32 ack, u32 acked)
+{
+    const struct reno_l4s_sock *ca = inet_csk_ca(sk);
+
+    if (reno_l4s_classic(sk)) {
+        reno_custom_cong_avoid(sk, ack, acked);
+        return;
+    }
+    reno_custom_grow(sk, acked,
+                     max(reno_l4s_ai_w(tcp_sk(sk)->snd_cwnd) / ca->bwe.weight, 1U));
+}
+
+/*
+ * 수신측: 패킷마다 CE 를 그대로 ECE 로 되돌려야 송신측 alpha 가 표시 비율이 됨
+ * (RFC 3168 방식은 CWR 까지 ECE 를 유지하므로 비율 정보가 사라짐)
+ * CE 상태가 바뀌면 지연 중인 ACK 를 이전 상태로 먼저 보내고 즉시 ACK (tcp_dctcp.h 와 같음)
+ */
+static void reno_l4s_ece_ack_cwr(struct sock *sk, u32 ce_state)
+{
+    struct tcp_sock *tp = tcp_sk(sk);
+
+    if (ce_state)
+        tp->ecn_flags |= TCP_ECN_DEMAND_CWR;
+    else
+        tp->ecn_flags &= ~TCP_ECN_DEMAND_CWR;
+}
+
+static void reno_l4s_cwnd_event(struct sock *sk, enum tcp_ca_event ev)
+{
+    struct reno_l4s_sock *ca = inet_csk_ca(sk);
+    u32 new_ce_state;
+
+    if (ev == CA_EVENT_LOSS) {
+        reno_l4s_react_to_loss(sk);
+        return;
+    }
+    if (ev != CA_EVENT_ECN_IS_CE && ev != CA_EVENT_ECN_NO_CE)
+        return;
+
+    new_ce_state = ev == CA_EVENT_ECN_IS_CE;
+    if (ca->ce_state != new_ce_state) {
+        if (inet_csk(sk)->icsk_ack.pending & ICSK_ACK_TIMER) {
+            reno_l4s_ece_ack_cwr(sk, ca->ce_state);
+            __tcp_send_ack(sk, ca->prior_rcv_nxt);
+        }
+        inet_csk(sk)->icsk_ack.pending |= ICSK_ACK_NOW;
+    }
+    ca->prior_rcv_nxt = tcp_sk(sk)->rcv_nxt;
+    ca->ce_state = new_ce_state;
+    reno_l4s_ece_ack_cwr(sk, new_ce_state);
+}
+
+/* /proc/net/reno_custom: "이름 값" 한 줄씩, 모든 CPU 합 */
+static int reno_custom_stats_show(struct seq_file *seq, void *v)
+{
+    struct reno_custom_stats sum = {};
+    int cpu;
+
+    for_each_possible_cpu(cpu) {
+        const struct reno_custom_stats *s = per_cpu_ptr(&reno_custom_stats, cpu);
+
+        sum.inits         += s->inits;
+        sum.acks          += s->acks;
+        sum.loss_events   += s->loss_events;
+        sum.loss_no_est   += s->loss_no_est;
+        sum.loss_bdp      += s->loss_bdp;
+        sum.loss_floor    += s->loss_floor;
+        sum.loss_clamp    += s->loss_clamp;
+        sum.loss_weighted += s->loss_weighted;
+        sum.loss_fc       += s->loss_fc;
+        sum.cap_events    += s->cap_events;
+        sum.l4s_ce_reductions += s->l4s_ce_reductions;
+        sum.l4s_classic_enter += s->l4s_classic_enter;
+        sum.l4s_classic_exit  += s->l4s_classic_exit;
+        sum.bandit_epochs      += s->bandit_epochs;
+        sum.bandit_dst_updates += s->bandit_dst_updates;
+        sum.grad_reductions    += s->grad_reductions;
+        sum.repair_dumps       += s->repair_dumps;
+        sum.repair_restores    += s->repair_restores;
+        sum.repair_rejects     += s->repair_rejects;
+    }
+
+    seq_printf(seq, "inits %llu\n", sum.inits);
+    seq_printf(seq, "acks %llu\n", sum.acks);
+    seq_printf(seq, "loss_events %llu\n", sum.loss_events);
+    seq_printf(seq, "loss_no_estimate %llu\n", sum.loss_no_est);
+    seq_printf(seq, "loss_bdp %llu\n", sum.loss_bdp);
+    seq_printf(seq, "loss_bdp_floor %llu\n", sum.loss_floor);
+    seq_printf(seq, "loss_bdp_clamp %llu\n", sum.loss_clamp);
+    seq_printf(seq, "loss_weighted_floor %llu\n", sum.loss_weighted);
+    seq_printf(seq, "loss_fast_convergence %llu\n", sum.loss_fc);
+    seq_printf(seq, "cap_events %llu\n", sum.cap_events);
+    seq_printf(seq, "l4s_ce_reductions %llu\n", sum.l4s_ce_reductions);
+    seq_printf(seq, "l4s_classic_enter %llu\n", sum.l4s_classic_enter);
+    seq_printf(seq, "l4s_classic_exit %llu\n", sum.l4s_classic_exit);
+    seq_printf(seq, "bandit_epochs %llu\n", sum.bandit_epochs);
+    seq_printf(seq, "bandit_dst_updates %llu\n", sum.bandit_dst_updates);
+    seq_printf(seq, "grad_reductions %llu\n", sum.grad_reductions);
+    seq_printf(seq, "repair_dumps %llu\n", sum.repair_dumps);
+    seq_printf(seq, "repair_restores %llu\n", sum.repair_restores);
+    seq_printf(seq, "repair_rejects %llu\n", sum.repair_rejects);
+    return 0;
+}
 
 static struct tcp_congestion_ops tcp_reno_custom = {
     .init       = reno_custom_init,
+    .release    = reno_custom_release,
     .ssthresh   = reno_custom_ssthresh,
     .cong_avoid = reno_custom_cong_avoid,
     .undo_cwnd  = reno_custom_undo_cwnd,
     .pkts_acked = reno_custom_pkts_acked,
+    .get_info   = reno_custom_get_info,
 
     .owner      = THIS_MODULE,
     .name       = "reno_custom",   /* ⭐ 모듈 이름 변경! */
 };
 
+static struct tcp_congestion_ops tcp_reno_l4s = {
+    .init         = reno_l4s_init,
+    .in_ack_event = reno_l4s_in_ack_event,
+    .ssthresh     = reno_l4s_ssthresh,
+    .cong_avoid   = reno_l4s_cong_avoid,
+    .set_state    = reno_l4s_set_state,
+    .cwnd_event   = reno_l4s_cwnd_event,
+    .undo_cwnd    = reno_custom_undo_cwnd,
+    .pkts_acked   = reno_custom_pkts_acked,
+    .get_info     = reno_custom_get_info,
+
+    .flags        = TCP_CONG_NEEDS_ECN,
+    .owner        = THIS_MODULE,
+    .name         = "reno_l4s",
+};
+
+/*
+ * TCP_REPAIR 체크포인트/복원
+ * 혼잡 제어 모듈은 소켓 옵션을 추가할 수 없으므로 proc 파일 ioctl 로 받고,
+ * 요청의 fd 는 호출자(CRIU 액션 스크립트, pidfd_getfd 로 가져온 reno_repair 등)의 소켓.
+ * 덤프와 복원 모두 repair 모드 소켓에만, 권한은 TCP_REPAIR 와 같은 CAP_NET_ADMIN.
+ * 복원은 혼잡 제어를 다시 초기화한 뒤(L4S/학습/기울기 상태는 현재 시퀀스로 새로 시작)
+ * 추정기와 cwnd/ssthresh 만 덮어씀. 가중치는 복원된 SO_MARK/cgroup 기준 값을 유지.
+ */
+static int reno_custom_repair(struct sock *sk, unsigned int cmd, struct reno_ca_state *st)
+{
+    const struct tcp_congestion_ops *ops;
+    struct tcp_sock *tp = tcp_sk(sk);
+    struct reno_bwe *ca = inet_csk_ca(sk);
+    u32 weight;
+    int err = 0;
+
+    if (sk->sk_protocol != IPPROTO_TCP || sk->sk_type != SOCK_STREAM)
+        return -EOPNOTSUPP;
+    if (!ns_capable(sock_net(sk)->user_ns, CAP_NET_ADMIN))
+        return -EPERM;
+
+    lock_sock(sk);
+    ops = inet_csk(sk)->icsk_ca_ops;
+    if (!tp->repair) {
+        err = -EPERM;
+    } else if (ops != &tcp_reno_custom && ops != &tcp_reno_l4s) {
+        err = -EINVAL;
+    } else if (cmd == RENO_IOC_DUMP) {
+        memset(st, 0, sizeof(*st));
+        strscpy(st->cc, ops->name, sizeof(st->cc));
+        st->bwe          = *ca;
+        st->snd_cwnd     = tp->snd_cwnd;
+        st->snd_ssthresh = tp->snd_ssthresh;
+        st->mss          = tp->mss_cache;
+        reno_state_seal(st);
+        RENO_STAT_INC(repair_dumps);
+    } else if (!reno_state_valid(st) || strncmp(st->cc, ops->name, sizeof(st->cc))) {
+        err = -EINVAL;
+    } else {
+        ops->init(sk);
+        weight = ca->weight;
+        *ca = st->bwe;
+        ca->weight       = weight;
+        ca->bwe_pps      = reno_state_scale_pps(ca->bwe_pps, st->mss, tp->mss_cache);
+        ca->bwe_filt_pps = reno_state_scale_pps(ca->bwe_filt_pps, st->mss, tp->mss_cache);
+        ca->loss_bwe_pps = reno_state_scale_pps(ca->loss_bwe_pps, st->mss, tp->mss_cache);
+        /* 구간 시작 시각은 원래 호스트 시계 기준이므로 새로 시작 */
+        ca->win_start_us = 0;
+        ca->win_pkts     = 0;
+        tp->snd_cwnd     = min(st->snd_cwnd, tp->snd_cwnd_clamp);
+        tp->snd_ssthresh = st->snd_ssthresh;
+        RENO_STAT_INC(repair_restores);
+    }
+    release_sock(sk);
+    return err;
+}
+
+static long reno_custom_repair_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
+{
+    struct reno_repair_req req;
+    struct socket *sock;
+    int err;
+
+    if (cmd != RENO_IOC_DUMP && cmd != RENO_IOC_RESTORE)
+        return -ENOTTY;
+    if (copy_from_user(&req, (void __user *)arg, sizeof(req)))
+        return -EFAULT;
+    if (req.flags)
+        return -EINVAL;
+
+    sock = sockfd_lookup(req.fd, &err);
+    if (!sock)
+        return err;
+    err = reno_custom_repair(sock->sk, cmd, &req.state);
+    sockfd_put(sock);
+
+    if (!err && cmd == RENO_IOC_DUMP &&
+        copy_to_user((void __user *)arg, &req, sizeof(req)))
+        err = -EFAULT;
+    if (err)
+        RENO_STAT_INC(repair_rejects);
+    return err;
+}
+
+static const struct proc_ops reno_custom_repair_ops = {
+    .proc_ioctl        = reno_custom_repair_ioctl,
+    .proc_compat_ioctl = compat_ptr_ioctl,
+    .proc_lseek        = noop_llseek,
+};
+
+/* proc 파일은 netns 마다 (초기 netns 에만 만들면 컨테이너 안의 CRIU/익스포터가 못 찾음) */
+static int __net_init reno_custom_net_init(struct net *net)
+{
+    if (!proc_create_single("reno_custom", 0444, net->proc_net,
+                            reno_custom_stats_show))
+        return -ENOMEM;
+    if (!proc_create("reno_custom_repair", 0600, net->proc_net,
+                     &reno_custom_repair_ops)) {
+        remove_proc_entry("reno_custom", net->proc_net);
+        return -ENOMEM;
+    }
+    return 0;
+}
+
+static void __net_exit reno_custom_net_exit(struct net *net)
+{
+    remove_proc_entry("reno_custom_repair", net->proc_net);
+    remove_proc_entry("reno_custom", net->proc_net);
+}
+
+static struct pernet_operations reno_custom_net_ops = {
+    .init = reno_custom_net_init,
+    .exit = reno_custom_net_exit,
+};
+
 static int __init reno_custom_module_init(void)
 {
     int ret;
 
-    BUILD_BUG_ON(sizeof(struct reno_bwe) > ICSK_CA_PRIV_SIZE);
+    BUILD_BUG_ON(sizeof(struct reno_custom_sock) > ICSK_CA_PRIV_SIZE);
+    BUILD_BUG_ON(sizeof(struct reno_l4s_sock) > ICSK_CA_PRIV_SIZE);
+
+    ret = register_pernet_subsys(&reno_custom_net_ops);
+    if (ret)
+        goto err_out;
 
     ret = tcp_register_congestion_control(&tcp_reno_custom);
     if (ret)
-        pr_err("reno_custom: registration failed (%d)\n", ret);
-    else
-        pr_info("reno_custom: registered\n");
+        goto err_pernet;
+    ret = tcp_register_congestion_control(&tcp_reno_l4s);
+    if (ret)
+        goto err_custom;
+
+    pr_info("reno_custom: registered (reno_custom, reno_l4s)\n");
+    return 0;
+
+err_custom:
+    tcp_unregister_congestion_control(&tcp_reno_custom);
+err_pernet:
+    unregister_pernet_subsys(&reno_custom_net_ops);
+err_out:
+    pr_err("reno_custom: registration failed (%d)\n", ret);
     return ret;
 }
 
 static void __exit reno_custom_module_exit(void)
 {
+    tcp_unregister_congestion_control(&tcp_reno_l4s);
     tcp_unregister_congestion_control(&tcp_reno_custom);
+    unregister_pernet_subsys(&reno_custom_net_ops);
     pr_info("reno_custom: unregistered\n");
 }
 
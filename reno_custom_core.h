@@ -0,0 +1,608 @@
+#ifndef RENO_CUSTOM_CORE_H
+#define RENO_CUSTOM_CORE_H
+
+/*
+ * reno_custom 알고리즘 코어 (커널 모듈과 유저스페이스 라이브러리가 공유)
+ * - BWE/최소 RTT 추정기, BDP 계산, BDP 기반 ssthresh, cwnd 상한
+ * - L4S(scalable ECN) 모드: CE 비율(alpha), 비율 비례 감소, classic 큐 감지
+ * - 흐름별 파라미터 학습 (bandit): cap/감소 설정 몇 개를 epoch 단위로 번갈아 평가
+ * - 지연 기울기 모드: 라운드별 RTT 기울기가 양수로 커지면 곱셈 감소 (ECN 없는 µs RTT 패브릭)
+ * - 메모리 할당 없음, 부동소수점 없음, 64비트 포화 연산만 사용
+ * - 커널: reno_custom.c 가 icsk_ca_priv 에 struct reno_bwe 를 둠
+ *   유저스페이스: reno_cc.c 가 struct reno_cc 안에 포함
+ */
+
+#ifdef __KERNEL__
+#include <linux/types.h>
+#include <linux/math64.h>
+#define RENO_DIV_U64(n, d) div_u64((n), (d))
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#define RENO_DIV_U64(n, d) ((n) / (d))
+#endif
+
+#define RENO_MIN_RTT_UNSET  0x7fffffffU
+#define RENO_MAX_WEIGHT     16U
+#define RENO_USEC_PER_SEC   1000000U
+#define RENO_CAP_GAIN_DEF   2048U   /* cwnd 상한 = BDP * 2 (/1024) */
+
+/* reno_bwe_ssthresh_why() 가 알려 주는 손실 처리 분기 (비트 조합) */
+#define RENO_SS_NO_EST      (1U << 0)   /* 추정값 없음 → (가중) Reno 감소 */
+#define RENO_SS_BDP         (1U << 1)   /* BDP 사용 */
+#define RENO_SS_FLOOR       (1U << 2)   /* BDP < 2 → 2 */
+#define RENO_SS_CLAMP       (1U << 3)   /* BDP > cwnd*4 → cwnd*4 */
+#define RENO_SS_WEIGHTED    (1U << 4)   /* MulTCP 감소폭이 하한으로 적용 */
+#define RENO_SS_FC          (1U << 5)   /* fast convergence 양보 */
+
+/* BWE 추정 방식 */
+#define RENO_BWE_ACK        0U      /* ACK 당 pkts_acked / RTT (기존) */
+#define RENO_BWE_WINDOW     1U      /* min_rtt 이상 구간의 누적 ACK / 경과 시간 (Westwood) */
+
+struct reno_bwe {
+    uint32_t min_rtt_us;
+    uint32_t bwe_pps;
+    uint32_t bwe_filt_pps;
+    uint32_t weight;        /* MulTCP 가중치 N, 1 = Reno 한 흐름 */
+    uint32_t loss_bwe_pps;  /* 직전 손실 시점의 bwe_filt_pps */
+    uint32_t win_start_us;  /* RENO_BWE_WINDOW: 현재 구간 시작 (µs, wrap 허용) */
+    uint32_t win_pkts;      /* RENO_BWE_WINDOW: 현재 구간 누적 ACK 패킷 */
+};
+
+/* 손실 시 정책 (커널은 모듈 파라미터, 유저스페이스는 설정값으로 채움) */
+struct reno_bwe_params {
+    bool weighted;          /* MulTCP 감소폭을 하한으로 사용 */
+    uint32_t fc_beta;       /* fast convergence 계수 /1024, 0 이면 끔 */
+    uint32_t cap_gain;      /* cwnd 상한 = BDP * cap_gain/1024, 0 이면 상한 없음 */
+    uint32_t loss_beta;     /* 손실 시 BDP 배수 /1024, 0 이면 1024 (BDP 그대로) */
+};
+
+/*
+ * 100G / BIG TCP 급 창에서도 wrap 되지 않도록 중간값은 64비트로 계산하고
+ * u32 로 내릴 때는 포화(saturate)시킨다.
+ */
+static inline uint32_t reno_sat_u32(uint64_t v)
+{
+    return v > 0xffffffffULL ? 0xffffffffU : (uint32_t)v;
+}
+
+static inline void reno_bwe_reset(struct reno_bwe *ca, uint32_t weight)
+{
+    ca->min_rtt_us   = RENO_MIN_RTT_UNSET;
+    ca->bwe_pps      = 0;
+    ca->bwe_filt_pps = 0;
+    ca->weight       = weight ? weight : 1;
+    ca->loss_bwe_pps = 0;
+    ca->win_start_us = 0;
+    ca->win_pkts     = 0;
+}
+
+static inline bool reno_bwe_valid(const struct reno_bwe *ca)
+{
+    return ca->min_rtt_us != RENO_MIN_RTT_UNSET && ca->bwe_filt_pps != 0;
+}
+
+/* 순간 BWE 샘플을 bwe_pps 에 넣고 EWMA 1/8 필터 갱신 */
+static inline void reno_bwe_filter(struct reno_bwe *ca, uint64_t inst_pps)
+{
+    ca->bwe_pps = reno_sat_u32(inst_pps);
+
+    /* EWMA 필터 (7 * bwe_filt_pps 는 u32 를 넘을 수 있으므로 64비트) */
+    if (ca->bwe_filt_pps == 0)
+        ca->bwe_filt_pps = ca->bwe_pps;
+    else
+        ca->bwe_filt_pps = (uint32_t)(((uint64_t)ca->bwe_filt_pps * 7U + ca->bwe_pps) >> 3);
+}
+
+/* ACK 샘플 하나로 최소 RTT 와 BWE(EWMA 1/8) 갱신 */
+static inline void reno_bwe_update(struct reno_bwe *ca, uint32_t pkts, int32_t rtt_us)
+{
+    if (rtt_us <= 0 || pkts == 0)
+        return;
+
+    /* RTT 업데이트 */
+    if ((uint32_t)rtt_us < ca->min_rtt_us)
+        ca->min_rtt_us = (uint32_t)rtt_us;
+
+    /* BWE = pkts / RTT, GSO/GRO 로 pkts 가 크고 RTT 가 µs 단위면 u32 를 넘을 수 있음 */
+    reno_bwe_filter(ca, RENO_DIV_U64((uint64_t)pkts * RENO_USEC_PER_SEC, (uint32_t)rtt_us));
+}
+
+/*
+ * RENO_BWE_WINDOW: 최소 RTT 이상 지난 구간마다 누적 ACK / 경과 시간을 한 샘플로 사용
+ * ACK 하나의 pkts/RTT 는 ACK 당 패킷 수(보통 1~2)만큼만 보므로 실제 전달률을
+ * 크게 과소평가하는데, 구간 누적은 그 RTT 동안 실제로 전달된 양을 센다.
+ * now_us 는 u32 로 잘린 단조 시각 (구간 길이 < 2^31 µs 면 wrap 무관)
+ */
+static inline void reno_bwe_update_window(struct reno_bwe *ca, uint32_t pkts,
+                                          int32_t rtt_us, uint32_t now_us)
+{
+    uint32_t elapsed;
+
+    if (rtt_us > 0 && (uint32_t)rtt_us < ca->min_rtt_us)
+        ca->min_rtt_us = (uint32_t)rtt_us;
+    if (pkts == 0)
+        return;
+
+    if (ca->win_start_us == 0) {
+        ca->win_start_us = now_us ? now_us : 1;
+        ca->win_pkts = 0;
+    }
+    ca->win_pkts += pkts;
+
+    elapsed = now_us - ca->win_start_us;
+    if (ca->min_rtt_us == RENO_MIN_RTT_UNSET || elapsed < ca->min_rtt_us || elapsed == 0)
+        return;
+
+    reno_bwe_filter(ca, RENO_DIV_U64((uint64_t)ca->win_pkts * RENO_USEC_PER_SEC, elapsed));
+    ca->win_start_us = now_us ? now_us : 1;
+    ca->win_pkts = 0;
+}
+
+/* BDP(패킷) = bwe_filt_pps * min_rtt_us / 1e6, 추정값이 없으면 0 */
+static inline uint64_t reno_bwe_bdp(const struct reno_bwe *ca)
+{
+    if (!reno_bwe_valid(ca))
+        return 0;
+
+    /* u32 * u31 이므로 u64 곱셈은 넘치지 않음 */
+    return RENO_DIV_U64((uint64_t)ca->bwe_filt_pps * ca->min_rtt_us, RENO_USEC_PER_SEC);
+}
+
+/* MulTCP 감소: cwnd * (1 - 1/(2N)), N=1 이면 Reno 절반 */
+static inline uint32_t reno_bwe_weighted_md(uint32_t cwnd, uint32_t weight)
+{
+    uint32_t target;
+
+    if (weight <= 1)
+        target = cwnd >> 1U;
+    else
+        target = cwnd - cwnd / (2U * weight);
+    return target > 2U ? target : 2U;
+}
+
+/*
+ * 손실 시 ssthresh: 추정값이 있으면 BDP, 없으면 (가중) Reno 감소
+ * why 가 NULL 이 아니면 거친 분기를 RENO_SS_* 비트로 기록 (통계용)
+ */
+static inline uint32_t reno_bwe_ssthresh_why(struct reno_bwe *ca, uint32_t cwnd,
+                                             const struct reno_bwe_params *p,
+                                             uint32_t *why)
+{
+    uint32_t reno_half = reno_bwe_weighted_md(cwnd, ca->weight);
+    uint64_t bdp_pkts, max_cwnd;
+    uint32_t target_cwnd, w;
+
+    if (!reno_bwe_valid(ca)) {
+        if (why)
+            *why = RENO_SS_NO_EST;
+        return reno_half;
+    }
+
+    /* BDP = BWE * min_rtt, 상한은 cwnd * 4 */
+    bdp_pkts = reno_bwe_bdp(ca);
+    max_cwnd = (uint64_t)cwnd * 4U;
+    w = RENO_SS_BDP;
+
+    if (bdp_pkts < 2) {
+        target_cwnd = 2;
+        w |= RENO_SS_FLOOR;
+    } else if (bdp_pkts >= max_cwnd) {
+        target_cwnd = reno_sat_u32(max_cwnd);
+        w |= RENO_SS_CLAMP;
+    } else {
+        target_cwnd = reno_sat_u32(bdp_pkts);
+    }
+
+    if (p->loss_beta && p->loss_beta != 1024U)
+        target_cwnd = reno_sat_u32(((uint64_t)target_cwnd * p->loss_beta) >> 10);
+
+    /* 가중 흐름은 MulTCP 감소폭보다 더 줄이지 않음 */
+    if (p->weighted && target_cwnd < reno_half) {
+        target_cwnd = reno_half;
+        w |= RENO_SS_WEIGHTED;
+    }
+
+    /* BWE 가 이전 손실 때보다 줄었으면 BDP 몫보다 더 양보 */
+    if (p->fc_beta && ca->bwe_filt_pps < ca->loss_bwe_pps) {
+        target_cwnd = (uint32_t)(((uint64_t)target_cwnd * p->fc_beta) >> 10);
+        w |= RENO_SS_FC;
+    }
+    ca->loss_bwe_pps = ca->bwe_filt_pps;
+
+    if (why)
+        *why = w;
+    return target_cwnd > 2U ? target_cwnd : 2U;
+}
+
+static inline uint32_t reno_bwe_ssthresh(struct reno_bwe *ca, uint32_t cwnd,
+                                         const struct reno_bwe_params *p)
+{
+    return reno_bwe_ssthresh_why(ca, cwnd, p, NULL);
+}
+
+/*
+ * cwnd 상한 = BDP * cap_gain/1024 (패킷, 기본 2배), 추정값이 없으면 0 (상한 없음)
+ * 폴리서 경로에서는 1배 근처로 낮춰 cwnd 가 정책 속도를 크게 넘지 않게 함
+ */
+static inline uint32_t reno_bwe_cap(const struct reno_bwe *ca,
+                                    const struct reno_bwe_params *p)
+{
+    uint64_t cap;
+
+    if (!p->cap_gain)
+        return 0;
+    /* bdp < 2^43, cap_gain < 2^14 이므로 곱은 u64 안, u32 로는 포화 */
+    cap = (reno_bwe_bdp(ca) * p->cap_gain) >> 10;
+    return reno_sat_u32(cap);
+}
+
+/*
+ * L4S / scalable ECN 모드 (커널 reno_l4s)
+ *  - alpha: 한 RTT 창 동안 CE 표시된 전달 패킷 비율의 EWMA (/1024, DCTCP 와 같은 방식)
+ *  - CE 응답: cwnd * (1 - alpha/2), 즉 표시된 패킷 하나당 약 1/2 패킷 감소
+ *    단 BDP(reno_bwe) 아래로는 내리지 않음 (얕은 표시 임계값에서 이용률 유지)
+ *  - classic 큐 감지: 표시/손실이 있는 창에서 큐 지연(srtt - min_rtt)이 임계값을 넘으면
+ *    점수 증가, 아니면 감소. 점수가 상한에 닿으면 classic 모드 (Reno 증가, BDP 기반 절반),
+ *    0 으로 내려오면 L4S 로 복귀 (히스테리시스)
+ */
+#define RENO_L4S_ALPHA_ONE      1024U
+#define RENO_L4S_G_SHIFT        4U      /* alpha EWMA 이득 1/16 */
+#define RENO_L4S_CLASSIC_MAX    8U      /* 이 점수에서 classic 전환 */
+#define RENO_L4S_AI_DIV         64U     /* L4S 증가: RTT 당 max(1, cwnd/64) */
+
+struct reno_l4s {
+    uint32_t alpha;             /* CE 비율 EWMA /1024 */
+    uint32_t next_seq;          /* 현재 RTT 창이 끝나는 snd_nxt */
+    uint32_t prior_delivered;   /* 창 시작 시 tp->delivered */
+    uint32_t prior_delivered_ce;
+    uint32_t win_ce;            /* 직전 창의 CE 패킷 수 (진단용) */
+    uint16_t classic_score;
+    uint8_t classic;            /* 1 = classic 큐로 판단, Reno 방식 동작 */
+    uint8_t window_signal;      /* 현재 창에 CE 또는 손실이 있었음 */
+};
+
+static inline void reno_l4s_reset(struct reno_l4s *l, uint32_t snd_nxt,
+                                  uint32_t delivered, uint32_t delivered_ce)
+{
+    /* DCTCP 와 같이 처음에는 최대 alpha 로 시작해 첫 표시에서 보수적으로 반응 */
+    l->alpha              = RENO_L4S_ALPHA_ONE;
+    l->next_seq           = snd_nxt;
+    l->prior_delivered    = delivered;
+    l->prior_delivered_ce = delivered_ce;
+    l->win_ce             = 0;
+    l->classic_score      = 0;
+    l->classic            = 0;
+    l->window_signal      = 0;
+}
+
+/*
+ * RTT 창이 끝났을 때 (snd_una 가 next_seq 를 지남) 호출
+ * delivered / delivered_ce: 누적 전달 / CE 전달 패킷, qdelay_us: srtt - min_rtt
+ * classic 상태가 바뀌면 true
+ */
+static inline bool reno_l4s_end_window(struct reno_l4s *l, uint32_t delivered,
+                                       uint32_t delivered_ce, uint32_t qdelay_us,
+                                       uint32_t classic_qdelay_us)
+{
+    uint32_t d = delivered - l->prior_delivered;
+    uint32_t ce = delivered_ce - l->prior_delivered_ce;
+    uint32_t frac = 0;
+    uint8_t was = l->classic;
+
+    if (d) {
+        /* ce <= d 이므로 frac <= 1024 */
+        frac = (uint32_t)RENO_DIV_U64((uint64_t)ce * RENO_L4S_ALPHA_ONE, d);
+        l->alpha = l->alpha - (l->alpha >> RENO_L4S_G_SHIFT) + (frac >> RENO_L4S_G_SHIFT);
+    }
+    l->win_ce = ce;
+    l->prior_delivered = delivered;
+    l->prior_delivered_ce = delivered_ce;
+
+    if (ce)
+        l->window_signal = 1;
+    /* 표시/손실이 있는데 큐가 깊다 = 깊은 임계값에서 표시하는 classic AQM 또는 드롭 큐 */
+    if (l->window_signal && qdelay_us > classic_qdelay_us) {
+        if (l->classic_score < RENO_L4S_CLASSIC_MAX)
+            l->classic_score++;
+    } else if (l->classic_score > 0 && qdelay_us <= classic_qdelay_us) {
+        l->classic_score--;
+    }
+    if (l->classic_score >= RENO_L4S_CLASSIC_MAX)
+        l->classic = 1;
+    else if (l->classic_score == 0)
+        l->classic = 0;
+    l->window_signal = 0;
+    return was != l->classic;
+}
+
+/* CE 응답 ssthresh: cwnd * (1 - alpha/2), BDP 와 2 를 하한으로 (cwnd 보다 크게는 안 함) */
+static inline uint32_t reno_l4s_ce_ssthresh(const struct reno_l4s *l,
+                                            const struct reno_bwe *ca, uint32_t cwnd)
+{
+    uint64_t reduce = ((uint64_t)cwnd * l->alpha) >> 11;
+    uint32_t target = cwnd - (uint32_t)reduce;
+    uint64_t bdp = reno_bwe_bdp(ca);
+
+    if (bdp > target)
+        target = bdp < cwnd ? (uint32_t)bdp : cwnd;
+    return target > 2U ? target : 2U;
+}
+
+/* L4S 증가 계수: tcp_cong_avoid_ai 의 w (RTT 당 cwnd/w 패킷 증가) */
+static inline uint32_t reno_l4s_ai_w(uint32_t cwnd)
+{
+    if (cwnd < 1U)
+        return 1U;
+    return cwnd < RENO_L4S_AI_DIV ? cwnd : RENO_L4S_AI_DIV;
+}
+
+/*
+ * 흐름별 파라미터 학습 (multi-armed bandit)
+ *  - arm = (cap_gain, loss_beta) 조합, 한 epoch(RENO_BANDIT_EPOCH_RTTS RTT) 동안 한 arm 사용
+ *  - epoch 이 끝나면 정수 효용으로 점수(EWMA 1/4) 갱신
+ *      효용 = 전달률(pps) * (1024 - 지연 벌점 - 손실 벌점) / 1024
+ *      지연 벌점 = 256 * 평균 큐 지연 / min_rtt (큐 지연 = min_rtt 이면 25%)
+ *      손실 벌점 = 10 * 1024 * 손실 / 전달   (손실 1% 면 10%)
+ *  - 선택: 탐색 epoch 에는 가장 적게 써 본 arm, 그 외에는 점수가 가장 높은 arm
+ *    탐색 주기는 4 → 8 → 16 epoch 으로 늘어나 최선 arm 에 수렴
+ *  - ACK 마다는 RTT 경계 비교만, 나머지는 RTT/epoch 마다 (64비트 나눗셈은 epoch 당 몇 번)
+ */
+#define RENO_BANDIT_ARMS        4U
+#define RENO_BANDIT_EPOCH_RTTS  4U
+#define RENO_BANDIT_DELAY_W     256U
+#define RENO_BANDIT_LOSS_W      10U
+
+struct reno_bandit_arm {
+    uint32_t cap_gain;
+    uint32_t loss_beta;
+};
+
+/* 0: 폴리서형 낮은 상한, 1: 기본값, 2: 높은 상한, 3: 기본 상한 + 더 큰 양보 */
+static const struct reno_bandit_arm reno_bandit_arms[RENO_BANDIT_ARMS] = {
+    { 1280U, 1024U },
+    { 2048U, 1024U },
+    { 3072U, 1024U },
+    { 2048U,  870U },
+};
+
+struct reno_bandit {
+    int32_t score[RENO_BANDIT_ARMS];
+    uint16_t pulls[RENO_BANDIT_ARMS];
+    uint16_t epochs;
+    uint8_t arm;            /* 현재 arm */
+    uint8_t rounds;         /* 이번 epoch 에서 지난 RTT 수 */
+    uint32_t next_seq;      /* 현재 RTT 가 끝나는 snd_nxt */
+    uint32_t ep_delivered;  /* epoch 시작 시 누적 전달 */
+    uint32_t ep_lost;
+    uint32_t ep_start_us;
+    uint32_t qd_sum_us;     /* RTT 마다 큐 지연 합 */
+    uint32_t qd_n;
+};
+
+static inline void reno_bandit_reset(struct reno_bandit *b, uint32_t arm, uint32_t snd_nxt,
+                                     uint32_t delivered, uint32_t lost, uint32_t now_us)
+{
+    uint32_t i;
+
+    for (i = 0; i < RENO_BANDIT_ARMS; i++) {
+        b->score[i] = 0;
+        b->pulls[i] = 0;
+    }
+    b->epochs       = 0;
+    b->arm          = arm < RENO_BANDIT_ARMS ? (uint8_t)arm : 1U;
+    b->rounds       = 0;
+    b->next_seq     = snd_nxt;
+    b->ep_delivered = delivered;
+    b->ep_lost      = lost;
+    b->ep_start_us  = now_us;
+    b->qd_sum_us    = 0;
+    b->qd_n         = 0;
+}
+
+static inline void reno_bandit_apply(const struct reno_bandit *b, struct reno_bwe_params *p)
+{
+    const struct reno_bandit_arm *a = &reno_bandit_arms[b->arm];
+
+    /* cap_gain=0(상한 없음)으로 끈 경우는 유지 */
+    if (p->cap_gain)
+        p->cap_gain = a->cap_gain;
+    p->loss_beta = a->loss_beta;
+}
+
+static inline int64_t reno_bandit_utility(uint32_t delivered, uint32_t lost, uint32_t elapsed_us,
+                                          uint32_t qdelay_us, uint32_t min_rtt_us)
+{
+    uint64_t rate, d_pen, l_pen;
+
+    if (!elapsed_us || !delivered)
+        return 0;
+    rate = RENO_DIV_U64((uint64_t)delivered * RENO_USEC_PER_SEC, elapsed_us);
+    d_pen = min_rtt_us && min_rtt_us != RENO_MIN_RTT_UNSET ?
+            RENO_DIV_U64((uint64_t)qdelay_us * RENO_BANDIT_DELAY_W, min_rtt_us) : 0;
+    l_pen = RENO_DIV_U64((uint64_t)lost * RENO_BANDIT_LOSS_W * 1024U, delivered);
+    if (d_pen > 2048U)
+        d_pen = 2048U;
+    if (l_pen > 2048U)
+        l_pen = 2048U;
+    /* 벌점 합이 1024 를 넘으면 음수: 부호 있는 곱으로 계산 (2^50 * 3072 < 2^63) */
+    if (rate > (1ULL << 50))
+        rate = 1ULL << 50;
+    return (int64_t)rate * (1024 - (int64_t)d_pen - (int64_t)l_pen) / 1024;
+}
+
+static inline int32_t reno_sat_s32(int64_t v)
+{
+    if (v > 0x7fffffffLL)
+        return 0x7fffffff;
+    if (v < -0x7fffffffLL)
+        return -0x7fffffff;
+    return (int32_t)v;
+}
+
+/* 가장 점수가 높은 arm (써 본 arm 이 없으면 현재 arm) */
+static inline uint32_t reno_bandit_best(const struct reno_bandit *b)
+{
+    uint32_t i, best = b->arm;
+
+    for (i = 0; i < RENO_BANDIT_ARMS; i++)
+        if (b->pulls[i] && (!b->pulls[best] || b->score[i] > b->score[best]))
+            best = i;
+    return best;
+}
+
+/* 다음 epoch 의 arm */
+static inline uint32_t reno_bandit_pick(const struct reno_bandit *b)
+{
+    uint32_t period = 4U << (b->epochs >= 128U ? 2U : b->epochs >> 6);
+    uint32_t i, best = b->arm;
+
+    if (b->epochs % period == period - 1U) {
+        /* 탐색: 가장 적게 써 본 arm */
+        for (i = 0; i < RENO_BANDIT_ARMS; i++)
+            if (b->pulls[i] < b->pulls[best])
+                best = i;
+        return best;
+    }
+    return reno_bandit_best(b);
+}
+
+/*
+ * ACK 마다 호출해도 되는 RTT 경계 처리. epoch 이 끝나 arm 이 정해지면 true
+ * snd_una/snd_nxt: 시퀀스, delivered/lost: 누적 패킷, srtt_us/min_rtt_us: 지연
+ */
+static inline bool reno_bandit_on_ack(struct reno_bandit *b, uint32_t snd_una, uint32_t snd_nxt,
+                                      uint32_t delivered, uint32_t lost, uint32_t now_us,
+                                      uint32_t srtt_us, uint32_t min_rtt_us)
+{
+    int64_t u;
+    uint32_t qd;
+
+    if ((int32_t)(snd_una - b->next_seq) < 0)
+        return false;
+    b->next_seq = snd_nxt;
+
+    if (min_rtt_us != RENO_MIN_RTT_UNSET && srtt_us > min_rtt_us)
+        b->qd_sum_us += srtt_us - min_rtt_us;
+    b->qd_n++;
+    if (++b->rounds < RENO_BANDIT_EPOCH_RTTS)
+        return false;
+
+    qd = b->qd_n ? b->qd_sum_us / b->qd_n : 0;
+    u = reno_bandit_utility(delivered - b->ep_delivered, lost - b->ep_lost,
+                            now_us - b->ep_start_us, qd, min_rtt_us);
+    if (b->pulls[b->arm])
+        b->score[b->arm] = reno_sat_s32(b->score[b->arm] + ((u - b->score[b->arm]) >> 2));
+    else
+        b->score[b->arm] = reno_sat_s32(u);
+    if (b->pulls[b->arm] < 0xffffU)
+        b->pulls[b->arm]++;
+    if (b->epochs < 0xffffU)
+        b->epochs++;
+
+    b->arm          = (uint8_t)reno_bandit_pick(b);
+    b->rounds       = 0;
+    b->ep_delivered = delivered;
+    b->ep_lost      = lost;
+    b->ep_start_us  = now_us;
+    b->qd_sum_us    = 0;
+    b->qd_n         = 0;
+    return true;
+}
+
+/*
+ * 지연 기울기(delay gradient) 혼잡 감지 (TIMELY / CDG 방식)
+ *  - 라운드(RTT)마다 그 라운드의 최소 RTT 샘플을 대표값으로 (µs 양자화, ACK 압축 잡음 제거)
+ *  - 기울기 = 이번 대표값 - 직전 대표값, EWMA 1/4 를 8배(1/8 µs 단위)로 보관
+ *  - 정규화 기울기(기울기 / min_rtt, /1024)가 thresh 를 넘으면 DOWN: cwnd * (1 - beta/1024)
+ *    단 BDP(reno_bwe) 아래로는 내리지 않음
+ *  - 기울기가 0 이하인 라운드가 RENO_GRAD_HAI_ROUNDS 번 이어지면 HAI (빠른 증가)
+ */
+#define RENO_GRAD_SHIFT         3U      /* grad 는 µs * 8 */
+#define RENO_GRAD_HAI_ROUNDS    5U
+#define RENO_GRAD_HAI_N         5U      /* HAI: RTT 당 5 패킷 증가 */
+
+enum reno_grad_signal {
+    RENO_GRAD_HOLD = 0,
+    RENO_GRAD_DOWN,
+    RENO_GRAD_HAI,
+};
+
+struct reno_grad {
+    uint32_t next_seq;      /* 현재 라운드가 끝나는 snd_nxt */
+    uint32_t round_min_us;  /* 이번 라운드 최소 RTT, 샘플이 없으면 0 */
+    uint32_t prev_rtt_us;   /* 직전 라운드 대표 RTT, 0 = 없음 */
+    int32_t grad;           /* 기울기 EWMA (µs << RENO_GRAD_SHIFT) */
+    uint16_t neg_rounds;    /* 기울기 <= 0 연속 라운드 */
+    uint16_t pad;
+};
+
+static inline void reno_grad_reset(struct reno_grad *g, uint32_t snd_nxt)
+{
+    g->next_seq     = snd_nxt;
+    g->round_min_us = 0;
+    g->prev_rtt_us  = 0;
+    g->grad         = 0;
+    g->neg_rounds   = 0;
+    g->pad          = 0;
+}
+
+static inline void reno_grad_sample(struct reno_grad *g, int32_t rtt_us)
+{
+    if (rtt_us <= 0)
+        return;
+    if (!g->round_min_us || (uint32_t)rtt_us < g->round_min_us)
+        g->round_min_us = (uint32_t)rtt_us;
+}
+
+/* snd_una 가 라운드 끝을 지나면 기울기를 갱신하고 신호를 돌려줌 (그 외에는 HOLD) */
+static inline enum reno_grad_signal reno_grad_round(struct reno_grad *g, uint32_t snd_una,
+                                                    uint32_t snd_nxt, uint32_t min_rtt_us,
+                                                    uint32_t thresh)
+{
+    int64_t diff;
+    uint64_t norm;
+    uint32_t rtt = g->round_min_us;
+
+    if ((int32_t)(snd_una - g->next_seq) < 0)
+        return RENO_GRAD_HOLD;
+    g->next_seq = snd_nxt;
+    g->round_min_us = 0;
+    if (!rtt)
+        return RENO_GRAD_HOLD;
+    if (!g->prev_rtt_us) {
+        g->prev_rtt_us = rtt;
+        return RENO_GRAD_HOLD;
+    }
+
+    diff = ((int64_t)rtt - g->prev_rtt_us) * (1 << RENO_GRAD_SHIFT) - g->grad;
+    g->prev_rtt_us = rtt;
+    g->grad = reno_sat_s32(g->grad + (int64_t)(reno_sat_s32(diff) / 4));
+
+    if (g->grad <= 0) {
+        if (g->neg_rounds < 0xffffU)
+            g->neg_rounds++;
+        return g->neg_rounds >= RENO_GRAD_HAI_ROUNDS ? RENO_GRAD_HAI : RENO_GRAD_HOLD;
+    }
+    g->neg_rounds = 0;
+    if (!min_rtt_us || min_rtt_us == RENO_MIN_RTT_UNSET)
+        return RENO_GRAD_HOLD;
+
+    /* grad / min_rtt (/1024), grad 는 8배이므로 >> 3 */
+    norm = RENO_DIV_U64((uint64_t)g->grad * 1024U, min_rtt_us) >> RENO_GRAD_SHIFT;
+    return norm > thresh ? RENO_GRAD_DOWN : RENO_GRAD_HOLD;
+}
+
+/* DOWN 시 새 cwnd: cwnd * (1 - beta/1024), BDP 와 2 를 하한으로 (cwnd 보다 크게는 안 함) */
+static inline uint32_t reno_grad_target(const struct reno_bwe *ca, uint32_t cwnd, uint32_t beta)
+{
+    uint32_t target = cwnd - (uint32_t)(((uint64_t)cwnd * beta) >> 10);
+    uint64_t bdp = reno_bwe_bdp(ca);
+
+    if (bdp > target)
+        target = bdp < cwnd ? (uint32_t)bdp : cwnd;
+    return target > 2U ? target : 2U;
+}
+
+#endif /* RENO_CUSTOM_CORE_H */
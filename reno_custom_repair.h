@@ -0,0 +1,93 @@
+#ifndef RENO_CUSTOM_REPAIR_H
+#define RENO_CUSTOM_REPAIR_H
+
+/*
+ * reno_custom 상태 blob 과 /proc/net/reno_custom_repair ioctl 정의
+ * (커널 모듈 reno_custom.c 와 reno_repair 도구만 사용, libreno_cc 는 포함하지 않음)
+ */
+
+#include <linux/ioctl.h>
+
+#include "reno_custom_core.h"
+
+/*
+ * TCP_REPAIR 체크포인트/복원 (CRIU 등 라이브 마이그레이션)
+ * 복원된 소켓은 icsk_ca_priv 가 0 으로 다시 초기화되어 추정을 처음부터 다시 하므로
+ * repair 모드인 동안 추정기 상태와 cwnd/ssthresh 를 blob 으로 꺼내고 다시 넣는다.
+ * - 커널: /proc/net/reno_custom_repair 에 ioctl, 요청에 호출자 프로세스의 소켓 fd 를 넣음
+ * - blob 은 magic/version/len 과 FNV-1a 체크섬으로 검증, 값 범위도 확인
+ * - BWE 는 패킷/초 단위이므로 복원 측 MSS 가 다르면 바이트 기준으로 환산
+ * 버전 1 형식을 바꾸면 RENO_STATE_VERSION 을 올리고 이전 버전은 거부
+ */
+#define RENO_STATE_MAGIC    0x52435354U     /* "RCST" */
+#define RENO_STATE_VERSION  1U
+#define RENO_STATE_CC_LEN   16              /* TCP_CA_NAME_MAX */
+#define RENO_STATE_MAX_RTT  60000000U       /* 60초 넘는 min RTT 는 손상으로 봄 */
+
+struct reno_ca_state {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t len;                   /* sizeof(struct reno_ca_state) */
+    char cc[RENO_STATE_CC_LEN];     /* 저장한 혼잡 제어 이름 (NUL 종료) */
+    struct reno_bwe bwe;
+    uint32_t snd_cwnd;
+    uint32_t snd_ssthresh;
+    uint32_t mss;                   /* bwe 의 패킷 기준 MSS */
+    uint32_t check;                 /* 앞 필드 전체의 FNV-1a */
+};
+
+struct reno_repair_req {
+    int32_t fd;                     /* 호출자 프로세스의 TCP 소켓 (repair 모드) */
+    uint32_t flags;                 /* 예약, 0 */
+    struct reno_ca_state state;
+};
+
+#define RENO_IOC_DUMP       _IOWR('R', 1, struct reno_repair_req)
+#define RENO_IOC_RESTORE    _IOW('R', 2, struct reno_repair_req)
+
+static inline uint32_t reno_state_csum(const struct reno_ca_state *st)
+{
+    const uint8_t *p = (const uint8_t *)st;
+    const uint8_t *end = (const uint8_t *)&st->check;
+    uint32_t h = 2166136261U;
+
+    while (p < end)
+        h = (h ^ *p++) * 16777619U;
+    return h;
+}
+
+/* 헤더와 체크섬 채우기 (나머지 필드는 호출자가 채운 뒤) */
+static inline void reno_state_seal(struct reno_ca_state *st)
+{
+    st->magic   = RENO_STATE_MAGIC;
+    st->version = RENO_STATE_VERSION;
+    st->len     = sizeof(*st);
+    st->check   = reno_state_csum(st);
+}
+
+static inline bool reno_state_valid(const struct reno_ca_state *st)
+{
+    const struct reno_bwe *b = &st->bwe;
+
+    if (st->magic != RENO_STATE_MAGIC || st->version != RENO_STATE_VERSION ||
+        st->len != sizeof(*st) || st->check != reno_state_csum(st))
+        return false;
+    if (st->cc[0] == '\0' || st->cc[RENO_STATE_CC_LEN - 1] != '\0')
+        return false;
+    if (b->weight < 1 || b->weight > RENO_MAX_WEIGHT || st->mss == 0 || st->mss > 0xffffU)
+        return false;
+    if (b->min_rtt_us == 0 ||
+        (b->min_rtt_us != RENO_MIN_RTT_UNSET && b->min_rtt_us > RENO_STATE_MAX_RTT))
+        return false;
+    return st->snd_cwnd >= 2U && st->snd_ssthresh >= 2U;
+}
+
+/* from_mss 기준 패킷/초를 to_mss 기준으로 (바이트/초 유지) */
+static inline uint32_t reno_state_scale_pps(uint32_t pps, uint32_t from_mss, uint32_t to_mss)
+{
+    if (!to_mss || from_mss == to_mss)
+        return pps;
+    return reno_sat_u32(RENO_DIV_U64((uint64_t)pps * from_mss, to_mss));
+}
+
+#endif /* RENO_CUSTOM_REPAIR_H */
@@ -0,0 +1,555 @@
+/*
+ * reno_exporter: reno_custom 상태를 Prometheus 텍스트 형식으로 내보내는 로컬 데몬
+ *
+ *   ./reno_exporter [-l 주소:포트] [-i 수집간격ms] [-M 최대소켓] [-c 혼잡제어이름]
+ *                   [-p /proc/net/reno_custom]
+ *   curl http://127.0.0.1:9464/metrics
+ *
+ * - 모듈 집계 카운터: /proc/net/reno_custom (per-cpu 합, 손실 분기별 횟수, cwnd 상한 적용 횟수)
+ * - 소켓 상태: NETLINK_SOCK_DIAG 덤프 (IPv4 + IPv6, 데이터 전송 상태만)
+ *   INET_DIAG_CONG 로 혼잡 제어 이름을 보고 reno_custom 소켓만,
+ *   get_info 가 보고하는 BBR 형식 정보(bw, min_rtt)와 tcp_info(cwnd, mss)를 사용
+ * - 분포: BWE, min RTT, cwnd/BDP 비율
+ *   마지막 수집 시점의 소켓 분포 스냅샷이라 수집마다 값이 오르내림. 그래서 counter 의미인
+ *   histogram 타입이 아니라 gauge 로 내보냄 (OpenMetrics gaugehistogram 의 이름 규칙:
+ *   <이름>_bucket{le=...}, <이름>_gcount, <이름>_gsum). rate() 없이 그대로 쿼리:
+ *   histogram_quantile(0.5, reno_custom_min_rtt_seconds_bucket)
+ *
+ * 10만 소켓에서도 비용이 일정하도록
+ * - 덤프 메시지를 받는 즉시 고정 크기 히스토그램에 누적 (소켓별 상태를 저장하지 않음)
+ * - 수집은 -i 간격으로 한 번만, 스크레이프는 마지막 결과 텍스트를 그대로 돌려줌
+ *   (스크레이프가 많아도 덤프 횟수는 늘지 않음)
+ * - 한 번의 수집에서 -M 개를 넘으면 덤프를 끊고 truncated 카운터 증가
+ * - 요청 상태를 ESTABLISHED/FIN_WAIT1/CLOSE_WAIT/LAST_ACK/CLOSING 으로 제한해
+ *   LISTEN/TIME_WAIT 소켓은 커널이 아예 보내지 않음
+ */
+
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <errno.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/tcp.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RX_DEFAULT_LISTEN   "127.0.0.1:9464"
+#define RX_PROC             "/proc/net/reno_custom"
+#define RX_RECV_BUF         (256 * 1024)
+#define RX_SOCK_RCVBUF      (4 << 20)
+#define RX_OUT_MAX          (64 * 1024)
+#define RX_MAX_COUNTERS     32
+
+/* TCP 상태 번호 (include/net/tcp_states.h) */
+#define RX_TCP_ESTABLISHED  1
+#define RX_TCP_FIN_WAIT1    4
+#define RX_TCP_CLOSE_WAIT   8
+#define RX_TCP_LAST_ACK     9
+#define RX_TCP_CLOSING      11
+#define RX_STATES ((1U << RX_TCP_ESTABLISHED) | (1U << RX_TCP_FIN_WAIT1) | \
+                   (1U << RX_TCP_CLOSE_WAIT) | (1U << RX_TCP_LAST_ACK) | \
+                   (1U << RX_TCP_CLOSING))
+
+/* ------------------------------------------------------------------ */
+/* 분포 스냅샷 (le 누적 버킷, 수집마다 새로 채움) */
+
+#define RX_MAX_BUCKETS      16
+
+struct rx_hist {
+    const char *name;
+    const char *help;
+    int n;
+    double le[RX_MAX_BUCKETS];
+    uint64_t count[RX_MAX_BUCKETS + 1];     /* 마지막 = +Inf */
+    double sum;
+};
+
+static void hist_reset(struct rx_hist *h)
+{
+    memset(h->count, 0, sizeof(h->count));
+    h->sum = 0;
+}
+
+static void hist_add(struct rx_hist *h, double v)
+{
+    int i;
+
+    for (i = 0; i < h->n && v > h->le[i]; i++)
+        ;
+    h->count[i]++;
+    h->sum += v;
+}
+
+static struct rx_hist h_bwe = {
+    .name = "reno_custom_bwe_bits_per_second",
+    .help = "Filtered bandwidth estimate (bwe_filt_pps * mss)",
+    .n = 12, .le = { 1e5, 1e6, 3e6, 1e7, 3e7, 1e8, 3e8, 1e9, 3e9, 1e10, 4e10, 1e11 },
+};
+static struct rx_hist h_rtt = {
+    .name = "reno_custom_min_rtt_seconds",
+    .help = "Minimum RTT tracked by the estimator",
+    .n = 13, .le = { 50e-6, 100e-6, 250e-6, 500e-6, 1e-3, 2.5e-3, 5e-3, 10e-3, 25e-3, 50e-3,
+                      100e-3, 250e-3, 1.0 },
+};
+static struct rx_hist h_ratio = {
+    .name = "reno_custom_cwnd_bdp_ratio",
+    .help = "cwnd divided by the estimated BDP (bwe * min_rtt)",
+    .n = 11, .le = { 0.25, 0.5, 0.75, 0.9, 1.0, 1.1, 1.25, 1.5, 2.0, 3.0, 4.0 },
+};
+
+/* ------------------------------------------------------------------ */
+/* 수집 상태 */
+
+struct rx_opts {
+    const char *listen;
+    const char *proc;
+    const char *cc;
+    int interval_ms;
+    uint64_t max_sockets;
+};
+
+struct rx_state {
+    uint64_t scanned;           /* 이번 수집에서 본 소켓 (모든 CC) */
+    uint64_t matched;           /* 그중 대상 CC */
+    uint64_t no_estimate;       /* 대상 CC 인데 BWE/min_rtt 가 아직 없음 */
+    uint64_t truncated_total;   /* -M 에 걸려 덤프를 끊은 횟수 (누적) */
+    uint64_t errors_total;
+    uint64_t collections_total;
+    double duration;
+    char counter_name[RX_MAX_COUNTERS][48];
+    uint64_t counter_val[RX_MAX_COUNTERS];
+    int ncounters;
+    char out[RX_OUT_MAX];
+    size_t out_len;
+};
+
+static volatile sig_atomic_t stop_flag;
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop_flag = 1;
+}
+
+static double mono_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* /proc/net/reno_custom: "이름 값" 줄, 모듈이 없으면 카운터 없음 */
+static void read_module_counters(struct rx_state *st, const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char name[48];
+    unsigned long long v;
+
+    st->ncounters = 0;
+    if (!f)
+        return;
+    while (st->ncounters < RX_MAX_COUNTERS && fscanf(f, "%47s %llu", name, &v) == 2) {
+        strcpy(st->counter_name[st->ncounters], name);
+        st->counter_val[st->ncounters++] = v;
+    }
+    fclose(f);
+}
+
+/* 덤프 메시지 하나 → 히스토그램 누적 (대상 CC 가 아니면 개수만 셈) */
+static void account_socket(struct rx_state *st, const char *cc, struct nlmsghdr *nlh)
+{
+    struct inet_diag_msg *m = NLMSG_DATA(nlh);
+    int len = (int)nlh->nlmsg_len - NLMSG_LENGTH(sizeof(*m));
+    struct rtattr *a = (struct rtattr *)(m + 1);
+    const struct tcp_info *ti = NULL;
+    const struct tcp_bbr_info *bbr = NULL;
+    const char *cong = NULL;
+    double bw_bps, rtt_s, bdp_pkts;
+
+    st->scanned++;
+    for (; RTA_OK(a, len); a = RTA_NEXT(a, len)) {
+        switch (a->rta_type) {
+        case INET_DIAG_CONG:
+            cong = RTA_DATA(a);
+            break;
+        case INET_DIAG_INFO:
+            /* 커널 버전에 따라 tcp_info 길이가 다름, cwnd/mss 는 앞쪽 필드 */
+            if (RTA_PAYLOAD(a) >= offsetof(struct tcp_info, tcpi_rcv_space))
+                ti = RTA_DATA(a);
+            break;
+        case INET_DIAG_BBRINFO:
+            if (RTA_PAYLOAD(a) >= sizeof(*bbr))
+                bbr = RTA_DATA(a);
+            break;
+        }
+    }
+    if (!cong || strcmp(cong, cc))
+        return;
+    st->matched++;
+
+    if (!bbr || !bbr->bbr_min_rtt || !(bbr->bbr_bw_lo | bbr->bbr_bw_hi)) {
+        st->no_estimate++;
+        return;
+    }
+    bw_bps = (double)(((uint64_t)bbr->bbr_bw_hi << 32) | bbr->bbr_bw_lo) * 8.0;
+    rtt_s = bbr->bbr_min_rtt / 1e6;
+    hist_add(&h_bwe, bw_bps);
+    hist_add(&h_rtt, rtt_s);
+
+    if (ti && ti->tcpi_snd_mss) {
+        bdp_pkts = bw_bps / 8.0 * rtt_s / ti->tcpi_snd_mss;
+        if (bdp_pkts > 0)
+            hist_add(&h_ratio, ti->tcpi_snd_cwnd / bdp_pkts);
+    }
+}
+
+/* 한 주소 패밀리 덤프. 0 = 끝까지 읽음, 1 = -M 로 중단, -1 = 오류 */
+static int dump_family(struct rx_state *st, const struct rx_opts *o, int family,
+                       unsigned char *buf)
+{
+    struct {
+        struct nlmsghdr nlh;
+        struct inet_diag_req_v2 r;
+    } req;
+    struct sockaddr_nl nl = { .nl_family = AF_NETLINK };
+    int fd, rcvbuf = RX_SOCK_RCVBUF, ret = -1;
+
+    fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (fd < 0)
+        return -1;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    memset(&req, 0, sizeof(req));
+    req.nlh.nlmsg_len   = sizeof(req);
+    req.nlh.nlmsg_type  = SOCK_DIAG_BY_FAMILY;
+    req.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.nlh.nlmsg_seq   = (uint32_t)st->collections_total;
+    req.r.sdiag_family   = (uint8_t)family;
+    req.r.sdiag_protocol = IPPROTO_TCP;
+    req.r.idiag_states   = RX_STATES;
+    /* BBRINFO 비트는 u8 밖이므로 커널 BBR/reno_custom 은 VEGASINFO 비트로도 응답 */
+    req.r.idiag_ext = (1 << (INET_DIAG_INFO - 1)) | (1 << (INET_DIAG_VEGASINFO - 1)) |
+                      (1 << (INET_DIAG_CONG - 1));
+
+    if (sendto(fd, &req, sizeof(req), 0, (struct sockaddr *)&nl, sizeof(nl)) < 0)
+        goto out;
+
+    for (;;) {
+        ssize_t n = recv(fd, buf, RX_RECV_BUF, 0);
+        struct nlmsghdr *h;
+        int left;
+
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            goto out;
+        }
+        left = (int)n;
+        for (h = (struct nlmsghdr *)buf; NLMSG_OK(h, left); h = NLMSG_NEXT(h, left)) {
+            if (h->nlmsg_type == NLMSG_DONE) {
+                ret = 0;
+                goto out;
+            }
+            if (h->nlmsg_type == NLMSG_ERROR)
+                goto out;
+            if (h->nlmsg_type != SOCK_DIAG_BY_FAMILY)
+                continue;
+            account_socket(st, o->cc, h);
+            if (o->max_sockets && st->scanned >= o->max_sockets) {
+                /* 소켓을 닫으면 커널이 남은 덤프를 버림 */
+                ret = 1;
+                goto out;
+            }
+        }
+    }
+out:
+    close(fd);
+    return ret;
+}
+
+/* ------------------------------------------------------------------ */
+/* 출력 */
+
+static void out_printf(struct rx_state *st, const char *fmt, ...)
+    __attribute__((format(printf, 2, 3)));
+
+static void out_printf(struct rx_state *st, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    if (st->out_len >= sizeof(st->out))
+        return;
+    va_start(ap, fmt);
+    n = vsnprintf(st->out + st->out_len, sizeof(st->out) - st->out_len, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+        st->out_len += (size_t)n;
+    if (st->out_len > sizeof(st->out))
+        st->out_len = sizeof(st->out);
+}
+
+static void render_hist(struct rx_state *st, const struct rx_hist *h)
+{
+    uint64_t cum = 0;
+    int i;
+
+    out_printf(st, "# HELP %s_bucket %s, sockets at or below le (last collection)\n"
+               "# TYPE %s_bucket gauge\n", h->name, h->help, h->name);
+    for (i = 0; i < h->n; i++) {
+        cum += h->count[i];
+        out_printf(st, "%s_bucket{le=\"%g\"} %llu\n", h->name, h->le[i],
+                   (unsigned long long)cum);
+    }
+    cum += h->count[h->n];
+    out_printf(st, "%s_bucket{le=\"+Inf\"} %llu\n", h->name, (unsigned long long)cum);
+    out_printf(st, "# TYPE %s_gsum gauge\n%s_gsum %g\n", h->name, h->name, h->sum);
+    out_printf(st, "# TYPE %s_gcount gauge\n%s_gcount %llu\n", h->name, h->name,
+               (unsigned long long)cum);
+}
+
+static void render(struct rx_state *st, const struct rx_opts *o)
+{
+    int i;
+
+    st->out_len = 0;
+
+    /* 모듈 카운터: loss_* 는 branch 라벨 하나로 묶음 */
+    out_printf(st, "# HELP reno_custom_loss_branch_total ssthresh decisions by branch "
+               "(a loss event may set several)\n# TYPE reno_custom_loss_branch_total counter\n");
+    for (i = 0; i < st->ncounters; i++)
+        if (!strncmp(st->counter_name[i], "loss_", 5) && strcmp(st->counter_name[i], "loss_events"))
+            out_printf(st, "reno_custom_loss_branch_total{branch=\"%s\"} %llu\n",
+                       st->counter_name[i] + 5, (unsigned long long)st->counter_val[i]);
+    for (i = 0; i < st->ncounters; i++) {
+        const char *n = st->counter_name[i];
+
+        if (!strncmp(n, "loss_", 5) && strcmp(n, "loss_events"))
+            continue;
+        out_printf(st, "# TYPE reno_custom_%s_total counter\nreno_custom_%s_total %llu\n",
+                   n, n, (unsigned long long)st->counter_val[i]);
+    }
+    out_printf(st, "# TYPE reno_custom_module_loaded gauge\nreno_custom_module_loaded %d\n",
+               st->ncounters > 0);
+
+    render_hist(st, &h_bwe);
+    render_hist(st, &h_rtt);
+    render_hist(st, &h_ratio);
+
+    out_printf(st, "# HELP reno_custom_sockets Sockets using the congestion control\n"
+               "# TYPE reno_custom_sockets gauge\nreno_custom_sockets{cc=\"%s\"} %llu\n",
+               o->cc, (unsigned long long)st->matched);
+    out_printf(st, "# TYPE reno_custom_sockets_without_estimate gauge\n"
+               "reno_custom_sockets_without_estimate %llu\n",
+               (unsigned long long)st->no_estimate);
+    out_printf(st, "# TYPE reno_exporter_sockets_scanned gauge\n"
+               "reno_exporter_sockets_scanned %llu\n", (unsigned long long)st->scanned);
+    out_printf(st, "# TYPE reno_exporter_collection_seconds gauge\n"
+               "reno_exporter_collection_seconds %.6f\n", st->duration);
+    out_printf(st, "# TYPE reno_exporter_collections_total counter\n"
+               "reno_exporter_collections_total %llu\n",
+               (unsigned long long)st->collections_total);
+    out_printf(st, "# TYPE reno_exporter_truncated_total counter\n"
+               "reno_exporter_truncated_total %llu\n", (unsigned long long)st->truncated_total);
+    out_printf(st, "# TYPE reno_exporter_errors_total counter\n"
+               "reno_exporter_errors_total %llu\n", (unsigned long long)st->errors_total);
+}
+
+static void collect(struct rx_state *st, const struct rx_opts *o, unsigned char *buf)
+{
+    static const int families[] = { AF_INET, AF_INET6 };
+    double t0 = mono_sec();
+    size_t i;
+
+    hist_reset(&h_bwe);
+    hist_reset(&h_rtt);
+    hist_reset(&h_ratio);
+    st->scanned = st->matched = st->no_estimate = 0;
+
+    read_module_counters(st, o->proc);
+    for (i = 0; i < sizeof(families) / sizeof(families[0]); i++) {
+        int r = dump_family(st, o, families[i], buf);
+
+        if (r < 0) {
+            st->errors_total++;
+        } else if (r > 0) {
+            st->truncated_total++;
+            break;
+        }
+    }
+    st->collections_total++;
+    st->duration = mono_sec() - t0;
+    render(st, o);
+}
+
+/* ------------------------------------------------------------------ */
+/* HTTP (요청 하나씩 처리, 응답은 미리 만든 텍스트) */
+
+static int listen_on(const char *spec)
+{
+    char host[64];
+    const char *colon = strrchr(spec, ':');
+    struct sockaddr_in sa = { .sin_family = AF_INET };
+    int fd, one = 1;
+
+    if (!colon || (size_t)(colon - spec) >= sizeof(host))
+        return -1;
+    memcpy(host, spec, (size_t)(colon - spec));
+    host[colon - spec] = '\0';
+    sa.sin_port = htons((uint16_t)atoi(colon + 1));
+    if (inet_pton(AF_INET, host, &sa.sin_addr) != 1)
+        return -1;
+
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0 || listen(fd, 16) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void write_all(int fd, const char *p, size_t n)
+{
+    while (n > 0) {
+        ssize_t w = write(fd, p, n);
+
+        if (w < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        p += w;
+        n -= (size_t)w;
+    }
+}
+
+static void serve_one(int lfd, const struct rx_state *st)
+{
+    struct timeval tv = { .tv_sec = 1 };
+    char req[1024], hdr[256];
+    ssize_t n;
+    int fd, hn;
+
+    fd = accept4(lfd, NULL, NULL, SOCK_CLOEXEC);
+    if (fd < 0)
+        return;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    n = read(fd, req, sizeof(req) - 1);
+    if (n <= 0)
+        goto out;
+    req[n] = '\0';
+
+    if (!strncmp(req, "GET /metrics", 12)) {
+        hn = snprintf(hdr, sizeof(hdr),
+                      "HTTP/1.0 200 OK\r\n"
+                      "Content-Type: text/plain; version=0.0.4\r\n"
+                      "Content-Length: %zu\r\nConnection: close\r\n\r\n", st->out_len);
+        write_all(fd, hdr, (size_t)hn);
+        write_all(fd, st->out, st->out_len);
+    } else {
+        static const char nf[] = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+
+        write_all(fd, nf, sizeof(nf) - 1);
+    }
+out:
+    close(fd);
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: reno_exporter [-l addr:port] [-i interval_ms] [-M max_sockets]\n"
+            "                     [-c cc_name] [-p proc_file]\n"
+            "  defaults: -l %s -i 5000 -M 200000 -c reno_custom -p %s\n",
+            RX_DEFAULT_LISTEN, RX_PROC);
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    struct rx_opts o = {
+        .listen = RX_DEFAULT_LISTEN, .proc = RX_PROC, .cc = "reno_custom",
+        .interval_ms = 5000, .max_sockets = 200000,
+    };
+    static struct rx_state st;
+    unsigned char *buf;
+    double next;
+    int i, lfd;
+
+    for (i = 1; i < argc; i++) {
+        if (i + 1 >= argc)
+            usage();
+        if (!strcmp(argv[i], "-l"))
+            o.listen = argv[++i];
+        else if (!strcmp(argv[i], "-i"))
+            o.interval_ms = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-M"))
+            o.max_sockets = strtoull(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-c"))
+            o.cc = argv[++i];
+        else if (!strcmp(argv[i], "-p"))
+            o.proc = argv[++i];
+        else
+            usage();
+    }
+    if (o.interval_ms < 100)
+        o.interval_ms = 100;
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    lfd = listen_on(o.listen);
+    if (lfd < 0) {
+        fprintf(stderr, "reno_exporter: cannot listen on %s: %s\n", o.listen, strerror(errno));
+        return 1;
+    }
+    buf = malloc(RX_RECV_BUF);
+    if (!buf)
+        return 1;
+
+    collect(&st, &o, buf);
+    fprintf(stderr, "reno_exporter: http://%s/metrics (%llu sockets, %.1f ms)\n",
+            o.listen, (unsigned long long)st.scanned, st.duration * 1e3);
+    next = mono_sec() + o.interval_ms / 1e3;
+
+    while (!stop_flag) {
+        struct pollfd pfd = { .fd = lfd, .events = POLLIN };
+        double wait = next - mono_sec();
+        int r;
+
+        if (wait <= 0) {
+            collect(&st, &o, buf);
+            next += o.interval_ms / 1e3;
+            if (next < mono_sec())
+                next = mono_sec() + o.interval_ms / 1e3;
+            continue;
+        }
+        r = poll(&pfd, 1, (int)(wait * 1e3) + 1);
+        if (r > 0 && (pfd.revents & POLLIN))
+            serve_one(lfd, &st);
+    }
+
+    free(buf);
+    close(lfd);
+    return 0;
+}
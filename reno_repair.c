@@ -0,0 +1,163 @@
+/*
+ * reno_repair: TCP_REPAIR 체크포인트/복원 때 reno_custom 상태를 꺼내고 다시 넣는 도구
+ *
+ *   ./reno_repair dump <pid> <fd> [blob]       repair 모드 소켓 상태 → blob (기본 stdout)
+ *   ./reno_repair restore <pid> <fd> [blob]    blob (기본 stdin) → repair 모드 소켓
+ *   ./reno_repair show [blob]                  blob 검증 후 내용 출력
+ *
+ * - 대상 소켓은 다른 프로세스(CRIU 가 복원 중인 태스크)의 fd 이므로 pidfd_getfd 로 복제해
+ *   /proc/net/reno_custom_repair 에 RENO_IOC_DUMP / RENO_IOC_RESTORE ioctl
+ *   (pid 0 이면 이 프로세스의 fd 를 그대로 사용)
+ * - 소켓이 repair 모드가 아니면 EPERM, 혼잡 제어가 blob 과 다르면 EINVAL
+ *   → 복원 쪽은 TCP_CONGESTION 을 먼저 같은 이름으로 맞춘 뒤 TCP_REPAIR 를 끄기 전에 호출
+ * - CAP_NET_ADMIN + 대상 프로세스 ptrace 권한 필요 (CRIU 액션 스크립트는 둘 다 있음)
+ * - /proc/net/reno_custom_repair 는 netns 마다 있으므로 대상 소켓과 같은 netns 안에서 실행 가능
+ * - blob 형식/검증은 reno_custom_repair.h (struct reno_ca_state)
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "reno_custom_repair.h"
+
+#define RR_PROC "/proc/net/reno_custom_repair"
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+#ifndef SYS_pidfd_getfd
+#define SYS_pidfd_getfd 438
+#endif
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: reno_repair dump <pid> <fd> [blob]\n"
+            "       reno_repair restore <pid> <fd> [blob]\n"
+            "       reno_repair show [blob]\n");
+    exit(2);
+}
+
+/* 대상 프로세스의 fd 를 이 프로세스로 복제 */
+static int grab_fd(int pid, int fd)
+{
+    int pidfd, ret;
+
+    if (pid == 0)
+        return fd;
+    pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+    if (pidfd < 0)
+        return -1;
+    ret = (int)syscall(SYS_pidfd_getfd, pidfd, fd, 0);
+    close(pidfd);
+    return ret;
+}
+
+static FILE *open_blob(const char *path, const char *mode, FILE *dflt)
+{
+    return path && strcmp(path, "-") ? fopen(path, mode) : dflt;
+}
+
+static int read_blob(const char *path, struct reno_ca_state *st)
+{
+    FILE *f = open_blob(path, "rb", stdin);
+    size_t n;
+
+    if (!f)
+        return -1;
+    n = fread(st, 1, sizeof(*st), f);
+    if (f != stdin)
+        fclose(f);
+    if (n != sizeof(*st) || !reno_state_valid(st)) {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+static void show(const struct reno_ca_state *st)
+{
+    const struct reno_bwe *b = &st->bwe;
+
+    printf("cc %s\n", st->cc);
+    printf("version %u\n", st->version);
+    printf("min_rtt_us %u\n", b->min_rtt_us == RENO_MIN_RTT_UNSET ? 0 : b->min_rtt_us);
+    printf("bwe_filt_pps %u\n", b->bwe_filt_pps);
+    printf("loss_bwe_pps %u\n", b->loss_bwe_pps);
+    printf("weight %u\n", b->weight);
+    printf("bdp_pkts %llu\n", (unsigned long long)reno_bwe_bdp(b));
+    printf("snd_cwnd %u\n", st->snd_cwnd);
+    printf("snd_ssthresh %u\n", st->snd_ssthresh);
+    printf("mss %u\n", st->mss);
+}
+
+int main(int argc, char **argv)
+{
+    struct reno_repair_req req;
+    unsigned long cmd;
+    int dump, pfd, sfd, ret;
+    FILE *f;
+
+    if (argc < 2)
+        usage();
+
+    memset(&req, 0, sizeof(req));
+    if (!strcmp(argv[1], "show")) {
+        if (read_blob(argc > 2 ? argv[2] : NULL, &req.state) < 0) {
+            fprintf(stderr, "reno_repair: invalid blob: %s\n", strerror(errno));
+            return 1;
+        }
+        show(&req.state);
+        return 0;
+    }
+
+    if (argc < 4)
+        usage();
+    dump = !strcmp(argv[1], "dump");
+    if (!dump && strcmp(argv[1], "restore"))
+        usage();
+    cmd = dump ? RENO_IOC_DUMP : RENO_IOC_RESTORE;
+
+    if (!dump && read_blob(argc > 4 ? argv[4] : NULL, &req.state) < 0) {
+        fprintf(stderr, "reno_repair: invalid blob: %s\n", strerror(errno));
+        return 1;
+    }
+
+    sfd = grab_fd(atoi(argv[2]), atoi(argv[3]));
+    if (sfd < 0) {
+        fprintf(stderr, "reno_repair: cannot get fd %s of pid %s: %s\n",
+                argv[3], argv[2], strerror(errno));
+        return 1;
+    }
+    pfd = open(RR_PROC, O_RDONLY);
+    if (pfd < 0) {
+        fprintf(stderr, "reno_repair: %s: %s (reno_custom loaded?)\n", RR_PROC, strerror(errno));
+        return 1;
+    }
+    req.fd = sfd;
+    ret = ioctl(pfd, cmd, &req);
+    close(pfd);
+    if (ret < 0) {
+        fprintf(stderr, "reno_repair: %s: %s%s\n", argv[1], strerror(errno),
+                errno == EPERM ? " (socket not in TCP_REPAIR mode?)" : "");
+        return 1;
+    }
+    if (!dump)
+        return 0;
+
+    f = open_blob(argc > 4 ? argv[4] : NULL, "wb", stdout);
+    if (!f || fwrite(&req.state, sizeof(req.state), 1, f) != 1) {
+        fprintf(stderr, "reno_repair: cannot write blob: %s\n", strerror(errno));
+        return 1;
+    }
+    if (f != stdout)
+        fclose(f);
+    return 0;
+}
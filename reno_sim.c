@@ -0,0 +1,436 @@
+/*
+ * reno_sim: 단일 병목 패킷 수준 시뮬레이터 (libreno_cc, 커널/네임스페이스 없이 수 초 안에)
+ *
+ *   ./reno_sim [-c custom|reno] [-b Mbit/s] [-r RTTms] [-R RTT분산] [-j 지터ms]
+ *              [-l 손실%] [-B 평균버스트] [-q 버퍼(BDP배수)] [-n 흐름수] [-s 시작간격초]
+ *              [-x 교차비율] [-X ON/OFF평균ms] [-a ACK당패킷] [-t 초] [-S seed]
+ *              [-k cap_gain] [-F]
+ *
+ * - 병목 큐(drop-tail) 하나를 1500바이트 전송 시간 단위로 진행, 전달된 패킷의 ACK 는
+ *   흐름별 기본 RTT + 지터(0..j 균등, 흐름 안에서는 순서 유지) 뒤에 도착
+ *   (순방향 전파 지연은 ACK 쪽에 합쳐서 RTT 만 맞춤)
+ * - 수신측은 a 패킷마다 ACK (기본 2, 지연 ACK), 40ms 안에 더 안 오면 남은 것만 ACK
+ *   pkts_acked 가 ACK 당 패킷 수라 ACK 방식 BWE 의 과소평가도 커널과 같은 정도로 재현
+ * - 흐름 i 의 기본 RTT = r * (1 + R * i/(n-1)), i 번째 흐름은 i*s 초에 시작
+ * - -t 는 마지막 흐름이 시작한 뒤의 시간: 전체 길이 t + s*(n-1), 모든 흐름이 함께 끝남
+ *   (exp_scenario.py 의 span 과 같은 시간 모델, 늦게 시작한 흐름도 항상 t 초 이상 활동)
+ * - 손실: 큐 넘침 + 병목 뒤 랜덤 손실 (B=1 Bernoulli, B>1 Gilbert-Elliott 평균 버스트 B)
+ * - 감지: 손실 패킷 뒤 패킷의 ACK 3개 → fast recovery (윈도우당 한 번 감소),
+ *   그 전에 max(200ms, 2*srtt) 가 지나면 RTO
+ * - 교차 트래픽: 피크 x*용량의 응답하지 않는 on-off UDP (ON/OFF 길이 지수 분포)
+ * - -c reno 는 reno_cc 의 classic 모드 (tcp_reno 와 같은 cwnd/2, 상한 없음)
+ * - 결과: JSON 한 줄 (흐름별 goodput, 이용률, Jain, 최소 몫, 큐 지연, 손실/RTO 횟수)
+ *   search_scenarios.py 가 시나리오 공간을 탐색할 때 사용
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "reno_cc.h"
+
+#define SIM_MSS             1448U
+#define SIM_PKT_BITS        (1500U * 8U)
+#define SIM_MAX_FLOWS       64U
+#define SIM_DUPTHRESH       3U
+#define SIM_MIN_RTO_NS      200000000ULL
+#define SIM_QD_BUCKET_NS    100000ULL       /* 큐 지연 히스토그램 0.1ms */
+#define SIM_QD_BUCKETS      20000U          /* 2초까지, 넘으면 마지막 칸 */
+#define SIM_CROSS_FLOW      0xffffU
+#define SIM_DELACK_NS       40000000ULL
+#define SIM_CAP_DEFAULT     0xffffffffU     /* -k 없음: reno_cc 기본 상한, -k 0: 상한 끔 */
+
+struct sim_pkt {
+    uint64_t t_send;
+    uint64_t t_enq;
+    uint32_t seq;
+    uint16_t flow;
+};
+
+struct sim_ack {
+    uint64_t t_arrive;
+    uint64_t t_send;            /* ACK 된 패킷 중 가장 오래된 것의 송신 시각 */
+    uint32_t seq;               /* ACK 된 패킷 중 가장 높은 seq */
+    uint32_t pkts;
+};
+
+/* 흐름별 ACK FIFO (도착 시각 단조 증가), 필요하면 두 배로 늘림 */
+struct sim_ackq {
+    struct sim_ack *a;
+    uint32_t cap, head, len;
+};
+
+struct sim_flow {
+    struct reno_cc cc;
+    struct sim_ackq acks;
+    uint64_t rtt_ns;
+    uint64_t start_ns;
+    uint64_t last_ack_ns;           /* ACK 순서 유지용 마지막 도착 시각 */
+    struct sim_ack pend;            /* 수신측에 모인 아직 안 보낸 ACK */
+    uint64_t pend_ns;               /* 첫 패킷 도착 시각 (지연 ACK 타이머) */
+    uint64_t lost_ns;               /* 처리 안 된 첫 손실 시각 */
+    uint32_t next_seq;
+    uint32_t inflight;
+    uint32_t lost_seq;              /* 처리 안 된 손실 중 가장 낮은 seq */
+    uint32_t lost_pending;
+    uint32_t dupacks;
+    uint32_t recover_seq;           /* 이 seq 전 손실은 같은 혼잡 이벤트 */
+    uint64_t delivered;
+    uint32_t loss_events;
+    uint32_t rtos;
+};
+
+struct sim_opts {
+    int classic;
+    double bw_mbps, rtt_ms, rtt_spread, jitter_ms, loss_pct, burst, buf_bdp;
+    double stagger_s, cross_frac, cross_ms, duration_s;
+    uint32_t flows, cap_gain, seed, ack_every;
+    int fast_conv;
+};
+
+static uint64_t rng_state;
+
+static uint64_t rnd64(void)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+static double rndu(void)
+{
+    return (double)(rnd64() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void ackq_push(struct sim_ackq *q, const struct sim_ack *a)
+{
+    if (q->len == q->cap) {
+        uint32_t ncap = q->cap ? q->cap * 2 : 1024;
+        struct sim_ack *n = malloc(sizeof(*n) * ncap);
+        uint32_t i;
+
+        if (!n) {
+            perror("reno_sim: malloc");
+            exit(1);
+        }
+        for (i = 0; i < q->len; i++)
+            n[i] = q->a[(q->head + i) % q->cap];
+        free(q->a);
+        q->a = n;
+        q->cap = ncap;
+        q->head = 0;
+    }
+    q->a[(q->head + q->len) % q->cap] = *a;
+    q->len++;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: reno_sim [-c custom|reno] [-b Mbit/s] [-r RTTms] [-R spread] [-j jitter_ms]\n"
+            "                [-l loss%%] [-B burst] [-q buffer_bdp] [-n flows] [-s stagger_s]\n"
+            "                [-x cross_frac] [-X onoff_ms] [-a pkts_per_ack] [-t secs] [-S seed]\n"
+            "                [-k cap_gain] [-F]\n");
+    exit(2);
+}
+
+static void parse_opts(int argc, char **argv, struct sim_opts *o)
+{
+    int c;
+
+    while ((c = getopt(argc, argv, "c:b:r:R:j:l:B:q:n:s:x:X:a:t:S:k:F")) != -1) {
+        switch (c) {
+        case 'c':
+            if (!strcmp(optarg, "reno"))
+                o->classic = 1;
+            else if (strcmp(optarg, "custom"))
+                usage();
+            break;
+        case 'b': o->bw_mbps = atof(optarg); break;
+        case 'r': o->rtt_ms = atof(optarg); break;
+        case 'R': o->rtt_spread = atof(optarg); break;
+        case 'j': o->jitter_ms = atof(optarg); break;
+        case 'l': o->loss_pct = atof(optarg); break;
+        case 'B': o->burst = atof(optarg); break;
+        case 'q': o->buf_bdp = atof(optarg); break;
+        case 'n': o->flows = (uint32_t)atoi(optarg); break;
+        case 's': o->stagger_s = atof(optarg); break;
+        case 'x': o->cross_frac = atof(optarg); break;
+        case 'X': o->cross_ms = atof(optarg); break;
+        case 'a': o->ack_every = (uint32_t)atoi(optarg); break;
+        case 't': o->duration_s = atof(optarg); break;
+        case 'S': o->seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'k': o->cap_gain = (uint32_t)atoi(optarg); break;
+        case 'F': o->fast_conv = 1; break;
+        default: usage();
+        }
+    }
+    if (o->bw_mbps <= 0 || o->rtt_ms <= 0 || o->duration_s <= 0 || o->stagger_s < 0 ||
+        o->flows < 1 || o->flows > SIM_MAX_FLOWS || o->burst < 1 || o->cross_frac >= 1 ||
+        o->ack_every < 1)
+        usage();
+}
+
+/* 손실 하나 기록 (큐 넘침 또는 링크 손실) */
+static void flow_lost(struct sim_flow *f, uint32_t seq, uint64_t now)
+{
+    if (!f->lost_pending || seq < f->lost_seq) {
+        f->lost_seq = seq;
+        f->dupacks = 0;
+    }
+    if (!f->lost_pending)
+        f->lost_ns = now;
+    f->lost_pending++;
+}
+
+/* 처리 안 된 손실을 정리: fast recovery 또는 RTO */
+static void flow_recover(struct sim_flow *f, int rto)
+{
+    if (f->lost_seq >= f->recover_seq || rto) {
+        if (rto) {
+            reno_cc_on_rto(&f->cc);
+            f->rtos++;
+        } else {
+            reno_cc_on_loss(&f->cc);
+        }
+        f->loss_events++;
+        f->recover_seq = f->next_seq;
+    }
+    f->inflight -= f->lost_pending < f->inflight ? f->lost_pending : f->inflight;
+    f->lost_pending = 0;
+    f->dupacks = 0;
+}
+
+/* 모인 ACK 를 보냄: 기본 RTT + 지터 뒤 도착, 흐름 안에서는 순서 유지 */
+static void flow_send_ack(struct sim_flow *f, uint64_t now, uint64_t jitter_ns)
+{
+    struct sim_ack a = f->pend;
+
+    a.t_arrive = now + f->rtt_ns + (jitter_ns ? rnd64() % jitter_ns : 0);
+    if (a.t_arrive < f->last_ack_ns)
+        a.t_arrive = f->last_ack_ns;
+    f->last_ack_ns = a.t_arrive;
+    ackq_push(&f->acks, &a);
+    f->pend.pkts = 0;
+}
+
+static void flow_on_ack(struct sim_flow *f, const struct sim_ack *a, uint64_t now)
+{
+    f->inflight -= a->pkts < f->inflight ? a->pkts : f->inflight;
+    f->delivered += a->pkts;
+    reno_cc_on_ack(&f->cc, a->pkts, (int32_t)((now - a->t_send) / 1000), true);
+
+    if (f->lost_pending && a->seq > f->lost_seq) {
+        f->dupacks += a->pkts;
+        if (f->dupacks >= SIM_DUPTHRESH)
+            flow_recover(f, 0);
+    }
+}
+
+static double pct_hist(const uint64_t *h, uint64_t n, double p)
+{
+    uint64_t want = (uint64_t)(p * (double)n), acc = 0;
+    uint32_t i;
+
+    for (i = 0; i < SIM_QD_BUCKETS; i++) {
+        acc += h[i];
+        if (acc > want)
+            return (double)(i * SIM_QD_BUCKET_NS) / 1e6;
+    }
+    return (double)(SIM_QD_BUCKETS * SIM_QD_BUCKET_NS) / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    struct sim_opts o = {
+        .bw_mbps = 100, .rtt_ms = 20, .burst = 1, .buf_bdp = 1, .cross_ms = 500,
+        .duration_s = 30, .flows = 4, .seed = 1, .ack_every = 2, .cap_gain = SIM_CAP_DEFAULT,
+    };
+    static struct sim_flow flows[SIM_MAX_FLOWS];
+    static uint64_t qd_hist[SIM_QD_BUCKETS];
+    struct reno_cc_config cfg = { .mss = SIM_MSS };
+    struct sim_pkt *q;
+    uint64_t slot_ns, end_ns, now, qd_sum = 0, qd_n = 0, drops = 0, cross_tx = 0;
+    uint64_t cross_next_ns, jitter_ns;
+    uint32_t qcap, qhead = 0, qlen = 0, i, rr = 0;
+    double cross_credit = 0, p_gb = 0, p_bg = 1, bdp_pkts, sum = 0, sum2 = 0, min_share = 1e9;
+    double mbps[SIM_MAX_FLOWS], secs, avail;
+    uint64_t delivered = 0;
+    uint32_t loss_events = 0, rtos = 0;
+    int ge_bad = 0, cross_on = 0;
+
+    parse_opts(argc, argv, &o);
+    rng_state = 0x9e3779b97f4a7c15ULL ^ ((uint64_t)o.seed << 1 | 1);
+
+    slot_ns = (uint64_t)(SIM_PKT_BITS * 1e3 / o.bw_mbps);
+    end_ns = (uint64_t)((o.duration_s + o.stagger_s * (o.flows - 1)) * 1e9);
+    jitter_ns = (uint64_t)(o.jitter_ms * 1e6);
+    bdp_pkts = o.bw_mbps * 1e6 / SIM_PKT_BITS * o.rtt_ms / 1e3;
+    qcap = (uint32_t)(bdp_pkts * o.buf_bdp);
+    if (qcap < 2)
+        qcap = 2;
+    q = calloc(qcap, sizeof(*q));
+    if (!q) {
+        perror("reno_sim: calloc");
+        return 1;
+    }
+
+    /* Gilbert-Elliott: 나쁜 상태 비율 = 손실률, 평균 버스트 = 1/p_bg */
+    if (o.loss_pct > 0) {
+        double p = o.loss_pct / 100.0;
+
+        p_bg = 1.0 / o.burst;
+        p_gb = o.burst > 1 ? p * p_bg / (1.0 - p) : p;
+    }
+
+    cfg.classic = o.classic;
+    cfg.cap_gain = o.cap_gain == SIM_CAP_DEFAULT ? 0 : o.cap_gain;
+    cfg.no_cap = o.cap_gain == 0;
+    cfg.fc_beta = o.fast_conv ? 870 : 0;
+    for (i = 0; i < o.flows; i++) {
+        struct sim_flow *f = &flows[i];
+
+        reno_cc_init(&f->cc, &cfg);
+        f->rtt_ns = (uint64_t)(o.rtt_ms * 1e6 *
+                               (1.0 + (o.flows > 1 ? o.rtt_spread * i / (o.flows - 1) : 0)));
+        f->start_ns = (uint64_t)(o.stagger_s * 1e9 * i);
+    }
+    cross_next_ns = o.cross_frac > 0 ? (uint64_t)(-log(1 - rndu()) * o.cross_ms * 1e6) : end_ns;
+
+    for (now = 0; now < end_ns; now += slot_ns) {
+        /* 1. 도착한 ACK 처리 + RTO 검사 */
+        for (i = 0; i < o.flows; i++) {
+            struct sim_flow *f = &flows[i];
+            struct sim_ackq *aq = &f->acks;
+            uint64_t rto;
+
+            while (aq->len && aq->a[aq->head].t_arrive <= now) {
+                struct sim_ack a = aq->a[aq->head];
+
+                aq->head = (aq->head + 1) % aq->cap;
+                aq->len--;
+                flow_on_ack(f, &a, now);
+            }
+            rto = (uint64_t)f->cc.srtt_us * 2000;
+            if (rto < SIM_MIN_RTO_NS)
+                rto = SIM_MIN_RTO_NS;
+            if (f->lost_pending && now - f->lost_ns > rto)
+                flow_recover(f, 1);
+            if (f->pend.pkts && now - f->pend_ns >= SIM_DELACK_NS)
+                flow_send_ack(f, now, jitter_ns);
+        }
+
+        /* 2. 병목 전송: 큐 앞 패킷 하나 */
+        if (qlen) {
+            struct sim_pkt p = q[qhead];
+            int lost = 0;
+
+            qhead = (qhead + 1) % qcap;
+            qlen--;
+            if (o.loss_pct > 0 && o.burst > 1) {
+                if (rndu() < (ge_bad ? p_bg : p_gb))
+                    ge_bad = !ge_bad;
+                lost = ge_bad;
+            } else if (o.loss_pct > 0) {
+                lost = rndu() < p_gb;
+            }
+            if (p.flow == SIM_CROSS_FLOW) {
+                cross_tx++;
+            } else if (lost) {
+                flow_lost(&flows[p.flow], p.seq, now);
+            } else {
+                struct sim_flow *f = &flows[p.flow];
+                uint64_t qd = now - p.t_enq;
+
+                if (!f->pend.pkts) {
+                    f->pend.t_send = p.t_send;
+                    f->pend_ns = now;
+                }
+                f->pend.seq = p.seq;
+                if (++f->pend.pkts >= o.ack_every)
+                    flow_send_ack(f, now, jitter_ns);
+
+                qd_sum += qd;
+                qd_n++;
+                qd_hist[qd / SIM_QD_BUCKET_NS < SIM_QD_BUCKETS ?
+                        qd / SIM_QD_BUCKET_NS : SIM_QD_BUCKETS - 1]++;
+            }
+        }
+
+        /* 3. 교차 트래픽 (on-off) */
+        while (now >= cross_next_ns) {
+            cross_on = !cross_on;
+            cross_next_ns += (uint64_t)(-log(1 - rndu()) * o.cross_ms * 1e6) + 1;
+        }
+        if (cross_on) {
+            for (cross_credit += o.cross_frac; cross_credit >= 1; cross_credit -= 1) {
+                if (qlen < qcap) {
+                    q[(qhead + qlen++) % qcap] = (struct sim_pkt){ .flow = SIM_CROSS_FLOW };
+                }
+            }
+        }
+
+        /* 4. 송신: cwnd 여유만큼 큐에 넣음 (흐름 순서는 돌아가며) */
+        for (i = 0; i < o.flows; i++) {
+            uint32_t fi = (rr + i) % o.flows;
+            struct sim_flow *f = &flows[fi];
+
+            if (now < f->start_ns)
+                continue;
+            while (f->inflight < reno_cc_cwnd(&f->cc)) {
+                uint32_t seq = f->next_seq++;
+
+                f->inflight++;
+                if (qlen == qcap) {
+                    drops++;
+                    flow_lost(f, seq, now);
+                    continue;
+                }
+                q[(qhead + qlen++) % qcap] = (struct sim_pkt){
+                    .t_send = now, .t_enq = now, .seq = seq, .flow = (uint16_t)fi };
+            }
+        }
+        rr++;
+    }
+
+    /* 결과: 흐름별 goodput 은 그 흐름이 활동한 시간 기준 */
+    secs = end_ns / 1e9;
+    for (i = 0; i < o.flows; i++) {
+        const struct sim_flow *f = &flows[i];
+        double active = (end_ns - f->start_ns) / 1e9;
+
+        mbps[i] = active > 0 ? f->delivered * (double)SIM_PKT_BITS / active / 1e6 : 0;
+        sum += mbps[i];
+        sum2 += mbps[i] * mbps[i];
+        delivered += f->delivered;
+        loss_events += f->loss_events;
+        rtos += f->rtos;
+    }
+    for (i = 0; i < o.flows; i++) {
+        double share = sum > 0 ? mbps[i] / (sum / o.flows) : 0;
+
+        if (share < min_share)
+            min_share = share;
+    }
+    avail = o.bw_mbps - cross_tx * (double)SIM_PKT_BITS / secs / 1e6;
+
+    printf("{\"cc\": \"%s\", \"goodput_mbps\": [", o.classic ? "reno" : "custom");
+    for (i = 0; i < o.flows; i++)
+        printf("%s%.3f", i ? ", " : "", mbps[i]);
+    printf("], \"total_mbps\": %.3f, \"utilization\": %.4f, \"jain\": %.4f, "
+           "\"min_share\": %.4f, \"qdelay_ms_avg\": %.3f, \"qdelay_ms_p95\": %.3f, "
+           "\"loss_events\": %u, \"rtos\": %u, \"drops\": %llu, \"buffer_pkts\": %u}\n",
+           delivered * (double)SIM_PKT_BITS / secs / 1e6,
+           avail > 0 ? delivered * (double)SIM_PKT_BITS / secs / 1e6 / avail : 0,
+           sum2 > 0 ? sum * sum / (o.flows * sum2) : 0, min_share,
+           qd_n ? qd_sum / (double)qd_n / 1e6 : 0, pct_hist(qd_hist, qd_n, 0.95),
+           loss_events, rtos, (unsigned long long)drops, qcap);
+
+    for (i = 0; i < o.flows; i++)
+        free(flows[i].acks.a);
+    free(q);
+    return 0;
+}
@@ -0,0 +1,979 @@
+/*
+ * rudp: reno_custom 혼잡 제어를 쓰는 신뢰성 UDP 대용량 전송 도구
+ *
+ *   수신: ./rudp recv <port> [-j out.json]
+ *   송신: ./rudp send <host> <port> [-t 초 | -n 바이트] [-s 세그먼트] [-b 배치]
+ *                     [-G] [-P] [-w 가중치] [-F] [-j out.json]
+ *
+ *   -G  GSO(UDP_SEGMENT) 끔     -P  페이싱 끔
+ *   -w  MulTCP 가중치 (weighted)  -F  fast convergence
+ *
+ * - 커널 모듈을 올리지 않고 reno_custom 알고리즘(libreno_cc)을 멀티 Gbit/s 로 시험
+ * - 송신: sendmmsg 배치 + UDP_SEGMENT(GSO), 수신: recvmmsg 배치
+ * - ACK: 누적 ACK + SACK 블록 + 송신 시각 echo (재전송 모호성 없는 RTT)
+ * - 손실 감지: SACK 된 최고 번호보다 RUDP_DUPTHRESH 이상 낮은 미확인 패킷,
+ *   SACK 구간 안의 오래된 패킷(시간 기반), RTO
+ * - JSON 결과는 iperf3 -J 와 같은 키를 사용 (end.sum_sent.bits_per_second 등)
+ */
+
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <endian.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "reno_cc.h"
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#define RUDP_MAGIC          0x52554450U     /* "RUDP" */
+#define RUDP_DATA           1
+#define RUDP_ACK            2
+#define RUDP_FIN            3
+
+#define RUDP_RING           (1U << 20)      /* 최대 in-flight 패킷 (ring 크기) */
+#define RUDP_MAX_SACK       16
+#define RUDP_DUPTHRESH      3
+#define RUDP_MAX_BATCH      64
+#define RUDP_GSO_SEGS       64              /* UDP_MAX_SEGMENTS */
+#define RUDP_UDP_MAX_PAYLOAD 65507          /* GSO 메시지 전체도 UDP 길이 한도 안 */
+#define RUDP_MIN_RTO_US     50000ULL
+#define RUDP_MAX_RTO_US     2000000ULL
+#define RUDP_MAX_RTOS       8               /* 진행 없이 연속 RTO 이만큼이면 포기 (약 10초 이상) */
+#define RUDP_SOCK_BUF       (32 << 20)
+#define RUDP_DEFAULT_SEG    1400
+#define RUDP_MAX_SEG        8948            /* 9000 MTU - IP/UDP */
+
+struct rudp_hdr {
+    uint32_t magic;
+    uint8_t  type;
+    uint8_t  nsack;
+    uint16_t len;           /* payload 길이 */
+    uint64_t seq;           /* DATA: 패킷 번호, ACK: 누적 ACK, FIN: 총 패킷 수 */
+    uint64_t ts_us;         /* DATA: 송신 시각, ACK: echo */
+} __attribute__((packed));
+
+struct rudp_sack {
+    uint64_t start;         /* [start, end) */
+    uint64_t end;
+} __attribute__((packed));
+
+#define RUDP_ACK_MAX (sizeof(struct rudp_hdr) + RUDP_MAX_SACK * sizeof(struct rudp_sack))
+
+enum { ST_FREE = 0, ST_INFLIGHT, ST_LOST, ST_SACKED };
+
+static volatile sig_atomic_t stop_flag;
+
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop_flag = 1;
+}
+
+static void put_hdr(void *buf, uint8_t type, uint8_t nsack, uint16_t len,
+                    uint64_t seq, uint64_t ts)
+{
+    struct rudp_hdr h = {
+        .magic = htobe32(RUDP_MAGIC), .type = type, .nsack = nsack,
+        .len = htobe16(len), .seq = htobe64(seq), .ts_us = htobe64(ts),
+    };
+
+    memcpy(buf, &h, sizeof(h));
+}
+
+static int get_hdr(const void *buf, size_t n, struct rudp_hdr *h)
+{
+    if (n < sizeof(*h))
+        return -1;
+    memcpy(h, buf, sizeof(*h));
+    if (be32toh(h->magic) != RUDP_MAGIC)
+        return -1;
+    h->len   = be16toh(h->len);
+    h->seq   = be64toh(h->seq);
+    h->ts_us = be64toh(h->ts_us);
+    return 0;
+}
+
+static void set_bufs(int fd)
+{
+    int sz = RUDP_SOCK_BUF;
+
+    /* root 면 rmem_max/wmem_max 를 무시하는 FORCE 사용 */
+    if (setsockopt(fd, SOL_SOCKET, SO_SNDBUFFORCE, &sz, sizeof(sz)) < 0)
+        setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sz, sizeof(sz));
+    if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &sz, sizeof(sz)) < 0)
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &sz, sizeof(sz));
+}
+
+/* ------------------------------------------------------------------ */
+/* 수신기                                                             */
+/* ------------------------------------------------------------------ */
+
+struct rudp_rx {
+    uint64_t rcv_nxt;               /* 누적 ACK */
+    uint64_t *map;                  /* rcv_nxt 이후 수신 비트맵 (ring) */
+    struct rudp_sack sack[RUDP_MAX_SACK];
+    int nsack;
+    uint64_t echo_ts;
+    uint64_t bytes, pkts, dups;
+};
+
+static int rx_test(const struct rudp_rx *rx, uint64_t s)
+{
+    uint64_t i = s & (RUDP_RING - 1);
+
+    return (rx->map[i >> 6] >> (i & 63)) & 1;
+}
+
+static void rx_flip(struct rudp_rx *rx, uint64_t s)
+{
+    uint64_t i = s & (RUDP_RING - 1);
+
+    rx->map[i >> 6] ^= 1ULL << (i & 63);
+}
+
+/* 가장 최근 변경된 블록을 맨 앞에 두는 TCP 방식 SACK 목록 */
+static void rx_sack_add(struct rudp_rx *rx, uint64_t s)
+{
+    struct rudp_sack cur = { s, s + 1 };
+    int i, j;
+
+    for (i = 0; i < rx->nsack; i++) {
+        struct rudp_sack *b = &rx->sack[i];
+
+        if (b->end == cur.start || b->start == cur.end) {
+            cur.start = b->start < cur.start ? b->start : cur.start;
+            cur.end   = b->end > cur.end ? b->end : cur.end;
+            memmove(&rx->sack[i], &rx->sack[i + 1], (rx->nsack - i - 1) * sizeof(*b));
+            rx->nsack--;
+            i = -1;     /* 합쳐진 블록이 다른 블록과도 붙을 수 있음 */
+        }
+    }
+
+    j = rx->nsack < RUDP_MAX_SACK ? rx->nsack : RUDP_MAX_SACK - 1;
+    memmove(&rx->sack[1], &rx->sack[0], j * sizeof(cur));
+    rx->sack[0] = cur;
+    rx->nsack = j + 1;
+}
+
+static void rx_sack_trim(struct rudp_rx *rx)
+{
+    int i, n = 0;
+
+    for (i = 0; i < rx->nsack; i++) {
+        struct rudp_sack b = rx->sack[i];
+
+        if (b.end <= rx->rcv_nxt)
+            continue;
+        if (b.start < rx->rcv_nxt)
+            b.start = rx->rcv_nxt;
+        rx->sack[n++] = b;
+    }
+    rx->nsack = n;
+}
+
+static void rx_data(struct rudp_rx *rx, const struct rudp_hdr *h)
+{
+    uint64_t s = h->seq;
+
+    rx->echo_ts = h->ts_us;
+
+    if (s < rx->rcv_nxt || s >= rx->rcv_nxt + RUDP_RING || rx_test(rx, s)) {
+        rx->dups++;
+        return;
+    }
+
+    rx_flip(rx, s);
+    rx->bytes += h->len;
+    rx->pkts++;
+
+    if (s == rx->rcv_nxt) {
+        while (rx_test(rx, rx->rcv_nxt)) {
+            rx_flip(rx, rx->rcv_nxt);
+            rx->rcv_nxt++;
+        }
+        rx_sack_trim(rx);
+    } else {
+        rx_sack_add(rx, s);
+    }
+}
+
+static void rx_send_ack(int fd, struct rudp_rx *rx, uint8_t type, uint64_t seq)
+{
+    unsigned char buf[RUDP_ACK_MAX];
+    size_t off = sizeof(struct rudp_hdr);
+    int i;
+
+    put_hdr(buf, type, (uint8_t)rx->nsack, 0, seq, rx->echo_ts);
+    for (i = 0; i < rx->nsack; i++) {
+        struct rudp_sack b = { htobe64(rx->sack[i].start), htobe64(rx->sack[i].end) };
+
+        memcpy(buf + off, &b, sizeof(b));
+        off += sizeof(b);
+    }
+    send(fd, buf, off, 0);
+}
+
+static int run_recv(int port, const char *json)
+{
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(port) };
+    static unsigned char bufs[RUDP_MAX_BATCH][RUDP_MAX_SEG + 64];
+    struct mmsghdr msgs[RUDP_MAX_BATCH];
+    struct iovec iov[RUDP_MAX_BATCH];
+    struct sockaddr_in peer;
+    socklen_t plen = sizeof(peer);
+    struct rudp_rx rx = { 0 };
+    uint64_t t_first = 0, t_last = 0;
+    int fd, i, n, connected = 0, done = 0;
+
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("rudp recv: bind");
+        return 1;
+    }
+    set_bufs(fd);
+
+    rx.map = calloc(RUDP_RING / 64, sizeof(uint64_t));
+    if (!rx.map)
+        return 1;
+
+    /* 첫 패킷의 송신자와 connect 해서 이후 ACK 는 send() 로 */
+    n = recvfrom(fd, bufs[0], sizeof(bufs[0]), MSG_PEEK, (struct sockaddr *)&peer, &plen);
+    if (n < 0 || connect(fd, (struct sockaddr *)&peer, plen) < 0) {
+        perror("rudp recv: connect");
+        return 1;
+    }
+    connected = 1;
+
+    for (i = 0; i < RUDP_MAX_BATCH; i++) {
+        iov[i].iov_base = bufs[i];
+        iov[i].iov_len  = sizeof(bufs[i]);
+        memset(&msgs[i], 0, sizeof(msgs[i]));
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    while (connected && !done && !stop_flag) {
+        struct rudp_hdr h;
+        int got_data = 0;
+
+        n = recvmmsg(fd, msgs, RUDP_MAX_BATCH, MSG_WAITFORONE, NULL);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("rudp recv: recvmmsg");
+            break;
+        }
+
+        for (i = 0; i < n; i++) {
+            if (get_hdr(bufs[i], msgs[i].msg_len, &h) < 0)
+                continue;
+            if (h.type == RUDP_DATA) {
+                if (!t_first)
+                    t_first = now_us();
+                rx_data(&rx, &h);
+                got_data = 1;
+            } else if (h.type == RUDP_FIN) {
+                /* 송신 종료 → FIN 응답 후 종료 */
+                rx_send_ack(fd, &rx, RUDP_FIN, rx.rcv_nxt);
+                done = 1;
+            }
+        }
+
+        /* 배치당 ACK 하나 (delayed ACK) */
+        if (got_data) {
+            t_last = now_us();
+            rx_send_ack(fd, &rx, RUDP_ACK, rx.rcv_nxt);
+        }
+    }
+
+    {
+        double secs = t_last > t_first ? (t_last - t_first) / 1e6 : 0;
+        double bps = secs > 0 ? rx.bytes * 8 / secs : 0;
+
+        printf("received %llu bytes (%llu pkts, %llu dups) in %.2f s: %.3f Gbit/s\n",
+               (unsigned long long)rx.bytes, (unsigned long long)rx.pkts,
+               (unsigned long long)rx.dups, secs, bps / 1e9);
+        if (json) {
+            FILE *f = fopen(json, "w");
+
+            if (f) {
+                fprintf(f, "{\"end\": {\"sum_received\": {\"seconds\": %.6f, \"bytes\": %llu, "
+                           "\"bits_per_second\": %.1f}, \"duplicates\": %llu}}\n",
+                        secs, (unsigned long long)rx.bytes, bps,
+                        (unsigned long long)rx.dups);
+                fclose(f);
+            }
+        }
+    }
+
+    free(rx.map);
+    close(fd);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* 송신기                                                             */
+/* ------------------------------------------------------------------ */
+
+struct rudp_tx {
+    struct reno_cc cc;
+    uint8_t  *state;        /* ring: ST_* */
+    uint64_t *sent_us;      /* ring: 마지막 송신 시각 */
+    uint64_t *sackmap;      /* ring: SACK 비트맵 (64개씩 건너뛰기용) */
+
+    uint64_t snd_una;       /* 누적 ACK */
+    uint64_t snd_nxt;       /* 다음 새 패킷 번호 */
+    uint64_t limit;         /* 보낼 총 패킷 수 (시간 모드면 UINT64_MAX) */
+    uint64_t high_sacked;   /* SACK 된 최고 번호 + 1 */
+    uint64_t loss_scan;     /* 손실 검사 위치 (단조 증가) */
+    uint64_t retx_scan;     /* 재전송 대상 검색 위치 */
+    uint64_t recovery_end;  /* 이 번호 이전 손실은 같은 혼잡 이벤트 */
+    uint64_t inflight;      /* ST_INFLIGHT 개수 */
+    uint64_t lost;          /* 재전송 대기 ST_LOST 개수 */
+
+    uint64_t srtt_us, rttvar_us, rto_us, last_progress_us;
+    uint64_t rtt_sum_us, rtt_samples;
+    uint64_t retransmits, loss_events, rto_events;
+    uint32_t rto_streak;    /* 새로 확인된 패킷 없이 이어진 RTO 수 */
+    uint64_t acked_pkts;
+    uint64_t next_stale_scan_us;
+
+    double   tokens;        /* 페이싱 토큰 (바이트) */
+    uint64_t last_refill_us;
+    int      cwnd_limited;
+
+    uint32_t seg;           /* payload 포함 세그먼트 크기 */
+    int      gso, pacing;
+    int      gso_segs;      /* 메시지 하나에 묶는 최대 세그먼트 수 */
+};
+
+static inline uint32_t ring_idx(uint64_t s)
+{
+    return (uint32_t)(s & (RUDP_RING - 1));
+}
+
+static void tx_set_state(struct rudp_tx *tx, uint64_t s, uint8_t st)
+{
+    uint32_t i = ring_idx(s);
+    uint8_t old = tx->state[i];
+
+    if (old == ST_INFLIGHT)
+        tx->inflight--;
+    else if (old == ST_LOST)
+        tx->lost--;
+
+    if (st == ST_INFLIGHT)
+        tx->inflight++;
+    else if (st == ST_LOST)
+        tx->lost++;
+
+    if (st == ST_SACKED)
+        tx->sackmap[i >> 6] |= 1ULL << (i & 63);
+    else if (old == ST_SACKED)
+        tx->sackmap[i >> 6] &= ~(1ULL << (i & 63));
+
+    tx->state[i] = st;
+}
+
+static void tx_rtt_sample(struct rudp_tx *tx, uint64_t rtt)
+{
+    /* RFC 6298 */
+    if (!tx->srtt_us) {
+        tx->srtt_us = rtt;
+        tx->rttvar_us = rtt / 2;
+    } else {
+        uint64_t err = rtt > tx->srtt_us ? rtt - tx->srtt_us : tx->srtt_us - rtt;
+
+        tx->rttvar_us = (3 * tx->rttvar_us + err) / 4;
+        tx->srtt_us = (7 * tx->srtt_us + rtt) / 8;
+    }
+    tx->rto_us = tx->srtt_us + 4 * tx->rttvar_us;
+    if (tx->rto_us < RUDP_MIN_RTO_US)
+        tx->rto_us = RUDP_MIN_RTO_US;
+    tx->rtt_sum_us += rtt;
+    tx->rtt_samples++;
+}
+
+static void tx_mark_lost(struct rudp_tx *tx, uint64_t s)
+{
+    tx_set_state(tx, s, ST_LOST);
+    if (s < tx->retx_scan)
+        tx->retx_scan = s;
+
+    /* 복구 구간 밖의 첫 손실만 혼잡 이벤트로 처리 */
+    if (s >= tx->recovery_end) {
+        reno_cc_on_loss(&tx->cc);
+        tx->recovery_end = tx->snd_nxt;
+        tx->loss_events++;
+    }
+}
+
+/* SACK 된 최고 번호보다 RUDP_DUPTHRESH 이상 낮은 in-flight 패킷은 손실 */
+static void tx_detect_loss(struct rudp_tx *tx, uint64_t now)
+{
+    uint64_t s;
+
+    if (tx->loss_scan < tx->snd_una)
+        tx->loss_scan = tx->snd_una;
+
+    for (s = tx->loss_scan; s + RUDP_DUPTHRESH < tx->high_sacked; s++) {
+        if (tx->state[ring_idx(s)] == ST_INFLIGHT)
+            tx_mark_lost(tx, s);
+    }
+    if (s > tx->loss_scan)
+        tx->loss_scan = s;
+
+    /*
+     * 시간 기반 (RACK 유사): SACK 된 구간 안에서 srtt * 5/4 이상 지난 in-flight
+     * 패킷은 손실. 창이 작아 RUDP_DUPTHRESH 를 못 채우는 경우와 재전송이 다시
+     * 손실된 경우를 RTO 없이 복구한다. srtt/4 마다 한 번만 훑음.
+     */
+    if (tx->srtt_us && now >= tx->next_stale_scan_us) {
+        uint64_t wait = tx->srtt_us + tx->srtt_us / 4;
+        uint64_t stale = now > wait ? now - wait : 0;
+
+        for (s = tx->snd_una; s < tx->high_sacked; s++) {
+            uint32_t i = ring_idx(s);
+
+            if (tx->state[i] == ST_INFLIGHT && tx->sent_us[i] < stale)
+                tx_mark_lost(tx, s);
+        }
+        tx->next_stale_scan_us = now + tx->srtt_us / 4;
+    }
+}
+
+static void tx_sack_range(struct rudp_tx *tx, uint64_t a, uint64_t b, uint32_t *newly)
+{
+    uint64_t s = a;
+
+    while (s < b) {
+        uint32_t i = ring_idx(s);
+        uint64_t word = tx->sackmap[i >> 6];
+        uint32_t bit = i & 63;
+
+        /* 64개 모두 이미 SACK 된 word 는 통째로 건너뜀 */
+        if (bit == 0 && word == ~0ULL && s + 64 <= b) {
+            s += 64;
+            continue;
+        }
+        if (!((word >> bit) & 1)) {
+            tx_set_state(tx, s, ST_SACKED);
+            (*newly)++;
+        }
+        s++;
+    }
+    if (b > tx->high_sacked)
+        tx->high_sacked = b;
+}
+
+static void tx_on_ack(struct rudp_tx *tx, const unsigned char *buf, size_t n,
+                      const struct rudp_hdr *h, uint64_t now)
+{
+    uint32_t newly = 0;
+    uint64_t cum = h->seq;
+    int i;
+
+    if (cum > tx->snd_nxt)
+        return;
+
+    /* 누적 ACK */
+    while (tx->snd_una < cum) {
+        if (tx->state[ring_idx(tx->snd_una)] != ST_SACKED)
+            newly++;
+        tx_set_state(tx, tx->snd_una, ST_FREE);
+        tx->snd_una++;
+    }
+    if (tx->high_sacked < tx->snd_una)
+        tx->high_sacked = tx->snd_una;
+    if (tx->retx_scan < tx->snd_una)
+        tx->retx_scan = tx->snd_una;
+
+    /* SACK 블록 */
+    for (i = 0; i < h->nsack; i++) {
+        struct rudp_sack b;
+        size_t off = sizeof(*h) + i * sizeof(b);
+
+        if (off + sizeof(b) > n)
+            break;
+        memcpy(&b, buf + off, sizeof(b));
+        b.start = be64toh(b.start);
+        b.end   = be64toh(b.end);
+        if (b.start < tx->snd_una)
+            b.start = tx->snd_una;
+        if (b.end > tx->snd_nxt)
+            b.end = tx->snd_nxt;
+        if (b.start < b.end)
+            tx_sack_range(tx, b.start, b.end, &newly);
+    }
+
+    if (newly) {
+        tx->acked_pkts += newly;
+        tx->last_progress_us = now;
+        tx->rto_streak = 0;
+        if (tx->rto_us > 2 * (tx->srtt_us + 4 * tx->rttvar_us) &&
+            tx->rto_us > RUDP_MIN_RTO_US)
+            tx->rto_us = tx->srtt_us + 4 * tx->rttvar_us;   /* backoff 해제 */
+    }
+
+    if (h->ts_us && h->ts_us <= now)
+        tx_rtt_sample(tx, now - h->ts_us);
+
+    reno_cc_on_ack(&tx->cc, newly, h->ts_us && h->ts_us <= now ?
+                   (int32_t)(now - h->ts_us) : -1, tx->cwnd_limited);
+
+    tx_detect_loss(tx, now);
+}
+
+static void tx_check_rto(struct rudp_tx *tx, uint64_t now)
+{
+    uint64_t s;
+
+    if (!tx->inflight || now - tx->last_progress_us < tx->rto_us)
+        return;
+
+    /* 타임아웃: 미확인 전부 손실 처리, cwnd = 1 */
+    reno_cc_on_rto(&tx->cc);
+    for (s = tx->snd_una; s < tx->snd_nxt; s++) {
+        if (tx->state[ring_idx(s)] == ST_INFLIGHT)
+            tx_set_state(tx, s, ST_LOST);
+    }
+    tx->retx_scan = tx->snd_una;
+    tx->recovery_end = tx->snd_nxt;
+    tx->rto_events++;
+    tx->rto_streak++;
+    tx->rto_us = tx->rto_us * 2 < RUDP_MAX_RTO_US ? tx->rto_us * 2 : RUDP_MAX_RTO_US;
+    tx->last_progress_us = now;
+}
+
+static uint64_t tx_next_retx(struct rudp_tx *tx)
+{
+    while (tx->lost && tx->retx_scan < tx->snd_nxt) {
+        if (tx->state[ring_idx(tx->retx_scan)] == ST_LOST)
+            return tx->retx_scan;
+        tx->retx_scan++;
+    }
+    return UINT64_MAX;
+}
+
+static void fill_data(struct rudp_tx *tx, unsigned char *p, uint64_t s, uint64_t now)
+{
+    put_hdr(p, RUDP_DATA, 0, (uint16_t)(tx->seg - sizeof(struct rudp_hdr)), s, now);
+    tx->sent_us[ring_idx(s)] = now;
+    tx_set_state(tx, s, ST_INFLIGHT);
+}
+
+/* cwnd/페이싱이 허용하는 만큼 배치로 송신, 보낸 패킷 수 반환 */
+static int tx_send(int fd, struct rudp_tx *tx, unsigned char *buf, int batch, int sending_new)
+{
+    struct mmsghdr msgs[RUDP_MAX_BATCH];
+    struct iovec iov[RUDP_MAX_BATCH];
+    uint64_t now = now_us();
+    uint64_t cwnd = reno_cc_cwnd(&tx->cc);
+    uint64_t first[RUDP_MAX_BATCH];
+    int segs_of[RUDP_MAX_BATCH], retx_of[RUDP_MAX_BATCH];
+    size_t used = 0;
+    int nmsg = 0, npkt = 0, r, i;
+
+    if (cwnd > RUDP_RING - 1)
+        cwnd = RUDP_RING - 1;
+
+    if (tx->pacing) {
+        /* inflight 는 링 크기 (RUDP_RING) 이하 */
+        uint64_t rate = reno_cc_pacing_rate(&tx->cc, (uint32_t)tx->inflight);
+        double burst = (double)tx->seg * tx->gso_segs;
+
+        if (!rate) {
+            tx->tokens = burst;
+        } else {
+            tx->tokens += (double)rate * (now - tx->last_refill_us) / 1e6;
+            if (tx->tokens > burst)
+                tx->tokens = burst;
+        }
+        tx->last_refill_us = now;
+    }
+
+    tx->cwnd_limited = 0;
+    while (nmsg < batch) {
+        uint64_t s = tx_next_retx(tx);
+        int segs = 0;
+
+        if (tx->inflight >= cwnd) {
+            tx->cwnd_limited = 1;
+            break;
+        }
+        if (tx->pacing && tx->tokens < tx->seg)
+            break;
+
+        iov[nmsg].iov_base = buf + used;
+        retx_of[nmsg] = s != UINT64_MAX;
+
+        if (s != UINT64_MAX) {
+            /* 재전송은 한 패킷씩 */
+            fill_data(tx, buf + used, s, now);
+            tx->retx_scan = s + 1;
+            tx->retransmits++;
+            segs = 1;
+        } else if (sending_new && tx->snd_nxt < tx->limit &&
+                   tx->snd_nxt - tx->snd_una < RUDP_RING - 1) {
+            /* 새 데이터: GSO 로 연속 패킷을 한 메시지에 */
+            int max = tx->gso_segs;
+
+            s = tx->snd_nxt;
+            while (segs < max && tx->inflight < cwnd &&
+                   tx->snd_nxt < tx->limit &&
+                   tx->snd_nxt - tx->snd_una < RUDP_RING - 1 &&
+                   (!tx->pacing || tx->tokens >= tx->seg * (segs + 1))) {
+                fill_data(tx, buf + used + (size_t)segs * tx->seg, tx->snd_nxt++, now);
+                segs++;
+            }
+        } else {
+            break;
+        }
+
+        if (!segs)
+            break;
+        first[nmsg] = s;
+        segs_of[nmsg] = segs;
+        iov[nmsg].iov_len = (size_t)segs * tx->seg;
+        memset(&msgs[nmsg], 0, sizeof(msgs[nmsg]));
+        msgs[nmsg].msg_hdr.msg_iov = &iov[nmsg];
+        msgs[nmsg].msg_hdr.msg_iovlen = 1;
+        used += iov[nmsg].iov_len;
+        if (tx->pacing)
+            tx->tokens -= (double)segs * tx->seg;
+        npkt += segs;
+        nmsg++;
+    }
+
+    if (!nmsg)
+        return 0;
+
+    r = sendmmsg(fd, msgs, nmsg, 0);
+    if (r < 0)
+        r = 0;
+    /*
+     * 못 보낸 메시지(ENOBUFS, ICMP 오류 등)는 보낸 적 없던 것으로 되돌림:
+     * 재전송은 다시 ST_LOST, 새 데이터는 snd_nxt 를 되감음. 새 데이터는 배치 끝에
+     * 모여 있으므로 뒤에서부터 되돌리면 snd_nxt 가 연속으로 유지됨
+     */
+    for (i = nmsg - 1; i >= r; i--) {
+        uint64_t k;
+
+        if (retx_of[i]) {
+            tx_set_state(tx, first[i], ST_LOST);
+            if (first[i] < tx->retx_scan)
+                tx->retx_scan = first[i];
+            tx->retransmits--;
+        } else {
+            for (k = 0; k < (uint64_t)segs_of[i]; k++)
+                tx_set_state(tx, first[i] + k, ST_FREE);
+            tx->snd_nxt = first[i];
+        }
+        if (tx->pacing)
+            tx->tokens += (double)segs_of[i] * tx->seg;
+        npkt -= segs_of[i];
+    }
+    return npkt;
+}
+
+static void tx_poll_acks(int fd, struct rudp_tx *tx, int timeout_us, int *fin)
+{
+    static unsigned char bufs[RUDP_MAX_BATCH][RUDP_ACK_MAX];
+    struct mmsghdr msgs[RUDP_MAX_BATCH];
+    struct iovec iov[RUDP_MAX_BATCH];
+    struct timespec ts = { 0, (long)timeout_us * 1000 };
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    int i, n;
+
+    if (timeout_us > 0 && ppoll(&pfd, 1, &ts, NULL) <= 0)
+        return;
+
+    for (i = 0; i < RUDP_MAX_BATCH; i++) {
+        iov[i].iov_base = bufs[i];
+        iov[i].iov_len  = sizeof(bufs[i]);
+        memset(&msgs[i], 0, sizeof(msgs[i]));
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    for (;;) {
+        uint64_t now;
+
+        n = recvmmsg(fd, msgs, RUDP_MAX_BATCH, MSG_DONTWAIT, NULL);
+        if (n <= 0)
+            return;
+        now = now_us();
+        for (i = 0; i < n; i++) {
+            struct rudp_hdr h;
+
+            if (get_hdr(bufs[i], msgs[i].msg_len, &h) < 0)
+                continue;
+            if (h.type == RUDP_ACK)
+                tx_on_ack(tx, bufs[i], msgs[i].msg_len, &h, now);
+            else if (h.type == RUDP_FIN && fin)
+                *fin = 1;
+        }
+    }
+}
+
+struct rudp_send_opts {
+    const char *host;
+    int port;
+    double seconds;
+    uint64_t bytes;
+    uint32_t seg;
+    int batch, gso, pacing, weight, fast_conv;
+    const char *json;
+};
+
+static void write_json(const struct rudp_send_opts *o, const struct rudp_tx *tx,
+                       double secs, const double *ivals, int nivals)
+{
+    uint32_t payload = tx->seg - sizeof(struct rudp_hdr);
+    double bytes = (double)tx->acked_pkts * payload;
+    double bps = secs > 0 ? bytes * 8 / secs : 0;
+    double mean_rtt = tx->rtt_samples ? (double)tx->rtt_sum_us / tx->rtt_samples : 0;
+    FILE *f = fopen(o->json, "w");
+    int i;
+
+    if (!f)
+        return;
+
+    fprintf(f, "{\"start\": {\"tool\": \"rudp\", \"segment\": %u, \"gso\": %d, \"pacing\": %d, "
+               "\"weight\": %d, \"fast_convergence\": %d},\n",
+            tx->seg, tx->gso, tx->pacing, o->weight, o->fast_conv);
+    fprintf(f, " \"intervals\": [");
+    for (i = 0; i < nivals; i++)
+        fprintf(f, "%s{\"sum\": {\"start\": %d, \"end\": %d, \"bits_per_second\": %.1f}}",
+                i ? ", " : "", i, i + 1, ivals[i]);
+    fprintf(f, "],\n");
+    fprintf(f, " \"end\": {\"sum_sent\": {\"seconds\": %.6f, \"bytes\": %.0f, "
+               "\"bits_per_second\": %.1f, \"retransmits\": %llu},\n",
+            secs, bytes, bps, (unsigned long long)tx->retransmits);
+    fprintf(f, "  \"streams\": [{\"sender\": {\"bits_per_second\": %.1f, \"mean_rtt\": %.0f, "
+               "\"retransmits\": %llu, \"loss_events\": %llu, \"rto_events\": %llu, "
+               "\"final_cwnd\": %u}}]}}\n",
+            bps, mean_rtt, (unsigned long long)tx->retransmits,
+            (unsigned long long)tx->loss_events, (unsigned long long)tx->rto_events,
+            reno_cc_cwnd(&tx->cc));
+    fclose(f);
+}
+
+static int run_send(const struct rudp_send_opts *o)
+{
+    struct reno_cc_config cfg = {
+        .mss = o->seg - sizeof(struct rudp_hdr),
+        .cwnd_clamp = RUDP_RING - 1,
+        .weight = o->weight, .weighted = o->weight > 1,
+        .fc_beta = o->fast_conv ? 870 : 0,
+    };
+    struct addrinfo hints = { .ai_family = AF_INET, .ai_socktype = SOCK_DGRAM }, *ai;
+    struct rudp_tx tx = { 0 };
+    unsigned char *buf;
+    char portstr[16];
+    uint64_t t0, deadline, now, last_ival, last_acked = 0;
+    double ivals[3600];
+    int nivals = 0, fd, fin = 0, tries, gave_up = 0;
+    int gso_seg;
+
+    snprintf(portstr, sizeof(portstr), "%d", o->port);
+    if (getaddrinfo(o->host, portstr, &hints, &ai) != 0) {
+        fprintf(stderr, "rudp send: cannot resolve %s\n", o->host);
+        return 1;
+    }
+    fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0 || connect(fd, ai->ai_addr, ai->ai_addrlen) < 0) {
+        perror("rudp send: connect");
+        return 1;
+    }
+    freeaddrinfo(ai);
+    set_bufs(fd);
+
+    tx.seg = o->seg;
+    tx.gso = o->gso;
+    tx.pacing = o->pacing;
+    tx.gso_segs = RUDP_UDP_MAX_PAYLOAD / tx.seg;
+    if (tx.gso_segs > RUDP_GSO_SEGS)
+        tx.gso_segs = RUDP_GSO_SEGS;
+    gso_seg = (int)tx.seg;
+    if (tx.gso && setsockopt(fd, SOL_UDP, UDP_SEGMENT, &gso_seg, sizeof(gso_seg)) < 0) {
+        fprintf(stderr, "rudp send: UDP_SEGMENT unsupported, GSO off\n");
+        tx.gso = 0;
+    }
+    if (!tx.gso)
+        tx.gso_segs = 1;
+
+    tx.state   = calloc(RUDP_RING, 1);
+    tx.sent_us = calloc(RUDP_RING, sizeof(uint64_t));
+    tx.sackmap = calloc(RUDP_RING / 64, sizeof(uint64_t));
+    buf = calloc((size_t)RUDP_MAX_BATCH * RUDP_GSO_SEGS, tx.seg);
+    if (!tx.state || !tx.sent_us || !tx.sackmap || !buf)
+        return 1;
+
+    reno_cc_init(&tx.cc, &cfg);
+    tx.limit = o->bytes ? (o->bytes + cfg.mss - 1) / cfg.mss : UINT64_MAX;
+    tx.rto_us = 1000000;    /* RTT 샘플 전 초기 RTO 1초 */
+
+    t0 = now_us();
+    tx.last_progress_us = tx.last_refill_us = last_ival = t0;
+    deadline = o->bytes ? UINT64_MAX : t0 + (uint64_t)(o->seconds * 1e6);
+
+    /* 본 전송: 시간 모드는 deadline 까지, 바이트 모드는 전부 ACK 될 때까지 */
+    while (!stop_flag) {
+        int sending_new, sent;
+
+        now = now_us();
+        sending_new = now < deadline;
+        if (!sending_new && tx.snd_una == tx.snd_nxt)
+            break;
+        if (tx.limit != UINT64_MAX && tx.snd_una == tx.limit)
+            break;
+        /* 시간 모드 종료 후 남은 패킷은 최대 5초까지만 기다림 */
+        if (!sending_new && deadline != UINT64_MAX && now > deadline + 5000000)
+            break;
+        /* 수신측이 없거나 경로가 끊기면 바이트 모드는 deadline 이 없으므로 RTO 횟수로 포기 */
+        if (tx.rto_streak >= RUDP_MAX_RTOS) {
+            fprintf(stderr, "rudp send: no progress after %d consecutive RTOs, giving up\n",
+                    RUDP_MAX_RTOS);
+            gave_up = 1;
+            break;
+        }
+
+        tx_poll_acks(fd, &tx, 0, NULL);
+        tx_check_rto(&tx, now);
+        sent = tx_send(fd, &tx, buf, o->batch, sending_new);
+
+        if (now - last_ival >= 1000000 && nivals < (int)(sizeof(ivals) / sizeof(ivals[0]))) {
+            ivals[nivals++] = (double)(tx.acked_pkts - last_acked) * cfg.mss * 8 /
+                              ((now - last_ival) / 1e6);
+            last_acked = tx.acked_pkts;
+            last_ival = now;
+        }
+
+        /* 보낼 것이 없으면 ACK 또는 페이싱 토큰을 기다림 */
+        if (!sent)
+            tx_poll_acks(fd, &tx, tx.cwnd_limited ? 1000 : 50, NULL);
+    }
+    now = now_us();
+
+    /* FIN 교환 */
+    for (tries = 0; tries < 10 && !fin; tries++) {
+        unsigned char fbuf[sizeof(struct rudp_hdr)];
+
+        put_hdr(fbuf, RUDP_FIN, 0, 0, tx.snd_una, 0);
+        send(fd, fbuf, sizeof(fbuf), 0);
+        tx_poll_acks(fd, &tx, 100000, &fin);
+    }
+
+    {
+        double secs = (now - t0) / 1e6;
+        double gbps = secs > 0 ? (double)tx.acked_pkts * cfg.mss * 8 / secs / 1e9 : 0;
+
+        printf("sent %llu pkts (%llu retransmits, %llu loss events, %llu RTOs) in %.2f s: "
+               "%.3f Gbit/s goodput, srtt %.1f ms, final cwnd %u%s\n",
+               (unsigned long long)tx.acked_pkts, (unsigned long long)tx.retransmits,
+               (unsigned long long)tx.loss_events, (unsigned long long)tx.rto_events,
+               secs, gbps, tx.srtt_us / 1e3, reno_cc_cwnd(&tx.cc),
+               fin ? "" : " (no FIN reply)");
+        if (o->json)
+            write_json(o, &tx, secs, ivals, nivals);
+    }
+
+    free(buf);
+    free(tx.state);
+    free(tx.sent_us);
+    free(tx.sackmap);
+    close(fd);
+    return gave_up;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: rudp recv <port> [-j json]\n"
+            "       rudp send <host> <port> [-t sec | -n bytes] [-s seg] [-b batch]\n"
+            "                 [-G] [-P] [-w weight] [-F] [-j json]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    struct rudp_send_opts o = {
+        .seconds = 10, .seg = RUDP_DEFAULT_SEG, .batch = 16, .gso = 1, .pacing = 1,
+        .weight = 1,
+    };
+    const char *json = NULL;
+    int i;
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    if (argc < 3)
+        usage();
+
+    if (!strcmp(argv[1], "recv")) {
+        for (i = 3; i < argc; i++) {
+            if (!strcmp(argv[i], "-j") && i + 1 < argc)
+                json = argv[++i];
+            else
+                usage();
+        }
+        return run_recv(atoi(argv[2]), json);
+    }
+
+    if (strcmp(argv[1], "send") || argc < 4)
+        usage();
+
+    o.host = argv[2];
+    o.port = atoi(argv[3]);
+    for (i = 4; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc)
+            o.seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+            o.bytes = strtoull(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-s") && i + 1 < argc)
+            o.seg = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc)
+            o.batch = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-w") && i + 1 < argc)
+            o.weight = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc)
+            o.json = argv[++i];
+        else if (!strcmp(argv[i], "-G"))
+            o.gso = 0;
+        else if (!strcmp(argv[i], "-P"))
+            o.pacing = 0;
+        else if (!strcmp(argv[i], "-F"))
+            o.fast_conv = 1;
+        else
+            usage();
+    }
+
+    if (o.seg < sizeof(struct rudp_hdr) + 64 || o.seg > RUDP_MAX_SEG ||
+        o.batch < 1 || o.batch > RUDP_MAX_BATCH || o.weight < 1 ||
+        o.weight > (int)RENO_MAX_WEIGHT)
+        usage();
+
+    return run_send(&o);
+}
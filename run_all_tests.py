@@ -8,7 +8,12 @@ import subprocess
 import time
 import os
 import shutil
+import signal
 import sys
+import json
+
+from exp_common import set_module_param, get_module_param, load_corpus, CORPUS_FILE
+from live_dashboard import DashboardServer
 
 # 테스트 시나리오 정의
 TEST_SCENARIOS = [
@@ -20,7 +25,8 @@ TEST_SCENARIOS = [
     {
         'name': 'high_bw_latency',
         'file': 'exp_multiflow_high_bw_latency.py',
-        'description': '높은 대역폭 + 높은 지연'
+        'description': '높은 대역폭 + 높은 지연',
+        'link': 'edt'       # 10 Gbit/s x 50ms: netem 대신 eBPF EDT + fq (edt_link.py)
     },
     {
         'name': 'high_loss',
@@ -31,11 +37,62 @@ TEST_SCENARIOS = [
         'name': 'jitter',
         'file': 'exp_multiflow_jitter.py',
         'description': '지연 변동 (jitter)'
+    },
+    {
+        'name': 'trace_link',
+        'file': 'exp_trace_link.py',
+        'description': '트레이스 기반 가변 용량 링크 (linkemu)'
+    },
+    {
+        'name': 'dumbbell',
+        'file': 'exp_dumbbell.py',
+        'description': '덤벨 (단일 병목 + 역방향 트래픽)'
+    },
+    {
+        'name': 'parking_lot',
+        'file': 'exp_parking_lot.py',
+        'description': '파킹랏 (다중 병목 + 홉별 교차 트래픽)'
+    },
+    {
+        'name': 'policer',
+        'file': 'exp_policer.py',
+        'args': ['police'],
+        'description': '토큰 버킷 폴리서 (50 Mbit/s, 초과분 드롭)'
+    },
+    {
+        'name': 'shaper',
+        'file': 'exp_policer.py',
+        'args': ['shape'],
+        'description': 'tbf 셰이퍼 (50 Mbit/s, 큐잉)'
+    },
+    {
+        'name': 'cross_traffic',
+        'file': 'exp_cross_traffic.py',
+        'args': ['mix'],
+        'description': '벌크 흐름 + 배경 트래픽 (CBR, on-off UDP, TCP mice)'
+    },
+    {
+        'name': 'app_limited',
+        'file': 'exp_app_limited.py',
+        'description': '앱 제한 송신 + 청크 스트리밍 (BWE 추적)'
+    },
+    {
+        'name': 'incast',
+        'file': 'exp_incast.py',
+        'description': '데이터센터 incast (동기화된 다대일 응답, 얕은 버퍼)'
     }
 ]
 
 CC_ALGOS = ['reno', 'reno_custom']
+# reno_custom BWE 추정 방식 (모듈 파라미터 bwe_mode), --bwe-variants=window 등으로 추가 실행
+# 추가 변형 결과는 /tmp/results_{시나리오}_reno_custom-{변형} 에 저장 (analyze_estimator.py)
+BWE_VARIANTS = {'ack': 0, 'window': 1}
+# 링크 에뮬레이션 백엔드: 시나리오의 'link' 키 (기본 netem), --link=netem|edt 로 전체 강제
+# 실험 스크립트는 환경 변수 RENO_LINK 로 받음 (edt_link.link_cls 를 쓰는 시나리오만 해당)
+LINK_BACKENDS = ('netem', 'edt')
 DURATION = 10  # 각 테스트 시간 (초)
+FINISH_TIMEOUT = 60  # exit 전송 후 종료 대기 (링크 보정 단계 시간 포함)
+FINISH_POLL = 0.5    # 종료 대기 중 Abort 확인 간격 (초)
 
 def cleanup_mininet():
     """Mininet 네트워크 정리"""
@@ -50,6 +107,7 @@ def cleanup_old_logs():
     print("🗑️  Removing old iperf3 logs...")
     subprocess.run(['rm', '-f', '/tmp/iperf3_*.json'], shell=False)
     subprocess.run(['bash', '-c', 'rm -f /tmp/iperf3_*.json'])
+    subprocess.run(['rm', '-f', '/tmp/calibration.json', '/tmp/estimator_samples.csv'])
 
 def backup_logs(scenario_name, cc_algo):
     """로그 파일을 시나리오별로 백업"""
@@ -60,12 +118,21 @@ def backup_logs(scenario_name, cc_algo):
     import glob
     for log_file in glob.glob('/tmp/iperf3_h*_*.json'):
         shutil.copy(log_file, backup_dir)
+    # 링크 보정 결과와 추정기 샘플, 코퍼스 시나리오 요약도 함께 보관
+    for extra in ('/tmp/calibration.json', '/tmp/estimator_samples.csv',
+                  f'/tmp/scenario_{cc_algo.partition("-")[0]}.json'):
+        if os.path.exists(extra):
+            shutil.copy(extra, backup_dir)
     
     print(f"📦 Logs backed up to {backup_dir}")
     return backup_dir
 
-def run_test(scenario, cc_algo):
-    """특정 시나리오와 CC 알고리즘으로 테스트 실행"""
+def scenario_wait(scenario):
+    """exit 를 보내기 전까지 기다리는 시간 (vm_run.py 도 이 값 + FINISH_TIMEOUT 을 제한 시간으로)"""
+    return DURATION + 5 + scenario.get('extra_wait', 0)
+
+def run_test(scenario, cc_algo, dashboard=None):
+    """특정 시나리오와 CC 알고리즘으로 테스트 실행 (중단/실패하면 None 반환)"""
     print(f"\n{'='*60}")
     print(f"🚀 Running: {scenario['description']}")
     print(f"   Algorithm: {cc_algo}")
@@ -77,8 +144,14 @@ def run_test(scenario, cc_algo):
     # 이전 로그 삭제
     cleanup_old_logs()
     
-    # 테스트 실행
-    cmd = ['sudo', 'python3', scenario['file'], cc_algo]
+    # reno_custom-window → cc reno_custom + bwe_mode=1
+    cc, _, variant = cc_algo.partition('-')
+    if cc == 'reno_custom' and get_module_param('bwe_mode') is not None:
+        set_module_param('bwe_mode', BWE_VARIANTS[variant or 'ack'])
+
+    # 테스트 실행 (sudo 가 환경을 지우므로 env 로 전달)
+    link = link_backend(scenario)
+    cmd = ['sudo', 'env', f'RENO_LINK={link}', 'python3', scenario['file'], cc] + scenario.get('args', [])
     print(f"📝 Command: {' '.join(cmd)}")
     
     # 자동으로 exit를 입력하기 위해 echo 사용
@@ -90,19 +163,46 @@ def run_test(scenario, cc_algo):
         text=True
     )
     
-    # duration + 여유 시간만큼 대기
-    print(f"⏳ Waiting {DURATION + 5} seconds for test to complete...")
-    time.sleep(DURATION + 5)
+    # duration + 여유 시간만큼 대기 (대시보드에서 Abort 를 누르면 즉시 중단)
+    wait = scenario_wait(scenario)
+    print(f"⏳ Waiting {wait:.0f} seconds for test to complete...")
+    if dashboard:
+        dashboard.new_run(f"{scenario['name']} / {cc_algo}")
+        if dashboard.wait(wait):
+            return abort_run(process, scenario, cc_algo)
+    else:
+        time.sleep(wait)
     
-    # CLI에 exit 명령 전송
+    # CLI에 exit 명령 전송 (종료를 기다리는 FINISH_TIMEOUT 동안에도 Abort 확인)
     try:
         process.stdin.write('exit\n')
         process.stdin.flush()
-        process.wait(timeout=5)
-    except:
-        process.terminate()
-        process.wait()
-    
+    except OSError:
+        pass
+    deadline = time.time() + FINISH_TIMEOUT
+    while True:
+        try:
+            process.wait(timeout=FINISH_POLL)
+            break
+        except subprocess.TimeoutExpired:
+            pass
+        if dashboard and dashboard.wait(0):
+            return abort_run(process, scenario, cc_algo)
+        if time.time() >= deadline:
+            process.terminate()
+            process.wait()
+            break
+
+    # 링크 설정 실패 등으로 스크립트가 오류로 끝나면 빈 결과를 분석에 넘기지 않음
+    if process.returncode not in (0, -signal.SIGTERM):
+        err = process.stderr.read().strip().splitlines()
+        print(f"❌ Test failed (exit {process.returncode})")
+        for line in err[-5:]:
+            print(f"   {line}")
+        cleanup_mininet()
+        shutil.rmtree(f"/tmp/results_{scenario['name']}_{cc_algo}", ignore_errors=True)
+        return None
+
     print("✅ Test completed")
     
     # 로그 백업
@@ -110,30 +210,94 @@ def run_test(scenario, cc_algo):
     
     return backup_dir
 
+def abort_run(process, scenario, cc_algo):
+    """대시보드 Abort: 실험을 멈추고 결과를 버림"""
+    print("🛑 Aborted from dashboard")
+    process.terminate()
+    process.wait()
+    cleanup_mininet()
+    # 불완전한 결과가 분석에 섞이지 않도록 백업하지 않음
+    shutil.rmtree(f"/tmp/results_{scenario['name']}_{cc_algo}", ignore_errors=True)
+    return None
+
+def link_backend(scenario):
+    """--link=... 가 있으면 그것, 없으면 시나리오의 'link' (기본 netem)"""
+    for arg in sys.argv[1:]:
+        if arg.startswith('--link='):
+            link = arg.split('=', 1)[1]
+            if link not in LINK_BACKENDS:
+                print(f"❌ Unknown link backend: {link} (choose from {', '.join(LINK_BACKENDS)})")
+                sys.exit(1)
+            return link
+    return scenario.get('link', 'netem')
+
+def bwe_variants():
+    """--bwe-variants=ack,window 인자 → 변형 이름 목록"""
+    for arg in sys.argv[1:]:
+        if arg.startswith('--bwe-variants='):
+            names = arg.split('=', 1)[1].split(',')
+            unknown = [n for n in names if n not in BWE_VARIANTS]
+            if unknown:
+                print(f"❌ Unknown BWE variant(s): {', '.join(unknown)} "
+                      f"(choose from {', '.join(BWE_VARIANTS)})")
+                sys.exit(1)
+            return names
+    return []
+
+def corpus_scenarios():
+    """--corpus[=경로] 인자 → search_scenarios.py 코퍼스 항목을 exp_scenario.py 시나리오로"""
+    for arg in sys.argv[1:]:
+        if arg == '--corpus' or arg.startswith('--corpus='):
+            path = arg.split('=', 1)[1] if '=' in arg else CORPUS_FILE
+            corpus = load_corpus(path)
+            if not corpus:
+                print(f"❌ No scenarios in {path} (run search_scenarios.py first)")
+                sys.exit(1)
+            return [{
+                'name': c['name'],
+                'file': 'exp_scenario.py',
+                'args': [json.dumps(c['params']), str(DURATION)],
+                'description': c.get('description', c['name']),
+                # 시작 간격만큼 마지막 흐름이 늦게 끝나고 링크 보정도 흐름 수에 비례
+                'extra_wait': c['params'].get('stagger_s', 0) * (c['params'].get('flows', 1) - 1),
+            } for c in corpus]
+    return []
+
 def main():
+    scenarios = TEST_SCENARIOS + corpus_scenarios()
+
     print("="*60)
     print("🔬 TCP Congestion Control Test Suite")
     print("="*60)
-    print(f"Scenarios: {len(TEST_SCENARIOS)}")
+    print(f"Scenarios: {len(scenarios)}")
     print(f"Algorithms: {', '.join(CC_ALGOS)}")
     print(f"Duration per test: {DURATION}s")
-    print(f"Total estimated time: ~{len(TEST_SCENARIOS) * len(CC_ALGOS) * (DURATION + 10) / 60:.0f} minutes")
+    print(f"Total estimated time: ~{len(scenarios) * len(CC_ALGOS) * (DURATION + 10) / 60:.0f} minutes")
     print("="*60)
     
+    dashboard = None
+    if '--no-dashboard' not in sys.argv:
+        dashboard = DashboardServer()
+        print(f"📈 Live dashboard: {dashboard.start()}")
+
     input("\n⏸️  Press Enter to start tests...")
     
     results_map = {}
     
+    algos = CC_ALGOS + [f'reno_custom-{v}' for v in bwe_variants() if v != 'ack']
+
     # 모든 시나리오 실행
-    for scenario in TEST_SCENARIOS:
+    for scenario in scenarios:
         results_map[scenario['name']] = {}
         
-        for cc_algo in CC_ALGOS:
-            backup_dir = run_test(scenario, cc_algo)
-            results_map[scenario['name']][cc_algo] = backup_dir
+        for cc_algo in algos:
+            backup_dir = run_test(scenario, cc_algo, dashboard)
+            results_map[scenario['name']][cc_algo] = backup_dir or '(aborted or failed)'
     
     # 최종 정리
     cleanup_mininet()
+    if get_module_param('bwe_mode') is not None:
+        set_module_param('bwe_mode', BWE_VARIANTS['ack'])
     
     print("\n" + "="*60)
     print("✅ All tests completed!")
@@ -151,11 +315,12 @@ def main():
     
     # 결과 분석 실행
     subprocess.run(['python3', 'analyze_all_results.py'])
+    subprocess.run(['python3', 'analyze_estimator.py'])
 
 if __name__ == "__main__":
     if os.geteuid() != 0:
         print("❌ This script must be run with sudo!")
-        print("Usage: sudo python3 run_all_tests.py")
+        print("Usage: sudo python3 run_all_tests.py [--no-dashboard] [--bwe-variants=ack,window] [--corpus[=file]] [--link=netem|edt]")
         sys.exit(1)
     
     main()
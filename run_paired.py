@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+짝지은(paired) 비교: 같은 seed 의 손상 패턴으로 reno 와 reno_custom 을 번갈아 실행
+- exp_trace_link.py (linkemu) 에 gen_impair.py 패턴을 넣어 두 알고리즘이 seed 마다
+  비트 단위로 같은 손실(Gilbert-Elliott)/지터 순서를 겪게 함 (용량 트레이스도 고정)
+- seed 별 차이 d = reno_custom - reno 의 평균과 95% 신뢰구간으로 판단
+  → seed 간 변동(어떤 손실 순서가 나왔나)이 차이에서 상쇄되어 분산이 줄어듦
+- 같은 실행들을 짝짓지 않은 것처럼 본 신뢰구간과, 유의성에 필요한 반복 수 추정을 함께 출력
+- 실행 결과는 /tmp/results_paired_s{seed}_{cc}, 요약은 PAIRED_SUMMARY
+
+사용법: sudo python3 run_paired.py [반복 수] [손실%] [버스트] [지터ms] [qdisc]
+       python3 run_paired.py analyze [반복 수]       # 이미 실행한 결과만 다시 분석
+"""
+
+import glob
+import json
+import math
+import os
+import statistics
+import sys
+
+from analyze_all_results import extract_metrics_from_json
+
+CC_ALGOS = ['reno', 'reno_custom']
+REPS = 5
+PAIRED_SUMMARY = '/tmp/paired_summary.json'
+RESULT_DIR = '/tmp/results_paired_s{}_{}'
+
+# 양측 95% t 분위수 (자유도 1~30, 그 이상은 정규 근사)
+T975 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+
+def t975(df):
+    return T975[df - 1] if 1 <= df <= len(T975) else 1.96
+
+
+def run_metrics(seed, cc):
+    """한 실행의 {'goodput_mbps', 'rtt_ms', 'retrans'} (결과가 없으면 None)"""
+    tput, rtts, retx = 0.0, [], 0
+    files = glob.glob(f"{RESULT_DIR.format(seed, cc)}/iperf3_h*_{cc}.json")
+    for path in files:
+        try:
+            with open(path) as f:
+                m = extract_metrics_from_json(json.load(f))
+        except (OSError, ValueError):
+            continue
+        tput += m['throughput_bps'] / 1e6
+        if m['mean_rtt_ms'] > 0:
+            rtts.append(m['mean_rtt_ms'])
+        retx += m['retransmits']
+    if not files or tput <= 0:
+        return None
+    return {'goodput_mbps': tput, 'rtt_ms': statistics.mean(rtts) if rtts else 0.0,
+            'retrans': retx}
+
+
+def reps_needed(diff, var, t=1.96):
+    """평균 차이 diff 를 분산 var 로 95% 유의하게 보려면 필요한 반복 수 (근사)"""
+    if diff == 0:
+        return math.inf
+    return max(2, math.ceil(t * t * var / (diff * diff)))
+
+
+def compare(values_a, values_b):
+    """seed 순서로 짝지은 두 목록 → 짝지은/짝짓지 않은 통계"""
+    n = len(values_a)
+    d = [b - a for a, b in zip(values_a, values_b)]
+    mean = statistics.mean(d)
+    var_p = statistics.variance(d) if n > 1 else 0.0
+    var_u = ((statistics.variance(values_a) + statistics.variance(values_b))
+             if n > 1 else 0.0)
+    t = t975(n - 1)
+    return {
+        'n': n, 'mean_diff': mean,
+        'paired_ci': t * math.sqrt(var_p / n),
+        'unpaired_ci': t * math.sqrt(var_u / n),
+        'paired_reps': reps_needed(mean, var_p),
+        'unpaired_reps': reps_needed(mean, var_u),
+        'variance_ratio': var_u / var_p if var_p > 0 else math.inf,
+    }
+
+
+def analyze(reps):
+    pairs = []
+    for seed in range(1, reps + 1):
+        runs = {cc: run_metrics(seed, cc) for cc in CC_ALGOS}
+        if all(runs.values()):
+            pairs.append((seed, runs))
+    if len(pairs) < 2:
+        print(f"❌ Need at least 2 complete seeds, found {len(pairs)}")
+        return None
+
+    print(f"\n=== Paired comparison: {CC_ALGOS[1]} - {CC_ALGOS[0]}, {len(pairs)} seeds ===")
+    print(f"{'Seed':<6}" + ''.join(f"{cc + ' Mbps':<20}" for cc in CC_ALGOS) + "Diff")
+    for seed, runs in pairs:
+        a, b = (runs[cc]['goodput_mbps'] for cc in CC_ALGOS)
+        print(f"{seed:<6}{a:<20.2f}{b:<20.2f}{b - a:+.2f}")
+
+    summary = {'seeds': [s for s, _ in pairs], 'metrics': {}}
+    print(f"\n{'Metric':<14} {'Mean diff':<12} {'Paired 95% CI':<16} {'Unpaired 95% CI':<18} "
+          f"{'Var ratio':<10} Reps needed (paired / unpaired)")
+    for key in ('goodput_mbps', 'rtt_ms', 'retrans'):
+        a = [runs[CC_ALGOS[0]][key] for _, runs in pairs]
+        b = [runs[CC_ALGOS[1]][key] for _, runs in pairs]
+        r = compare(a, b)
+        summary['metrics'][key] = r
+        sig = '*' if abs(r['mean_diff']) > r['paired_ci'] else ' '
+        print(f"{key:<14} {r['mean_diff']:<+12.2f} ±{r['paired_ci']:<14.2f}{sig} "
+              f"±{r['unpaired_ci']:<17.2f} {r['variance_ratio']:<10.1f} "
+              f"{r['paired_reps']} / {r['unpaired_reps']}")
+    print("* = paired difference significant at 95%")
+
+    with open(PAIRED_SUMMARY, 'w') as f:
+        json.dump(summary, f, indent=1, default=str)
+    print(f"Saved to {PAIRED_SUMMARY}")
+    return summary
+
+
+def main(reps, loss_pct, burst, jitter_ms, qdisc):
+    from run_all_tests import run_test
+
+    print(f"🔁 {reps} seeds x {len(CC_ALGOS)} algorithms, loss {loss_pct}% burst {burst}, "
+          f"jitter {jitter_ms}ms, {qdisc}")
+    for seed in range(1, reps + 1):
+        scenario = {
+            'name': f'paired_s{seed}',
+            'file': 'exp_trace_link.py',
+            'args': [qdisc, str(loss_pct), str(burst), str(jitter_ms), str(seed)],
+            'description': f'trace link, impairment seed {seed}',
+        }
+        # 두 알고리즘이 같은 seed 패턴을 연달아 사용 (seed 안에서 순서 효과는 번갈아 상쇄)
+        order = CC_ALGOS if seed % 2 else CC_ALGOS[::-1]
+        for cc in order:
+            if run_test(scenario, cc) is None:
+                return
+    analyze(reps)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) > 1 and sys.argv[1] == 'analyze':
+        analyze(int(sys.argv[2]) if len(sys.argv) > 2 else REPS)
+        sys.exit(0)
+    if os.geteuid() != 0:
+        sys.exit(__doc__)
+    reps = int(sys.argv[1]) if len(sys.argv) > 1 else REPS
+    loss_pct = float(sys.argv[2]) if len(sys.argv) > 2 else 1.0
+    burst = float(sys.argv[3]) if len(sys.argv) > 3 else 4.0
+    jitter_ms = float(sys.argv[4]) if len(sys.argv) > 4 else 0.0
+    qdisc = sys.argv[5] if len(sys.argv) > 5 else 'droptail'
+    main(reps, loss_pct, burst, jitter_ms, qdisc)
@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+"""
+적대적 시나리오 탐색: reno_custom 이 기준선(reno 등)보다 나빠지는 조건을 찾아 코퍼스로 저장
+- 탐색 공간: 대역폭, RTT, RTT 분산(흐름 혼합), 지터, 손실률/버스트(Gilbert-Elliott),
+  버퍼(BDP 배수), 흐름 수, 시작 간격, 교차 트래픽 비율/주기
+- 평가: 같은 시나리오/seed 로 후보와 기준선을 돌려 지표 차이(gap = 기준선 - 후보)를 최대화
+  backend sim: reno_sim (유저스페이스 모델, 실행당 수십 ms, 병렬)
+  backend emu: exp_scenario.py (mininet 에뮬레이터, 실행당 수십 초, 순차)
+- 격자 대신 진화 전략: 상위 개체를 부모로 가우시안 변이 + 균등 교차,
+  변이 폭은 1/5 성공 규칙으로 조절, 일부는 무작위 개체로 다양성 유지
+- 결과: gap 순위 + 정규화 공간에서 서로 떨어진 시나리오만 골라 코퍼스(JSON)로 저장
+  run_all_tests.py --corpus 로 회귀 시험에 추가, --verify=N 이면 상위 N 개를 에뮬레이터로 재확인
+
+사용법: python3 search_scenarios.py [--backend=sim|emu] [--metric=goodput|fairness|min_share|delay]
+                                     [--budget=평가횟수] [--candidate=custom] [--baseline=reno]
+                                     [--seeds=2] [--top=10] [--verify=N] [--out=scenario_corpus.json]
+  --candidate/--baseline: reno_sim 인자 문자열 (예: "custom -k 1280", "reno")
+"""
+
+import json
+import math
+import os
+import random
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+from exp_common import CORPUS_FILE
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SIM = os.path.join(HERE, 'reno_sim')
+# 두 백엔드 모두 마지막 흐름 시작 뒤 SIM_SECS 초 (전체 길이 = SIM_SECS + stagger_s * (flows - 1))
+SIM_SECS = 20
+EMU_SETUP_S = 90            # mininet 구성 + 보정 + iperf3 종료 대기
+
+# 이름: (최소, 최대, 척도, reno_sim 옵션)
+SPACE = {
+    'bw_mbps':    (1.0, 1000.0, 'log', '-b'),
+    'rtt_ms':     (0.5, 400.0, 'log', '-r'),
+    'rtt_spread': (0.0, 4.0, 'lin', '-R'),
+    'jitter_ms':  (0.0, 20.0, 'lin', '-j'),
+    'loss_pct':   (0.0, 2.0, 'lin', '-l'),
+    'burst':      (1.0, 10.0, 'lin', '-B'),
+    'buf_bdp':    (0.05, 4.0, 'log', '-q'),
+    'flows':      (1, 32, 'int', '-n'),
+    'stagger_s':  (0.0, 5.0, 'lin', '-s'),
+    'cross_frac': (0.0, 0.7, 'lin', '-x'),
+    'cross_ms':   (10.0, 2000.0, 'log', '-X'),
+}
+NAMES = list(SPACE)
+
+# 기존 수동 시나리오에 가까운 출발점 (run_all_tests.py 의 20_flows / high_bw_latency / high_loss / jitter)
+REFERENCE = [
+    {'bw_mbps': 1000, 'rtt_ms': 4, 'flows': 20, 'buf_bdp': 1.0},
+    {'bw_mbps': 1000, 'rtt_ms': 100, 'flows': 5, 'buf_bdp': 1.0},
+    {'bw_mbps': 100, 'rtt_ms': 20, 'flows': 5, 'loss_pct': 1.0},
+    {'bw_mbps': 100, 'rtt_ms': 20, 'flows': 5, 'jitter_ms': 10},
+]
+
+# 지표: 결과 dict → 클수록 좋은 값
+METRICS = {
+    'goodput':   lambda r, p: r['utilization'],
+    'fairness':  lambda r, p: r['jain'],
+    'min_share': lambda r, p: r['min_share'],
+    'delay':     lambda r, p: -r['qdelay_ms_p95'] / p['rtt_ms'],
+}
+
+
+def decode(u):
+    """정규화 벡터 [0,1]^d → 시나리오 파라미터"""
+    params = {}
+    for name, x in zip(NAMES, u):
+        lo, hi, scale, _ = SPACE[name]
+        if scale == 'log':
+            v = lo * (hi / lo) ** x
+        elif scale == 'int':
+            v = int(round(lo * (hi / lo) ** x))
+        else:
+            v = lo + (hi - lo) * x
+        params[name] = round(v, 4) if isinstance(v, float) else v
+    return params
+
+
+def encode(params):
+    """파라미터 (일부만 있어도 됨) → 정규화 벡터, 없는 값은 중앙/최소"""
+    u = []
+    for name in NAMES:
+        lo, hi, scale, _ = SPACE[name]
+        v = params.get(name)
+        if v is None:
+            u.append(0.0 if scale == 'lin' else 0.5)
+        elif scale in ('log', 'int'):
+            u.append(math.log(max(v, lo) / lo) / math.log(hi / lo))
+        else:
+            u.append((v - lo) / (hi - lo))
+    return [min(max(x, 0.0), 1.0) for x in u]
+
+
+def run_sim(spec, params, seed):
+    cmd = [SIM] + spec.split()[1:] + ['-c', spec.split()[0], '-t', str(SIM_SECS), '-S', str(seed)]
+    for name, v in params.items():
+        cmd += [SPACE[name][3], str(v)]
+    out = subprocess.run(cmd, capture_output=True, text=True, check=True).stdout
+    return json.loads(out)
+
+
+def run_emu(spec, params, seed):
+    """exp_scenario.py 를 한 번 실행 (CLI 는 exit 로 종료), 요약 JSON 을 읽음.
+    실패/시간 초과면 None (이전 시나리오의 결과 파일을 읽지 않도록 먼저 지움)"""
+    cc = {'custom': 'reno_custom', 'reno': 'reno'}.get(spec.split()[0], spec.split()[0])
+    path = f'/tmp/scenario_{cc}.json'
+    timeout = SIM_SECS + params.get('stagger_s', 0) * (params.get('flows', 1) - 1) + EMU_SETUP_S
+    if os.path.exists(path):
+        os.remove(path)
+    subprocess.run(['mn', '-c'], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    try:
+        r = subprocess.run(['python3', os.path.join(HERE, 'exp_scenario.py'), cc, json.dumps(params),
+                            str(SIM_SECS)],
+                           input='exit\n', text=True, stdout=subprocess.DEVNULL,
+                           stderr=subprocess.DEVNULL, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        print(f"  emulator run timed out after {timeout:.0f}s ({cc})", file=sys.stderr)
+        subprocess.run(['mn', '-c'], stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        return None
+    if r.returncode != 0 or not os.path.exists(path):
+        print(f"  emulator run failed ({cc}, exit {r.returncode})", file=sys.stderr)
+        return None
+    with open(path) as f:
+        return json.load(f)
+
+
+class Evaluator:
+    def __init__(self, backend, metric, candidate, baseline, seeds):
+        self.run = run_emu if backend == 'emu' else run_sim
+        self.seeds = 1 if backend == 'emu' else seeds
+        self.metric = METRICS[metric]
+        self.candidate, self.baseline = candidate, baseline
+        self.evals = 0
+
+    def __call__(self, u):
+        params = decode(u)
+        gaps, cand, base = [], None, None
+        for seed in range(1, self.seeds + 1):
+            cand = self.run(self.candidate, params, seed)
+            base = self.run(self.baseline, params, seed)
+            if cand is None or base is None:
+                # 실행 실패는 gap 을 알 수 없음: 부모로도, 코퍼스로도 뽑히지 않게 최하위로
+                self.evals += 1
+                return {'u': u, 'params': params, 'gap': float('-inf'), 'failed': True,
+                        'candidate': cand, 'baseline': base}
+            gaps.append(self.metric(base, params) - self.metric(cand, params))
+        self.evals += 1
+        return {'u': u, 'params': params, 'gap': sum(gaps) / len(gaps),
+                'candidate': cand, 'baseline': base}
+
+
+def search(evaluate, budget, workers, pop=12, rng=None):
+    """(μ+λ) 진화 전략, 반환: 평가한 모든 개체 (gap 내림차순)"""
+    rng = rng or random.Random(1)
+    d = len(NAMES)
+    sigma, elite = 0.25, max(3, pop // 3)
+    start = [encode(p) for p in REFERENCE]
+    start += [[rng.random() for _ in range(d)] for _ in range(pop - len(start))]
+
+    with ThreadPoolExecutor(max_workers=workers) as ex:
+        archive = list(ex.map(evaluate, start))
+        while len(archive) < budget:
+            archive.sort(key=lambda e: -e['gap'])
+            parents = archive[:elite]
+            children, par = [], []
+            for i in range(min(pop, budget - len(archive))):
+                # 10% 는 무작위 (국소 최적에 갇히지 않도록)
+                if rng.random() < 0.1:
+                    children.append([rng.random() for _ in range(d)])
+                    par.append(None)
+                    continue
+                p = parents[rng.randrange(len(parents))]
+                u = list(p['u'])
+                if rng.random() < 0.3:
+                    q = parents[rng.randrange(len(parents))]['u']
+                    u = [a if rng.random() < 0.5 else b for a, b in zip(u, q)]
+                u = [min(max(x + rng.gauss(0, sigma), 0.0), 1.0) for x in u]
+                children.append(u)
+                par.append(p)
+            results = list(ex.map(evaluate, children))
+            wins = sum(1 for r, p in zip(results, par) if p and r['gap'] > p['gap'])
+            tries = sum(1 for p in par if p) or 1
+            # 1/5 성공 규칙
+            sigma *= math.exp((wins / tries - 0.2) / 0.8)
+            sigma = min(max(sigma, 0.02), 0.5)
+            archive += results
+            best = max(archive, key=lambda e: e['gap'])
+            print(f"  evals {len(archive):4d}  best gap {best['gap']:+.4f}  sigma {sigma:.3f}",
+                  file=sys.stderr)
+    return sorted(archive, key=lambda e: -e['gap'])
+
+
+def diverse_top(ranked, top, min_dist=0.2):
+    """gap 순서대로, 이미 고른 시나리오와 정규화 거리 min_dist 이상인 것만"""
+    picked = []
+    for e in ranked:
+        if e['gap'] <= 0:
+            break
+        if all(math.dist(e['u'], p['u']) >= min_dist for p in picked):
+            picked.append(e)
+        if len(picked) >= top:
+            break
+    return picked
+
+
+def describe(p):
+    parts = [f"{p['bw_mbps']:g} Mbit/s", f"RTT {p['rtt_ms']:g} ms", f"{p['flows']} flows",
+             f"buffer {p['buf_bdp']:g} BDP"]
+    if p['rtt_spread'] > 0.1:
+        parts.append(f"RTT x{1 + p['rtt_spread']:.1f} spread")
+    if p['loss_pct'] > 0.01:
+        parts.append(f"loss {p['loss_pct']:.2f}% (burst {p['burst']:.1f})")
+    if p['jitter_ms'] > 0.5:
+        parts.append(f"jitter {p['jitter_ms']:.1f} ms")
+    if p['cross_frac'] > 0.05:
+        parts.append(f"cross {p['cross_frac'] * 100:.0f}%")
+    if p['stagger_s'] > 0.1:
+        parts.append(f"stagger {p['stagger_s']:.1f}s")
+    return ', '.join(parts)
+
+
+def option(name, default):
+    for arg in sys.argv[1:]:
+        if arg.startswith(f'--{name}='):
+            return type(default)(arg.split('=', 1)[1])
+    return default
+
+
+def main():
+    backend = option('backend', 'sim')
+    metric = option('metric', 'goodput')
+    budget = option('budget', 300 if backend == 'sim' else 24)
+    candidate = option('candidate', 'custom')
+    baseline = option('baseline', 'reno')
+    seeds = option('seeds', 2)
+    top = option('top', 10)
+    verify = option('verify', 0)
+    out = option('out', CORPUS_FILE)
+
+    if metric not in METRICS or backend not in ('sim', 'emu'):
+        sys.exit(__doc__)
+    if backend == 'sim' and not os.path.exists(SIM):
+        sys.exit("reno_sim not built: make userspace")
+
+    print(f"=== Adversarial search: {candidate} vs {baseline}, metric {metric}, "
+          f"{backend}, budget {budget} ===", file=sys.stderr)
+    evaluate = Evaluator(backend, metric, candidate, baseline, seeds)
+    workers = 1 if backend == 'emu' else os.cpu_count() or 1
+    ranked = search(evaluate, budget, workers)
+    picked = diverse_top(ranked, top)
+
+    if verify:
+        emu = Evaluator('emu', metric, candidate, baseline, 1)
+        for e in picked[:verify]:
+            print(f"  verifying in emulator: {describe(e['params'])}", file=sys.stderr)
+            r = emu(e['u'])
+            if r.get('failed'):
+                e['emu_failed'] = True
+            else:
+                e['emu_gap'] = r['gap']
+
+    corpus = {
+        'metric': metric, 'candidate': candidate, 'baseline': baseline, 'backend': backend,
+        'evaluations': len(ranked),
+        'scenarios': [{
+            'name': f'adv_{metric}_{i + 1:02d}',
+            'description': f"adversarial ({metric} gap {e['gap']:+.3f}): {describe(e['params'])}",
+            'params': e['params'], 'gap': round(e['gap'], 4),
+            **({'emu_gap': round(e['emu_gap'], 4)} if 'emu_gap' in e else {}),
+            **({'emu_failed': True} if e.get('emu_failed') else {}),
+            'candidate': e['candidate'], 'baseline': e['baseline'],
+        } for i, e in enumerate(picked)],
+    }
+    with open(out, 'w') as f:
+        json.dump(corpus, f, indent=1)
+
+    print(f"\nRank  Gap      {'Emu':<8} Scenario")
+    for i, s in enumerate(corpus['scenarios']):
+        emu = f"{s['emu_gap']:+.3f}" if 'emu_gap' in s else 'failed' if s.get('emu_failed') else '-'
+        print(f"{i + 1:<5} {s['gap']:+.4f}  {emu:<8} {describe(s['params'])}")
+    if not corpus['scenarios']:
+        print(f"no scenario where {candidate} is worse than {baseline} on {metric}")
+    print(f"\nSaved {len(corpus['scenarios'])} scenarios to {out} "
+          f"(sudo python3 run_all_tests.py --corpus to run them)")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,261 @@
+"""
+장시간(수 시간) soak 테스트용 고정 메모리 스트리밍 집계
+
+iperf3 -J 의 초 단위 intervals 는 실행 시간에 비례해 커지고 분석기는 파일 전체를
+메모리에 올리므로, soak 모드에서는 샘플을 바로 아래 구조로 흘려 넣고 버린다.
+  - QuantileSketch:     로그 버킷 히스토그램 (상대 오차 ~1%, 버킷 수 상한)
+  - RollingSketch:      전체 + 최근 N 개 창 스케치 (창 단위로 회전)
+  - DownsampledSeries:  버킷 수가 차면 이웃 버킷을 합쳐 폭을 두 배로 (count/sum/min/max)
+  - detect_drift:       다운샘플 시계열 앞/뒤 구간 비교 + 기울기로 느린 악화 검출
+SoakCollector 가 지표별로 이들을 묶고 주기적으로 JSON 체크포인트를 원자적으로 쓴다.
+
+  python3 soak_collector.py /tmp/soak_reno_custom.json   # 체크포인트 요약 출력
+"""
+
+import json
+import math
+import os
+import sys
+
+SKETCH_ALPHA = 0.01       # 분위수 상대 오차
+SKETCH_MAX_BUCKETS = 1024
+SERIES_BUCKETS = 512
+DRIFT_TOL = 0.10          # 앞/뒤 구간 대비 10% 이상 악화면 경고
+DRIFT_MIN_BUCKETS = 16
+
+
+class QuantileSketch:
+    """양수 값 로그 버킷 히스토그램. 0 이하는 별도 카운트"""
+
+    def __init__(self, alpha=SKETCH_ALPHA, max_buckets=SKETCH_MAX_BUCKETS):
+        self.gamma = (1 + alpha) / (1 - alpha)
+        self.log_gamma = math.log(self.gamma)
+        self.max_buckets = max_buckets
+        self.buckets = {}
+        self.zero = 0
+        self.count = 0
+        self.min = math.inf
+        self.max = -math.inf
+
+    def add(self, x):
+        self.count += 1
+        self.min = min(self.min, x)
+        self.max = max(self.max, x)
+        if x <= 0:
+            self.zero += 1
+            return
+        k = math.ceil(math.log(x) / self.log_gamma)
+        self.buckets[k] = self.buckets.get(k, 0) + 1
+        if len(self.buckets) > self.max_buckets:
+            self._collapse()
+
+    def _collapse(self):
+        # 가장 작은 두 버킷을 합침 (꼬리 상위 분위수 정확도 유지)
+        lo, nxt = sorted(self.buckets)[:2]
+        self.buckets[nxt] += self.buckets.pop(lo)
+
+    def merge(self, other):
+        for k, n in other.buckets.items():
+            self.buckets[k] = self.buckets.get(k, 0) + n
+        while len(self.buckets) > self.max_buckets:
+            self._collapse()
+        self.zero += other.zero
+        self.count += other.count
+        self.min = min(self.min, other.min)
+        self.max = max(self.max, other.max)
+
+    def quantile(self, q):
+        if self.count == 0:
+            return None
+        rank = q * (self.count - 1)
+        if rank < self.zero:
+            return 0.0
+        seen = self.zero
+        for k in sorted(self.buckets):
+            seen += self.buckets[k]
+            if seen > rank:
+                # 버킷 중앙값 (상대 오차 alpha 이내), 실제 min/max 로 제한
+                v = 2 * self.gamma ** k / (self.gamma + 1)
+                return min(max(v, self.min), self.max)
+        return self.max
+
+    def summary(self):
+        if self.count == 0:
+            return {'count': 0}
+        return {'count': self.count, 'min': self.min, 'max': self.max,
+                'p50': self.quantile(0.50), 'p95': self.quantile(0.95),
+                'p99': self.quantile(0.99)}
+
+
+class RollingSketch:
+    """전체 스케치 + 최근 windows 개 창 스케치 (창 길이 window 초)"""
+
+    def __init__(self, window=600.0, windows=6):
+        self.window = window
+        self.total = QuantileSketch()
+        self.ring = [QuantileSketch() for _ in range(windows)]
+        self.epoch = 0
+
+    def add(self, t, x):
+        epoch = int(t // self.window)
+        while self.epoch < epoch:
+            self.epoch += 1
+            self.ring[self.epoch % len(self.ring)] = QuantileSketch()
+        self.total.add(x)
+        self.ring[epoch % len(self.ring)].add(x)
+
+    def recent(self):
+        s = QuantileSketch()
+        for r in self.ring:
+            s.merge(r)
+        return s
+
+
+class DownsampledSeries:
+    """고정 개수 버킷 시계열: 가득 차면 인접 버킷 두 개씩 합쳐 해상도를 절반으로"""
+
+    def __init__(self, step=1.0, capacity=SERIES_BUCKETS):
+        self.step = step
+        self.capacity = capacity
+        self.buckets = []       # [시작 t, count, sum, min, max]
+
+    def add(self, t, x):
+        start = t - t % self.step
+        if self.buckets and self.buckets[-1][0] == start:
+            b = self.buckets[-1]
+            b[1] += 1
+            b[2] += x
+            b[3] = min(b[3], x)
+            b[4] = max(b[4], x)
+            return
+        self.buckets.append([start, 1, x, x, x])
+        if len(self.buckets) > self.capacity:
+            self._halve()
+
+    def _halve(self):
+        self.step *= 2
+        merged = []
+        for b in self.buckets:
+            start = b[0] - b[0] % self.step
+            if merged and merged[-1][0] == start:
+                m = merged[-1]
+                m[1] += b[1]
+                m[2] += b[2]
+                m[3] = min(m[3], b[3])
+                m[4] = max(m[4], b[4])
+            else:
+                merged.append([start] + b[1:])
+        self.buckets = merged
+
+    def means(self):
+        return [(b[0] + self.step / 2, b[2] / b[1]) for b in self.buckets]
+
+
+def detect_drift(points, higher_is_better, tol=DRIFT_TOL):
+    """
+    points: [(t, 평균), ...] 다운샘플 시계열
+    첫 25% 구간 중앙값 대비 마지막 25% 구간 중앙값의 변화율과 최소제곱 기울기 방향이
+    모두 나쁜 쪽이고 변화율이 tol 을 넘으면 드리프트로 판정
+    """
+    if len(points) < DRIFT_MIN_BUCKETS:
+        return None
+    q = len(points) // 4
+    head = sorted(v for _, v in points[:q])[q // 2]
+    tail = sorted(v for _, v in points[-q:])[q // 2]
+    if head == 0:
+        return None
+    change = (tail - head) / abs(head)
+
+    n = len(points)
+    mt = sum(t for t, _ in points) / n
+    mv = sum(v for _, v in points) / n
+    var = sum((t - mt) ** 2 for t, _ in points)
+    slope = sum((t - mt) * (v - mv) for t, v in points) / var if var > 0 else 0.0
+
+    worse = change < -tol and slope < 0 if higher_is_better else change > tol and slope > 0
+    return {'change': change, 'slope_per_hour': slope * 3600, 'flag': worse,
+            'head': head, 'tail': tail}
+
+
+class SoakCollector:
+    """
+    지표별 RollingSketch + DownsampledSeries, 이상 이벤트 카운터
+    metrics: {이름: higher_is_better(True/False/None=드리프트 검사 안 함)}
+    """
+
+    def __init__(self, metrics, path, step=1.0, window=600.0):
+        self.path = path
+        self.direction = dict(metrics)
+        self.sketch = {m: RollingSketch(window) for m in metrics}
+        self.series = {m: DownsampledSeries(step) for m in metrics}
+        self.anomalies = {}     # 이름 → [횟수, 첫 t, 마지막 t]
+        self.elapsed = 0.0
+
+    def add(self, name, t, x):
+        if x is None:
+            return
+        self.elapsed = max(self.elapsed, t)
+        self.sketch[name].add(t, x)
+        self.series[name].add(t, x)
+
+    def anomaly(self, name, t):
+        a = self.anomalies.setdefault(name, [0, t, t])
+        a[0] += 1
+        a[2] = t
+
+    def drift(self):
+        out = {}
+        for m, better in self.direction.items():
+            if better is None:
+                continue
+            d = detect_drift(self.series[m].means(), better)
+            if d:
+                out[m] = d
+        return out
+
+    def snapshot(self):
+        return {
+            'elapsed_s': self.elapsed,
+            'metrics': {m: {'total': self.sketch[m].total.summary(),
+                            'recent': self.sketch[m].recent().summary(),
+                            'step_s': self.series[m].step,
+                            'series': self.series[m].buckets}
+                        for m in self.direction},
+            'drift': self.drift(),
+            'anomalies': {k: {'count': v[0], 'first_s': v[1], 'last_s': v[2]}
+                          for k, v in self.anomalies.items()},
+        }
+
+    def checkpoint(self):
+        """임시 파일에 쓰고 rename (중단되어도 마지막 체크포인트는 온전)"""
+        tmp = self.path + '.tmp'
+        with open(tmp, 'w') as f:
+            json.dump(self.snapshot(), f)
+        os.replace(tmp, self.path)
+
+
+def format_report(snap):
+    lines = [f"elapsed {snap['elapsed_s'] / 3600:.2f} h"]
+    lines.append(f"{'Metric':<16} {'p50':>10} {'p95':>10} {'p99':>10} "
+                 f"{'recent p50':>11} {'recent p99':>11}")
+    for m, d in snap['metrics'].items():
+        t, r = d['total'], d['recent']
+        if not t.get('count'):
+            continue
+        lines.append(f"{m:<16} {t['p50']:>10.2f} {t['p95']:>10.2f} {t['p99']:>10.2f} "
+                     f"{r.get('p50') or 0:>11.2f} {r.get('p99') or 0:>11.2f}")
+    for m, d in snap['drift'].items():
+        mark = '!! DRIFT' if d['flag'] else 'ok'
+        lines.append(f"{mark:<8} {m}: {d['head']:.2f} -> {d['tail']:.2f} "
+                     f"({d['change'] * 100:+.1f}%, {d['slope_per_hour']:+.3f}/h)")
+    for k, a in snap['anomalies'].items():
+        lines.append(f"!! {k}: {a['count']} times ({a['first_s']:.0f}s ~ {a['last_s']:.0f}s)")
+    return '\n'.join(lines)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print(f"usage: {sys.argv[0]} <soak checkpoint json>")
+        sys.exit(1)
+    with open(sys.argv[1]) as f:
+        print(format_report(json.load(f)))
@@ -1,56 +1,65 @@
 from mininet.net import Mininet
 from mininet.topo import Topo
-from mininet.node import OVSKernelSwitch    
+from mininet.node import OVSKernelSwitch
 from mininet.cli import CLI
 from mininet.node import Host
 from mininet.log import setLogLevel, info
 from mininet.link import Link, TCLink
-import socket
+import json
+import sys
 import time
 
+# udp_server.py / udp_client.py 의 hello 교환으로 연결을 확인한 뒤
+# rudp (reno_custom 유저스페이스 구현) 로 신뢰성 UDP 대용량 전송을 실행
+# 먼저 `make userspace` 로 ./rudp 를 빌드해야 함
+
 
 class SimpleTopology(Topo):
-    def build(self):
+    def build(self, bw=1000, delay='10ms', loss=0.1):
         h1 = self.addHost('h1')
         h2 = self.addHost('h2')
         s1 = self.addSwitch('s1')
-        self.addLink(h1, s1)
+        self.addLink(h1, s1, cls=TCLink, bw=bw, delay=delay, loss=loss)
         self.addLink(h2, s1)
 
 
-
-
-def main():
+def main(duration=10):
     topo = SimpleTopology()
-    net = Mininet( topo=topo)
+    net = Mininet(topo=topo, link=TCLink)
 
     net.start()
 
     h1 = net.get('h1')
     h2 = net.get('h2')
 
+    # hello 교환으로 연결 확인
     h2.cmd('python3 udp_server.py &')
+    time.sleep(1)
+    print(h1.cmd('python3 udp_client.py 10.0.0.2'))
 
+    # h1 → h2 로 duration 초 동안 대용량 전송
+    h2.cmd('./rudp recv 12346 -j /tmp/rudp_recv.json > /tmp/rudp_recv.log 2>&1 &')
     time.sleep(1)
 
     start_time = time.time()
-
-    result = h1.cmd('python3 udp_client.py 10.0.0.2')
-    
-
+    result = h1.cmd(f'./rudp send 10.0.0.2 12346 -t {duration} -j /tmp/iperf3_h1_rudp.json')
     end_time = time.time()
 
-
-    rtt = (end_time - start_time) * 1000
-    print("Round-trip time: {0:.2f} ms".format(rtt))
     print(result)
+    print("Elapsed: {0:.2f} s".format(end_time - start_time))
 
-
-
-
+    try:
+        with open('/tmp/iperf3_h1_rudp.json') as f:
+            sender = json.load(f)["end"]["streams"][0]["sender"]
+        print("Goodput: {0:.3f} Gbit/s, mean RTT {1:.2f} ms, retransmits {2}".format(
+            sender["bits_per_second"] / 1e9, sender["mean_rtt"] / 1000.0,
+            sender["retransmits"]))
+    except (OSError, ValueError, KeyError):
+        print("rudp result not found")
 
     net.stop()
 
+
 if __name__ == '__main__':
     setLogLevel('info')
-    main()
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 10)
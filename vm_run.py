@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""
+일회용 VM 백엔드: 모듈 빌드마다 최소 VM(virtme-ng / virtme + QEMU)을 띄워 그 안에서 시나리오 실행
+- reload_module.sh 처럼 호스트에서 rmmod/insmod 하거나 전역 sysctl 을 바꾸지 않음
+  → 잘못된 모듈이 커널을 멈춰도 그 VM 만 죽고, 여러 빌드를 동시에 비교 가능
+- VM 은 호스트 루트를 읽기 전용으로 공유 (mininet/iperf3/OVS 와 이 저장소를 그대로 사용),
+  결과 디렉터리 하나만 쓰기 가능으로 붙여 게스트가 그 안에 결과를 바로 씀
+- 결과 저장 위치는 run_all_tests.py 와 같은 /tmp/results_{시나리오}_{cc}@{라벨}
+  게스트 콘솔은 [라벨] 접두어로 실시간 출력 + console.log, iperf3/보정/추정기 로그는 2초마다 동기화
+- 모두 끝나면 빌드별 처리량/이용률/공정성/RTT/재전송 비교표와 /tmp/vm_compare_{시나리오}.json
+
+빌드 지정: 라벨=경로.ko 또는 라벨=git 리비전 (그 리비전 소스를 꺼내 --kdir 커널 트리로 빌드)
+게스트 커널은 기본으로 호스트 커널 (모듈도 그 커널용으로 빌드해야 함), --kernel 로 다른 bzImage
+
+사용법: sudo python3 vm_run.py <시나리오> <라벨=빌드> [<라벨=빌드> ...]
+                              [--cc=reno_custom] [--kernel=bzImage] [--kdir=커널 빌드 트리]
+                              [--jobs=N] [--mem=2G] [--cpus=2] [--corpus[=file]] [--link=netem|edt]
+  예: sudo python3 vm_run.py 20_flows base=HEAD~1 new=./reno_custom.ko
+"""
+
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+from run_all_tests import (TEST_SCENARIOS, FINISH_TIMEOUT, corpus_scenarios, link_backend,
+                           scenario_wait)
+from analyze_all_results import SCENARIO_CONFIGS, extract_metrics_from_json, jain_fairness
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+RESULT_DIR = '/tmp/results_{}_{}@{}'
+COMPARE_FILE = '/tmp/vm_compare_{}.json'
+BOOT_TIMEOUT = 120        # 부팅 + 모듈 로드 + 링크 보정 여유 (초)
+SYNC_INTERVAL = 2         # 게스트 → 결과 디렉터리 동기화 간격 (초)
+
+# 게스트에서 실행하는 스크립트 (결과 디렉터리에 써서 VM 에 넘김)
+GUEST_SCRIPT = """#!/bin/sh
+OUT={out}
+echo "vm: $(uname -r), $(nproc) cpus"
+insmod $OUT/reno_custom.ko || {{ echo "vm: insmod failed"; exit 1; }}
+cat /sys/module/reno_custom/srcversion 2>/dev/null | sed 's/^/vm: srcversion /'
+# OVS 는 게스트 안에서 새로 (호스트 데이터베이스는 읽기 전용)
+export OVS_RUNDIR=/tmp/ovs OVS_DBDIR=/tmp/ovs OVS_LOGDIR=/tmp/ovs
+mkdir -p /tmp/ovs
+/usr/share/openvswitch/scripts/ovs-ctl start --system-id=random --no-monitor > /dev/null 2>&1 \\
+    || echo "vm: ovs-ctl start failed"
+( while sleep {sync}; do cp -u /tmp/iperf3_h*_*.json /tmp/calibration.json \\
+      /tmp/estimator_samples.csv /tmp/scenario_*.json $OUT/ 2>/dev/null; done ) &
+cd {repo}
+echo exit | RENO_LIVE=0 RENO_LINK={link} timeout {timeout} python3 {file} {cc} {args}
+echo "vm: scenario exit $?"
+cp /tmp/iperf3_h*_*.json /tmp/calibration.json /tmp/estimator_samples.csv \\
+    /tmp/scenario_*.json $OUT/ 2>/dev/null
+cat /proc/net/reno_custom > $OUT/module_stats.txt 2>/dev/null
+# 정상 로드/해제 메시지는 빼고 문제만 (비어 있지 않으면 호스트가 경고)
+dmesg | grep -E 'BUG|WARNING|Oops|Call Trace|reno_custom: registration failed' > $OUT/dmesg.txt
+sync
+poweroff -f
+"""
+
+print_lock = threading.Lock()
+
+
+def opt(name, default=None):
+    for arg in sys.argv[1:]:
+        if arg.startswith(f'--{name}='):
+            return arg.split('=', 1)[1]
+    return default
+
+
+def find_scenario(name):
+    for s in TEST_SCENARIOS + corpus_scenarios():
+        if s['name'] == name:
+            return s
+    names = ', '.join(s['name'] for s in TEST_SCENARIOS)
+    sys.exit(f"unknown scenario: {name} (choose from {names} or a corpus name with --corpus)")
+
+
+def build_module(label, spec, kdir, out):
+    """빌드 지정 → out/reno_custom.ko (.ko 경로는 복사, 아니면 git 리비전으로 보고 빌드)"""
+    if spec.endswith('.ko') and os.path.exists(spec):
+        shutil.copy(spec, f'{out}/reno_custom.ko')
+        return
+    src = tempfile.mkdtemp(prefix=f'vm_build_{label}_')
+    try:
+        archive = subprocess.run(['git', '-C', HERE, 'archive', spec], check=True,
+                                 stdout=subprocess.PIPE).stdout
+        subprocess.run(['tar', '-x', '-C', src], input=archive, check=True)
+        res = subprocess.run(['make', '-C', kdir, f'M={src}', 'modules'], text=True,
+                             stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        with open(f'{out}/build.log', 'w') as f:
+            f.write(res.stdout)
+        if res.returncode != 0:
+            raise RuntimeError(f"build of {spec} failed (see {out}/build.log)")
+        shutil.copy(f'{src}/reno_custom.ko', f'{out}/reno_custom.ko')
+    finally:
+        shutil.rmtree(src, ignore_errors=True)
+
+
+def vm_command(kernel, out, script, mem, cpus):
+    """virtme-ng (vng) 우선, 없으면 virtme-run"""
+    if shutil.which('vng'):
+        return ['vng', '--run'] + ([kernel] if kernel else []) + [
+            '--user', 'root', '--memory', mem, '--cpus', str(cpus), '--rwdir', out,
+            '--overlay-rwdir', '/etc', '--overlay-rwdir', '/var', '--exec', f'sh {script}']
+    if shutil.which('virtme-run'):
+        kimg = ['--kimg', kernel] if kernel else ['--installed-kernel']
+        return ['virtme-run'] + kimg + [
+            '--rwdir', out, '--memory', mem, '--script-sh', f'sh {script}',
+            '--qemu-opts', '-smp', str(cpus)]
+    sys.exit("neither vng (virtme-ng) nor virtme-run found")
+
+
+def run_vm(label, spec, scenario, cc, kernel, kdir, mem, cpus):
+    out = RESULT_DIR.format(scenario['name'], cc, label)
+    shutil.rmtree(out, ignore_errors=True)
+    os.makedirs(out)
+
+    def say(line):
+        with print_lock:
+            print(f"[{label}] {line}", flush=True)
+
+    try:
+        build_module(label, spec, kdir, out)
+    except (subprocess.CalledProcessError, RuntimeError, OSError) as e:
+        say(f"❌ {e}")
+        return label, out, False
+
+    # run_all_tests.py 와 같은 예산: exit 전 대기 + 종료 대기 (보정 단계 포함)
+    timeout = scenario_wait(scenario) + FINISH_TIMEOUT
+    script = f'{out}/guest.sh'
+    with open(script, 'w') as f:
+        f.write(GUEST_SCRIPT.format(out=out, repo=HERE, file=scenario['file'], cc=cc,
+                                    args=' '.join(f"'{a}'" for a in scenario.get('args', [])),
+                                    link=link_backend(scenario), timeout=timeout,
+                                    sync=SYNC_INTERVAL))
+
+    cmd = vm_command(kernel, out, script, mem, cpus)
+    say(f"🚀 {' '.join(cmd)}")
+    ok = False
+    with open(f'{out}/console.log', 'w') as log:
+        proc = subprocess.Popen(cmd, stdin=subprocess.DEVNULL, stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT, text=True)
+        timer = threading.Timer(timeout + BOOT_TIMEOUT, proc.kill)
+        timer.start()
+        for line in proc.stdout:
+            log.write(line)
+            log.flush()
+            say(line.rstrip())
+            if line.startswith('vm: scenario exit 0'):
+                ok = True
+        proc.wait()
+        timer.cancel()
+    if proc.returncode and not ok:
+        say(f"❌ VM exited with {proc.returncode} (killed after timeout?)")
+    return label, out, ok
+
+
+def summarize(out, cc, capacity_gbps):
+    tputs, rtts, retx = [], [], 0
+    for name in sorted(os.listdir(out)):
+        if not (name.startswith('iperf3_h') and name.endswith(f'_{cc}.json')):
+            continue
+        try:
+            with open(f'{out}/{name}') as f:
+                m = extract_metrics_from_json(json.load(f))
+        except (OSError, ValueError):
+            continue
+        if m['throughput_bps'] > 0:
+            tputs.append(m['throughput_bps'] / 1e9)
+        if m['mean_rtt_ms'] > 0:
+            rtts.append(m['mean_rtt_ms'])
+        retx += m['retransmits']
+    if not tputs:
+        return None
+    total = sum(tputs)
+    return {'total_throughput_gbps': total,
+            'link_utilization_percent': total / capacity_gbps * 100 if capacity_gbps else 0.0,
+            'fairness_index': jain_fairness(tputs),
+            'avg_latency_ms': sum(rtts) / len(rtts) if rtts else 0.0,
+            'retransmits': retx, 'num_flows': len(tputs)}
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith('--')]
+    if len(args) < 2 or any('=' not in a for a in args[1:]):
+        sys.exit(__doc__)
+    scenario = find_scenario(args[0])
+    builds = [a.split('=', 1) for a in args[1:]]
+    cc = opt('cc', 'reno_custom')
+    kernel = opt('kernel')
+    kdir = opt('kdir', f'/lib/modules/{os.uname().release}/build')
+    jobs = int(opt('jobs', len(builds)))
+    mem, cpus = opt('mem', '2G'), int(opt('cpus', 2))
+
+    print(f"=== {scenario['name']} ({cc}) in {len(builds)} VMs, {jobs} at a time ===")
+    with ThreadPoolExecutor(max_workers=jobs) as ex:
+        done = list(ex.map(lambda b: run_vm(b[0], b[1], scenario, cc, kernel, kdir, mem, cpus),
+                           builds))
+
+    capacity = SCENARIO_CONFIGS.get(scenario['name'], {}).get('link_capacity_gbps', 0)
+    results = {}
+    print(f"\n{'Build':<16} {'Tput (Gbps)':<12} {'Util (%)':<10} {'Fairness':<10} "
+          f"{'RTT (ms)':<10} {'Retrans':<8} Results")
+    print("-" * 100)
+    for label, out, ok in done:
+        r = summarize(out, cc, capacity) if ok else None
+        results[label] = {'dir': out, 'ok': ok, 'metrics': r}
+        if r:
+            print(f"{label:<16} {r['total_throughput_gbps']:<12.3f} "
+                  f"{r['link_utilization_percent']:<10.1f} {r['fairness_index']:<10.3f} "
+                  f"{r['avg_latency_ms']:<10.2f} {r['retransmits']:<8} {out}")
+        else:
+            print(f"{label:<16} {'(failed)':<52} {out}/console.log")
+        dmesg = f'{out}/dmesg.txt'
+        if os.path.exists(dmesg) and os.path.getsize(dmesg):
+            print(f"{'':<16} ⚠️  kernel messages in {out}/dmesg.txt")
+
+    with open(COMPARE_FILE.format(scenario['name']), 'w') as f:
+        json.dump({'scenario': scenario['name'], 'cc': cc, 'builds': results}, f, indent=1)
+    print(f"\nSaved to {COMPARE_FILE.format(scenario['name'])}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,741 @@
+/*
+ * xtraffic: 실험용 배경 교차 트래픽 생성기 (udp_client/udp_server 확장)
+ *
+ *   수신: ./xtraffic sink <port> [-l log.csv] [-L 로그간격ms]
+ *   송신: ./xtraffic cbr   <host> <port> -r Mbit/s [-s 크기] [-t 초] [-b 배치]
+ *         ./xtraffic onoff <host> <port> -r 피크Mbit/s [-o ON평균ms] [-f OFF평균ms]
+ *                          [-a pareto_shape] [-S seed] ...
+ *         ./xtraffic mice  <host> <port> [-A 도착/초] [-z 평균바이트] [-a pareto_shape]
+ *                          [-m 최대동시] [-S seed] ...
+ *         공통: [-t 초] [-l log.csv] [-L 로그간격ms] [-i 흐름ID]
+ *
+ * - cbr:   고정 속도 UDP, 시작 시각 기준 누적 목표 바이트를 따라가므로 오차가 쌓이지 않음
+ * - onoff: ON 구간 동안 피크 속도 UDP, ON/OFF 길이는 Pareto (heavy-tail)
+ * - mice:  Poisson 도착의 짧은 TCP 흐름, 크기는 Pareto, 완료 시간(FCT) 기록
+ * - 100µs 틱 타이밍 휠로 이벤트(전송 틱, ON/OFF 전환, 흐름 도착)를 관리하고
+ *   UDP 는 sendmmsg 로 배치 전송
+ * - 송신 로그(CSV): 구간별 실제 전송량, mice 는 흐름별 크기/FCT
+ * - sink: UDP(recvmmsg) 와 TCP 를 같은 포트에서 받고 흐름 ID 별 손실 집계
+ */
+
+#define _GNU_SOURCE
+#include <arpa/inet.h>
+#include <endian.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define XT_MAGIC            0x58545246U     /* "XTRF" */
+#define XT_TICK_NS          100000ULL       /* 타이밍 휠 틱 100µs */
+#define XT_WHEEL_SLOTS      4096            /* 약 410ms 한 바퀴, 넘으면 다음 바퀴 */
+#define XT_MAX_BATCH        64
+#define XT_MAX_PKT          65507
+#define XT_MAX_MICE         1024
+#define XT_MAX_FLOWS        64
+#define XT_SOCK_BUF         (8 << 20)
+
+enum { M_SINK, M_CBR, M_ONOFF, M_MICE };
+
+struct xt_hdr {
+    uint32_t magic;
+    uint32_t flow;
+    uint64_t seq;
+    uint64_t ts_ns;
+} __attribute__((packed));
+
+/* ------------------------------------------------------------------ */
+/* 타이밍 휠 */
+
+struct xt_timer {
+    struct xt_timer *next;
+    uint64_t due_tick;
+    void (*fn)(struct xt_timer *t, uint64_t now);
+};
+
+static struct {
+    struct xt_timer *slot[XT_WHEEL_SLOTS];
+    uint64_t cur_tick;
+} wheel;
+
+static void wheel_add(struct xt_timer *t, uint64_t due_ns)
+{
+    uint64_t tick = due_ns / XT_TICK_NS;
+    struct xt_timer **s;
+
+    if (tick <= wheel.cur_tick)
+        tick = wheel.cur_tick + 1;
+    t->due_tick = tick;
+    s = &wheel.slot[tick % XT_WHEEL_SLOTS];
+    t->next = *s;
+    *s = t;
+}
+
+/* now 까지의 틱을 모두 처리 (한 바퀴 이상 남은 타이머는 슬롯에 그대로) */
+static void wheel_advance(uint64_t now)
+{
+    uint64_t target = now / XT_TICK_NS;
+
+    while (wheel.cur_tick < target) {
+        struct xt_timer **s, *t, *due = NULL;
+
+        wheel.cur_tick++;
+        s = &wheel.slot[wheel.cur_tick % XT_WHEEL_SLOTS];
+        while ((t = *s)) {
+            if (t->due_tick <= wheel.cur_tick) {
+                *s = t->next;
+                t->next = due;
+                due = t;
+            } else {
+                s = &t->next;
+            }
+        }
+        while ((t = due)) {
+            due = t->next;
+            t->fn(t, now);
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+
+struct xt_opts {
+    int mode;
+    const char *host;
+    int port;
+    double rate_mbps;
+    uint32_t size;
+    double seconds;
+    int batch;
+    double on_ms, off_ms, alpha;
+    double arrivals, mean_bytes;
+    int max_active;
+    uint64_t seed;
+    uint32_t flow;
+    const char *log;
+    uint64_t log_ns;
+};
+
+struct xt_mouse {
+    int fd;
+    uint64_t start_ns;
+    uint64_t size, sent;
+    int done_tx;
+};
+
+static struct {
+    const struct xt_opts *o;
+    int udp_fd;
+    struct sockaddr_storage dst;
+    socklen_t dst_len;
+    uint64_t start_ns, end_ns;
+    uint64_t rng;
+
+    /* UDP 속도 제어: 이번 ON 구간 시작 시각과 그 이후 보낸 바이트 */
+    int on, tx_armed;
+    uint64_t burst_start_ns, burst_bytes;
+    uint64_t seq;
+    struct xt_timer tx_timer, toggle_timer, arrival_timer, log_timer;
+
+    struct xt_mouse mice[XT_MAX_MICE];
+    int nmice;
+
+    /* 로그 구간 / 전체 통계 */
+    uint64_t iv_bytes, iv_pkts, tot_bytes, tot_pkts, send_err;
+    uint64_t flows_started, flows_done, flows_skipped;
+    FILE *log;
+} st;
+
+static volatile sig_atomic_t stop_flag;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop_flag = 1;
+}
+
+/* xorshift64*: 시드 고정으로 재현 가능한 트래픽 */
+static double rand_uniform(void)
+{
+    st.rng ^= st.rng >> 12;
+    st.rng ^= st.rng << 25;
+    st.rng ^= st.rng >> 27;
+    return ((st.rng * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double rand_exp(double mean)
+{
+    return -mean * log(1.0 - rand_uniform());
+}
+
+/* 평균 mean, 모양 alpha(>1) 인 Pareto */
+static double rand_pareto(double mean, double alpha)
+{
+    double xm = mean * (alpha - 1.0) / alpha;
+
+    return xm / pow(1.0 - rand_uniform(), 1.0 / alpha);
+}
+
+static int resolve(const char *host, int port)
+{
+    struct addrinfo hints = { .ai_family = AF_INET }, *ai;
+    char portstr[16];
+
+    snprintf(portstr, sizeof(portstr), "%d", port);
+    if (getaddrinfo(host, portstr, &hints, &ai)) {
+        fprintf(stderr, "xtraffic: cannot resolve %s\n", host);
+        return -1;
+    }
+    memcpy(&st.dst, ai->ai_addr, ai->ai_addrlen);
+    st.dst_len = ai->ai_addrlen;
+    freeaddrinfo(ai);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* UDP CBR / on-off */
+
+static void udp_send_due(uint64_t now)
+{
+    static unsigned char payload[XT_MAX_PKT];
+    struct xt_hdr hdr[XT_MAX_BATCH];
+    struct iovec iov[XT_MAX_BATCH][2];
+    struct mmsghdr msgs[XT_MAX_BATCH];
+    uint32_t size = st.o->size;
+    uint64_t target, due;
+
+    /* 구간 시작부터 now 까지 보냈어야 할 바이트 */
+    target = (uint64_t)((double)(now - st.burst_start_ns) * st.o->rate_mbps / 8000.0);
+    if (target <= st.burst_bytes)
+        return;
+    due = (target - st.burst_bytes) / size;
+
+    while (due > 0) {
+        int n = due < (uint64_t)st.o->batch ? (int)due : st.o->batch;
+        int i, sent;
+
+        for (i = 0; i < n; i++) {
+            hdr[i].magic = htonl(XT_MAGIC);
+            hdr[i].flow  = htonl(st.o->flow);
+            hdr[i].seq   = htobe64(st.seq + i);
+            hdr[i].ts_ns = htobe64(now);
+            iov[i][0].iov_base = &hdr[i];
+            iov[i][0].iov_len  = sizeof(hdr[i]);
+            iov[i][1].iov_base = payload;
+            iov[i][1].iov_len  = size - sizeof(hdr[i]);
+            memset(&msgs[i], 0, sizeof(msgs[i]));
+            msgs[i].msg_hdr.msg_iov = iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 2;
+        }
+        sent = sendmmsg(st.udp_fd, msgs, n, 0);
+        if (sent <= 0) {
+            /* 소켓 버퍼가 가득 차면 이번 몫은 버림 (속도를 따라잡으려 몰아 보내지 않음) */
+            st.send_err++;
+            st.burst_bytes = target;
+            return;
+        }
+        st.seq += sent;
+        st.burst_bytes += (uint64_t)sent * size;
+        st.iv_bytes += (uint64_t)sent * size;
+        st.iv_pkts += sent;
+        st.tot_bytes += (uint64_t)sent * size;
+        st.tot_pkts += sent;
+        due -= sent;
+    }
+}
+
+static void tx_tick(struct xt_timer *t, uint64_t now)
+{
+    st.tx_armed = 0;
+    if (!st.on)
+        return;
+    udp_send_due(now);
+    st.tx_armed = 1;
+    wheel_add(t, now + XT_TICK_NS);
+}
+
+static void toggle(struct xt_timer *t, uint64_t now)
+{
+    double ms;
+
+    if (st.on) {
+        udp_send_due(now);
+        st.on = 0;
+        ms = rand_pareto(st.o->off_ms, st.o->alpha);
+    } else {
+        st.on = 1;
+        st.burst_start_ns = now;
+        st.burst_bytes = 0;
+        if (!st.tx_armed) {
+            st.tx_armed = 1;
+            wheel_add(&st.tx_timer, now + XT_TICK_NS);
+        }
+        ms = rand_pareto(st.o->on_ms, st.o->alpha);
+    }
+    wheel_add(t, now + (uint64_t)(ms * 1e6));
+}
+
+/* ------------------------------------------------------------------ */
+/* TCP mice */
+
+static void mouse_finish(struct xt_mouse *m, uint64_t now, int ok)
+{
+    if (ok) {
+        st.flows_done++;
+        if (st.log)
+            fprintf(st.log, "flow,%llu,%llu,%.3f\n",
+                    (unsigned long long)((m->start_ns - st.start_ns) / 1000000ULL),
+                    (unsigned long long)m->size, (now - m->start_ns) / 1e6);
+    }
+    close(m->fd);
+    *m = st.mice[--st.nmice];
+}
+
+static void arrival(struct xt_timer *t, uint64_t now)
+{
+    struct xt_mouse *m;
+    int fd, one = 1;
+
+    wheel_add(t, now + (uint64_t)(rand_exp(1.0 / st.o->arrivals) * 1e9));
+
+    if (st.nmice >= st.o->max_active) {
+        st.flows_skipped++;
+        return;
+    }
+    fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0)
+        return;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(fd, (struct sockaddr *)&st.dst, st.dst_len) < 0 && errno != EINPROGRESS) {
+        close(fd);
+        return;
+    }
+    m = &st.mice[st.nmice++];
+    memset(m, 0, sizeof(*m));
+    m->fd = fd;
+    m->start_ns = now;
+    m->size = (uint64_t)rand_pareto(st.o->mean_bytes, st.o->alpha);
+    if (m->size == 0)
+        m->size = 1;
+    st.flows_started++;
+}
+
+/* 쓰기 가능하면 남은 바이트 전송, 다 보내면 SHUT_WR 후 서버의 close(EOF) 를 기다림 */
+static void mouse_io(struct xt_mouse *m, short revents, uint64_t now)
+{
+    static unsigned char buf[65536];
+
+    if (revents & (POLLERR | POLLHUP) && !(revents & POLLIN)) {
+        mouse_finish(m, now, 0);
+        return;
+    }
+    if (revents & POLLOUT && !m->done_tx) {
+        while (m->sent < m->size) {
+            size_t len = m->size - m->sent < sizeof(buf) ? m->size - m->sent : sizeof(buf);
+            ssize_t n = send(m->fd, buf, len, MSG_NOSIGNAL);
+
+            if (n <= 0)
+                break;
+            m->sent += n;
+            st.iv_bytes += n;
+            st.tot_bytes += n;
+        }
+        if (m->sent == m->size) {
+            shutdown(m->fd, SHUT_WR);
+            m->done_tx = 1;
+        }
+    }
+    if (revents & POLLIN) {
+        ssize_t n = recv(m->fd, buf, sizeof(buf), 0);
+
+        if (n == 0)
+            mouse_finish(m, now, m->done_tx);
+        else if (n < 0 && errno != EAGAIN)
+            mouse_finish(m, now, 0);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+
+static void log_tick(struct xt_timer *t, uint64_t now)
+{
+    double secs = st.o->log_ns / 1e9;
+
+    if (st.log) {
+        fprintf(st.log, "ival,%llu,%llu,%llu,%.3f\n",
+                (unsigned long long)((now - st.start_ns) / 1000000ULL),
+                (unsigned long long)st.iv_bytes, (unsigned long long)st.iv_pkts,
+                st.iv_bytes * 8 / secs / 1e6);
+        fflush(st.log);
+    }
+    st.iv_bytes = 0;
+    st.iv_pkts = 0;
+    wheel_add(t, now + st.o->log_ns);
+}
+
+static int run_send(const struct xt_opts *o)
+{
+    struct pollfd pfd[XT_MAX_MICE];
+    uint64_t now;
+    int buf = XT_SOCK_BUF, i;
+
+    st.o = o;
+    st.rng = o->seed ? o->seed : 1;
+    if (resolve(o->host, o->port) < 0)
+        return 1;
+
+    if (o->log) {
+        st.log = fopen(o->log, "w");
+        if (!st.log) {
+            perror(o->log);
+            return 1;
+        }
+        fprintf(st.log, "# mode=%s rate_mbps=%.3f size=%u\n",
+                o->mode == M_CBR ? "cbr" : o->mode == M_ONOFF ? "onoff" : "mice",
+                o->rate_mbps, o->size);
+        fprintf(st.log, "# ival,t_ms,bytes,pkts,mbps | flow,start_ms,size,fct_ms\n");
+    }
+
+    if (o->mode != M_MICE) {
+        st.udp_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+        if (st.udp_fd < 0 ||
+            connect(st.udp_fd, (struct sockaddr *)&st.dst, st.dst_len) < 0) {
+            perror("xtraffic: udp");
+            return 1;
+        }
+        setsockopt(st.udp_fd, SOL_SOCKET, SO_SNDBUF, &buf, sizeof(buf));
+    }
+
+    now = now_ns();
+    st.start_ns = now;
+    st.end_ns = now + (uint64_t)(o->seconds * 1e9);
+    wheel.cur_tick = now / XT_TICK_NS;
+
+    st.tx_timer.fn = tx_tick;
+    st.toggle_timer.fn = toggle;
+    st.arrival_timer.fn = arrival;
+    st.log_timer.fn = log_tick;
+    wheel_add(&st.log_timer, now + o->log_ns);
+
+    if (o->mode == M_CBR) {
+        st.on = 1;
+        st.tx_armed = 1;
+        st.burst_start_ns = now;
+        wheel_add(&st.tx_timer, now + XT_TICK_NS);
+    } else if (o->mode == M_ONOFF) {
+        toggle(&st.toggle_timer, now);
+    } else {
+        wheel_add(&st.arrival_timer, now + (uint64_t)(rand_exp(1.0 / o->arrivals) * 1e9));
+    }
+
+    while (!stop_flag && (now = now_ns()) < st.end_ns) {
+        uint64_t next = (wheel.cur_tick + 1) * XT_TICK_NS;
+        struct timespec ts;
+        int n;
+
+        for (i = 0; i < st.nmice; i++) {
+            pfd[i].fd = st.mice[i].fd;
+            pfd[i].events = POLLIN | (st.mice[i].done_tx ? 0 : POLLOUT);
+            pfd[i].revents = 0;
+        }
+        ts.tv_sec = 0;
+        ts.tv_nsec = next > now ? (long)(next - now) : 0;
+        n = ppoll(pfd, st.nmice, &ts, NULL);
+
+        now = now_ns();
+        if (n > 0) {
+            /* 뒤에서부터: mouse_finish 가 마지막 항목을 현재 위치로 옮김 */
+            for (i = st.nmice - 1; i >= 0; i--)
+                if (pfd[i].revents)
+                    mouse_io(&st.mice[i], pfd[i].revents, now);
+        }
+        wheel_advance(now);
+    }
+
+    while (st.nmice)
+        mouse_finish(&st.mice[st.nmice - 1], now_ns(), 0);
+
+    {
+        double secs = (now_ns() - st.start_ns) / 1e9;
+
+        fprintf(stderr, "xtraffic: sent %llu bytes (%llu pkts) in %.2fs = %.2f Mbit/s",
+                (unsigned long long)st.tot_bytes, (unsigned long long)st.tot_pkts,
+                secs, secs > 0 ? st.tot_bytes * 8 / secs / 1e6 : 0.0);
+        if (o->mode == M_MICE)
+            fprintf(stderr, ", flows: %llu started, %llu done, %llu skipped",
+                    (unsigned long long)st.flows_started, (unsigned long long)st.flows_done,
+                    (unsigned long long)st.flows_skipped);
+        if (st.send_err)
+            fprintf(stderr, ", %llu send stalls", (unsigned long long)st.send_err);
+        fprintf(stderr, "\n");
+        if (st.log)
+            fprintf(st.log, "# total_bytes=%llu secs=%.3f mbps=%.3f\n",
+                    (unsigned long long)st.tot_bytes, secs,
+                    secs > 0 ? st.tot_bytes * 8 / secs / 1e6 : 0.0);
+    }
+    if (st.log)
+        fclose(st.log);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* sink: UDP + TCP 같은 포트 */
+
+struct xt_flow_rx {
+    uint32_t flow;
+    uint64_t max_seq, pkts, bytes;
+};
+
+static int run_sink(int port, const char *log_path, uint64_t log_ns)
+{
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(port) };
+    static unsigned char bufs[XT_MAX_BATCH][XT_MAX_PKT + 1];
+    static unsigned char tcpbuf[65536];
+    struct iovec iov[XT_MAX_BATCH];
+    struct mmsghdr msgs[XT_MAX_BATCH];
+    struct xt_flow_rx flows[XT_MAX_FLOWS];
+    struct pollfd pfd[2 + XT_MAX_MICE];
+    int conns[XT_MAX_MICE], nconns = 0, nflows = 0;
+    int ufd, lfd, one = 1, buf = XT_SOCK_BUF, i;
+    uint64_t start = now_ns(), next_log = start + log_ns;
+    uint64_t iv_udp = 0, iv_tcp = 0;
+    FILE *log = NULL;
+
+    ufd = socket(AF_INET, SOCK_DGRAM, 0);
+    lfd = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    setsockopt(ufd, SOL_SOCKET, SO_RCVBUF, &buf, sizeof(buf));
+    if (bind(ufd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+        bind(lfd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(lfd, 128) < 0) {
+        perror("xtraffic: bind");
+        return 1;
+    }
+    if (log_path) {
+        log = fopen(log_path, "w");
+        if (!log) {
+            perror(log_path);
+            return 1;
+        }
+        fprintf(log, "t_ms,udp_bytes,tcp_bytes\n");
+    }
+
+    for (i = 0; i < XT_MAX_BATCH; i++) {
+        iov[i].iov_base = bufs[i];
+        iov[i].iov_len = sizeof(bufs[i]);
+    }
+    printf("xtraffic: sink on port %d\n", port);
+    fflush(stdout);
+
+    while (!stop_flag) {
+        uint64_t now = now_ns();
+        int n;
+
+        pfd[0].fd = ufd;
+        pfd[0].events = POLLIN;
+        pfd[1].fd = lfd;
+        pfd[1].events = POLLIN;
+        for (i = 0; i < nconns; i++) {
+            pfd[2 + i].fd = conns[i];
+            pfd[2 + i].events = POLLIN;
+        }
+        n = poll(pfd, 2 + nconns, next_log > now ? (int)((next_log - now) / 1000000ULL) + 1 : 0);
+
+        if (n > 0 && pfd[0].revents & POLLIN) {
+            int got;
+
+            for (i = 0; i < XT_MAX_BATCH; i++) {
+                memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+                msgs[i].msg_hdr.msg_iov = &iov[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+            }
+            got = recvmmsg(ufd, msgs, XT_MAX_BATCH, MSG_DONTWAIT, NULL);
+            for (i = 0; i < got; i++) {
+                struct xt_hdr *h = (struct xt_hdr *)bufs[i];
+                uint32_t flow;
+                uint64_t seq;
+                int k;
+
+                if (msgs[i].msg_len < sizeof(*h) || ntohl(h->magic) != XT_MAGIC)
+                    continue;
+                flow = ntohl(h->flow);
+                seq = be64toh(h->seq);
+                iv_udp += msgs[i].msg_len;
+                for (k = 0; k < nflows && flows[k].flow != flow; k++)
+                    ;
+                if (k == nflows) {
+                    if (nflows == XT_MAX_FLOWS)
+                        continue;
+                    memset(&flows[k], 0, sizeof(flows[k]));
+                    flows[k].flow = flow;
+                    nflows++;
+                }
+                flows[k].pkts++;
+                flows[k].bytes += msgs[i].msg_len;
+                if (seq > flows[k].max_seq)
+                    flows[k].max_seq = seq;
+            }
+        }
+        if (n > 0 && pfd[1].revents & POLLIN) {
+            int c = accept(lfd, NULL, NULL);
+
+            if (c >= 0 && nconns < XT_MAX_MICE)
+                conns[nconns++] = c;
+            else if (c >= 0)
+                close(c);
+        }
+        for (i = nconns - 1; n > 0 && i >= 0; i--) {
+            ssize_t r;
+
+            if (!pfd[2 + i].revents)
+                continue;
+            r = recv(conns[i], tcpbuf, sizeof(tcpbuf), MSG_DONTWAIT);
+            if (r > 0) {
+                iv_tcp += r;
+            } else if (r == 0 || errno != EAGAIN) {
+                /* 송신측 SHUT_WR → 닫아서 FCT 끝을 알림 */
+                close(conns[i]);
+                conns[i] = conns[--nconns];
+            }
+        }
+
+        now = now_ns();
+        if (now >= next_log) {
+            if (log) {
+                fprintf(log, "%llu,%llu,%llu\n",
+                        (unsigned long long)((now - start) / 1000000ULL),
+                        (unsigned long long)iv_udp, (unsigned long long)iv_tcp);
+                fflush(log);
+            }
+            iv_udp = iv_tcp = 0;
+            next_log += log_ns;
+        }
+    }
+
+    for (i = 0; i < nflows; i++) {
+        uint64_t expected = flows[i].max_seq + 1;
+
+        fprintf(stderr, "xtraffic sink: flow %u: %llu pkts, %llu bytes, loss %.2f%%\n",
+                flows[i].flow, (unsigned long long)flows[i].pkts,
+                (unsigned long long)flows[i].bytes,
+                expected > flows[i].pkts ?
+                    100.0 * (expected - flows[i].pkts) / expected : 0.0);
+    }
+    if (log)
+        fclose(log);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: xtraffic sink <port> [-l log] [-L log_ms]\n"
+            "       xtraffic cbr <host> <port> -r mbps [-s size] [-b batch]\n"
+            "       xtraffic onoff <host> <port> -r peak_mbps [-o on_ms] [-f off_ms] [-a alpha]\n"
+            "       xtraffic mice <host> <port> [-A arrivals/s] [-z mean_bytes] [-a alpha] [-m max]\n"
+            "       common: [-t sec] [-S seed] [-i flow_id] [-l log] [-L log_ms]\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    struct xt_opts o = {
+        .size = 1200, .seconds = 10, .batch = 16, .on_ms = 500, .off_ms = 500,
+        .alpha = 1.5, .arrivals = 20, .mean_bytes = 50000, .max_active = 256,
+        .seed = 1, .log_ns = 100000000ULL,
+    };
+    int i, first;
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    if (argc < 3)
+        usage();
+
+    if (!strcmp(argv[1], "sink")) {
+        o.mode = M_SINK;
+        first = 3;
+    } else {
+        if (argc < 4)
+            usage();
+        if (!strcmp(argv[1], "cbr"))
+            o.mode = M_CBR;
+        else if (!strcmp(argv[1], "onoff"))
+            o.mode = M_ONOFF;
+        else if (!strcmp(argv[1], "mice"))
+            o.mode = M_MICE;
+        else
+            usage();
+        o.host = argv[2];
+        first = 4;
+    }
+    o.port = atoi(argv[first - 1]);
+    o.flow = (uint32_t)getpid();
+
+    for (i = first; i < argc; i++) {
+        if (i + 1 >= argc)
+            usage();
+        if (!strcmp(argv[i], "-r"))
+            o.rate_mbps = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-s"))
+            o.size = (uint32_t)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-t"))
+            o.seconds = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-b"))
+            o.batch = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-o"))
+            o.on_ms = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-f"))
+            o.off_ms = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-a"))
+            o.alpha = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-A"))
+            o.arrivals = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-z"))
+            o.mean_bytes = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-m"))
+            o.max_active = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-S"))
+            o.seed = strtoull(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-i"))
+            o.flow = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-l"))
+            o.log = argv[++i];
+        else if (!strcmp(argv[i], "-L"))
+            o.log_ns = (uint64_t)(atof(argv[++i]) * 1e6);
+        else
+            usage();
+    }
+
+    if (o.log_ns == 0)
+        usage();
+    if (o.mode == M_SINK)
+        return run_sink(o.port, o.log, o.log_ns);
+
+    if ((o.mode != M_MICE && o.rate_mbps <= 0) ||
+        o.size < sizeof(struct xt_hdr) || o.size > XT_MAX_PKT ||
+        o.batch < 1 || o.batch > XT_MAX_BATCH || o.alpha <= 1.0 ||
+        o.arrivals <= 0 || o.max_active < 1 || o.max_active > XT_MAX_MICE)
+        usage();
+    return run_send(&o);
+}